@@ -0,0 +1,52 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    ArduinoX86Core example: server-side memory emulation with HashBackend.
+
+    Demonstrates the sparse hash-table memory backend from the shared core
+    library inside a plain Arduino IDE sketch — the building block that lets
+    a sketch-based server answer bus cycles from local emulated memory
+    instead of round-tripping every transfer to the host.
+*/
+
+#include <bus_emulator/HashBackend.h>
+#include <InstructionQueue.h>
+
+// 64K-entry table covers a full megabyte of sparse 16-bit words.
+HashBackend memory(65536);
+InstructionQueue queue(4, BusWidth::Eight);
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  // Unwritten addresses outside the strategy window read deterministic
+  // pseudo-random defaults; inside it, the selected fill pattern.
+  memory.set_strategy(IBusBackend::DefaultStrategy::Zero, 0x0000, 0xFFFF);
+
+  // Load a tiny program: NOP, NOP, JMP $-2.
+  const uint8_t program[] = { 0x90, 0x90, 0xEB, 0xFC };
+  memory.set_memory(0x100, program, sizeof(program));
+
+  // Serve "bus cycles" from emulated memory and feed the prefetch queue,
+  // as the full server does during automatic execution.
+  for (uint32_t addr = 0x100; addr < 0x104; addr++) {
+    uint8_t byte = memory.read_u8(addr);
+    queue.push(byte, QueueDataType::Program, ActiveBusWidth::EightLow);
+    Serial.print("Fetched ");
+    Serial.print(byte, HEX);
+    Serial.print(" from ");
+    Serial.println(addr, HEX);
+  }
+
+  uint8_t byte;
+  QueueDataType d_type;
+  while (queue.pop(&byte, &d_type)) {
+    Serial.print("Queue pop: ");
+    Serial.println(byte, HEX);
+  }
+}
+
+void loop() {}
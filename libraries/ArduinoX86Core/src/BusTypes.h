@@ -23,7 +23,13 @@
 
 #pragma once
 
+// Arduino-free when compiled for the native test env (env:native).
+#if defined(ARDUINO)
 #include <Arduino.h>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
 
 /// @brief Type of bus operation. This is used to for logging bus operations.
 enum class BusOperationType: uint8_t {
@@ -86,7 +92,7 @@ enum BusStatus {
 };
 
 // Bus transfer cycles. Tw is wait state, inserted if READY is not asserted during T3.
-enum TCycle { 
+enum TCycle {
   TI = 0,
   T1 = 1,
   T2 = 2,
@@ -95,6 +101,34 @@ enum TCycle {
   TW = 5,
 };
 
+// Next T-cycle transition tables, indexed by [current_cycle][condition].
+// The condition bit is shield-specific: (current_status != PASV) in T1 and
+// transfer-done in the data T-states; rows that don't consult it carry the
+// same entry in both columns. The per-clock advance in getNextCycle is a
+// single indexed load, with the condition (and its pin reads) computed only
+// for the rows that use it.
+//
+// 808x-family bus: T1-T4, with wait states inserted between T3 and T4.
+constexpr TCycle TCYCLE_NEXT_808X[6][2] = {
+  /* TI */ {TI, TI},
+  /* T1 */ {T1, T2}, // condition: status != PASV
+  /* T2 */ {T3, T3},
+  /* T3 */ {TW, T4}, // condition: transfer done
+  /* T4 */ {T1, T1},
+  /* TW */ {TW, T4}, // condition: transfer done
+};
+
+// 286/386 pipelined bus: Ts (T1) / Tc (T2), parking in TI when passive or in
+// an unhandled state.
+constexpr TCycle TCYCLE_NEXT_286[6][2] = {
+  /* TI */ {TI, TI},
+  /* T1 */ {TI, T2}, // condition: status != PASV
+  /* T2 */ {TW, TI}, // condition: transfer done
+  /* T3 */ {TI, TI},
+  /* T4 */ {TI, TI},
+  /* TW */ {TI, TI},
+};
+
 /// @brief Structure representing a call stack frame.
 struct CallStackFrame {
   uint16_t flags; // Flags register
@@ -0,0 +1,47 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Definitions for the library's shared state, so every consumer (PlatformIO
+// firmware, standalone sketches, the native test env) links them from one
+// place.
+
+#include <cstdint>
+
+#include <TraceSeq.h>
+#include <TraceFormat.h>
+#include <MemTelemetry.h>
+
+namespace ArduinoX86 {
+  // Shared trace sequence; see TraceSeq.h.
+  uint32_t TraceSeq = 0;
+
+  // CPU type stamped into bulk dump headers; see TraceFormat.h.
+  uint8_t TraceCpuType = 0;
+
+  // Backing-buffer allocation counters; see MemTelemetry.h.
+  namespace MemTelemetry {
+    uint32_t BufBytesInUse = 0;
+    uint32_t BufBytesPeak = 0;
+    uint32_t BufAllocFails = 0;
+  }
+}
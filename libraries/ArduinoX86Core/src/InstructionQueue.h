@@ -23,7 +23,13 @@
 
 #pragma once
 
+// Arduino-free when compiled for the native test env (env:native).
+#if defined(ARDUINO)
 #include <Arduino.h>
+#else
+#include <stdio.h>
+#include <stddef.h>
+#endif
 #include <BusTypes.h>
 
 enum class QueueDataType : uint8_t {
@@ -31,26 +37,54 @@ enum class QueueDataType : uint8_t {
   ProgramEnd = 1,
 };
 
+// Maximum physical queue capacity. A power of two so ring indices wrap with a
+// single AND against QUEUE_IDX_MASK instead of the integer division a runtime
+// `% size_` costs on every push and pop — the queue is touched on every cycle
+// with queue status activity. 16 bytes covers the largest prefetch queue we
+// model (the 386's); smaller CPUs simply use a lower logical capacity.
+constexpr size_t QUEUE_CAPACITY = 16;
+constexpr size_t QUEUE_IDX_MASK = QUEUE_CAPACITY - 1;
+
 class InstructionQueue {
 
   private:
-    size_t size_ = 6; // Capacity of the queue
+    size_t size_ = 6; // Logical capacity of the queue (per CPU type)
     size_t len_ = 0; // Number of items in the queue
     size_t back_ = 0; // Index of the back of the queue
     size_t front_ = 0; // Index of the front of the queue
     BusWidth fetch_width_ = BusWidth::Eight; // Data bus width
 
-    uint8_t queue_[6] = {0};
-    QueueDataType types_[6] = {QueueDataType::Program}; // Types of data in the queue
+    uint8_t queue_[QUEUE_CAPACITY] = {0};
+    // One tag bit per slot (QueueDataType has two values), packed so a push
+    // updates a word beside the byte instead of a parallel tag array.
+    uint16_t types_ = 0;
 
   void init_queue() {
     len_ = 0;
     back_ = 0;
     front_ = 0;
+    types_ = 0;
+  }
+
+  inline void set_type(size_t idx, QueueDataType d_type) {
+    if (d_type == QueueDataType::Program) {
+      types_ &= ~(uint16_t)(1u << idx);
+    }
+    else {
+      types_ |= (uint16_t)(1u << idx);
+    }
+  }
+
+  inline QueueDataType get_type(size_t idx) {
+    return (types_ & (1u << idx)) ? QueueDataType::ProgramEnd : QueueDataType::Program;
   }
+
   public:
     InstructionQueue(size_t queue_size = 4, BusWidth bus_width = BusWidth::Eight) : size_(queue_size), fetch_width_(bus_width) {
-      init_queue();  // Changed from init() to init_queue()
+      if (size_ > QUEUE_CAPACITY) {
+        size_ = QUEUE_CAPACITY;
+      }
+      init_queue();
     }
 
     /// @brief  Return the number of bytes in the queue.
@@ -72,8 +106,8 @@ class InstructionQueue {
         // 8-bit low byte fetch (8088/V20)
         if(have_room(width)) {
           queue_[front_] = (uint8_t)data;
-          types_[front_] = d_type;
-          front_ = (front_ + 1) % size_;
+          set_type(front_, d_type);
+          front_ = (front_ + 1) & QUEUE_IDX_MASK;
           len_++;
         }
       }
@@ -81,8 +115,8 @@ class InstructionQueue {
         // 8-bit high byte fetch (8086/V30 odd address)
         if(have_room(width)) {
           queue_[front_] = (uint8_t)(data >> 8);
-          types_[front_] = d_type;
-          front_ = (front_ + 1) % size_;
+          set_type(front_, d_type);
+          front_ = (front_ + 1) & QUEUE_IDX_MASK;
           len_++;
         }
       }
@@ -90,11 +124,11 @@ class InstructionQueue {
         // 16-bit fetch
         if(have_room(width)) {
           queue_[front_] = (uint8_t)data;
-          types_[front_] = d_type;
-          front_ = (front_ + 1) % size_;
+          set_type(front_, d_type);
+          front_ = (front_ + 1) & QUEUE_IDX_MASK;
           queue_[front_] = (uint8_t)(data >> 8);
-          types_[front_] = d_type;
-          front_ = (front_ + 1) % size_;
+          set_type(front_, d_type);
+          front_ = (front_ + 1) & QUEUE_IDX_MASK;
           len_ += 2;
         }
       }
@@ -107,8 +141,8 @@ class InstructionQueue {
   bool pop(uint8_t *byte, QueueDataType *d_type) {
     if(len_ > 0) {
       *byte = queue_[back_];
-      *d_type = types_[back_];
-      back_ = (back_ + 1) % size_;
+      *d_type = get_type(back_);
+      back_ = (back_ + 1) & QUEUE_IDX_MASK;
       len_--;
       return true;
     }
@@ -128,13 +162,13 @@ class InstructionQueue {
   /// @brief Flush the queue, returning the number of bytes flushed.
   size_t flush() {
     size_t bytes_flushed = len_;
-    init_queue();  // Changed from init() to init_queue()
+    init_queue();
     return bytes_flushed;
   }
 
   uint8_t read_byte(size_t idx) {
     if(idx < len_) {
-      return queue_[(back_ + idx) % size_];
+      return queue_[(back_ + idx) & QUEUE_IDX_MASK];
     }
     else {
       return 0;
@@ -142,13 +176,13 @@ class InstructionQueue {
   }
 
   const char *to_string() {
-    constexpr size_t buf_len = (6 * 2) + 1;
+    constexpr size_t buf_len = (QUEUE_CAPACITY * 2) + 1;
     static char buf[buf_len];
     char *buf_p = buf;
     *buf_p = 0;
     uint8_t byte;
     for(uint8_t i = 0; i < len_; i++ ) {
-      byte = queue_[(back_ + i) % size_];
+      byte = queue_[(back_ + i) & QUEUE_IDX_MASK];
       snprintf(buf_p, buf_len - (i * 2), "%02X", byte);
       buf_p += 2;
     }  
@@ -0,0 +1,60 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Cheap allocation telemetry for the large backing buffers (hash table
+// pools, SDRAM memory images, snapshot shadows). The counters are
+// maintained by the owners that already know the allocation sizes
+// (StaticHashTable, SdramBackend), so the bus hot paths are untouched;
+// cmd_server_status() exports them in one packed block so farm rigs can
+// spot creeping exhaustion and schedule preventive resets instead of
+// losing batches to mysterious failures. On the Giga these buffers live
+// in SDRAM; elsewhere they come from the regular heap.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace ArduinoX86 {
+namespace MemTelemetry {
+
+  extern uint32_t BufBytesInUse;  // Backing buffer bytes currently allocated
+  extern uint32_t BufBytesPeak;   // High-water mark of BufBytesInUse
+  extern uint32_t BufAllocFails;  // Backing buffer allocations that returned null
+
+  inline void note_alloc(uint32_t bytes) {
+    BufBytesInUse += bytes;
+    if (BufBytesInUse > BufBytesPeak) {
+      BufBytesPeak = BufBytesInUse;
+    }
+  }
+
+  inline void note_free(uint32_t bytes) {
+    BufBytesInUse = (bytes <= BufBytesInUse) ? (BufBytesInUse - bytes) : 0;
+  }
+
+  inline void note_fail() {
+    BufAllocFails++;
+  }
+
+}
+}
@@ -0,0 +1,366 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+#include <MemTelemetry.h>
+
+#ifdef ARDUINO_GIGA
+  #include <SDRAM.h>
+  #include <SdramInit.h>
+  #define HT_ALLOC(sz) (ensure_sdram(), SDRAM.malloc(sz))
+  #define HT_FREE(ptr) SDRAM.free(ptr)
+#else
+  #include <cstdlib>
+  #define HT_ALLOC(sz) malloc(sz)
+  #define HT_FREE(ptr) free(ptr)
+#endif
+
+template<typename Key = uint32_t>
+struct DefaultHash {
+  size_t operator()(Key key, uint8_t shift) const {
+    return (static_cast<uint32_t>(key) * 2654435769u) >> shift;
+  }
+};
+
+// Open-addressing hash table with robin-hood probing. Probe distances are
+// kept in a separate byte array so a probe chain walks densely-packed
+// metadata (one cache line covers 32 slots) and only touches the entry pool
+// on a metadata hit. Robin-hood insertion keeps probe chains short and lets
+// lookups terminate as soon as the stored distance drops below the probe
+// distance, so misses don't scan to the next empty slot at high load.
+// When the load factor crosses GROW_LOAD_PERCENT the table migrates itself
+// to a double-size pool (up to MAX_GROW_CAPACITY), so long randomized runs
+// don't fall off the full-table cliff; if the larger pool can't be allocated
+// the table simply keeps filling toward the probe bound as before.
+template<typename Key = uint32_t, typename Value = uint16_t, typename HashFn = DefaultHash<Key>>
+class StaticHashTable {
+public:
+  struct Entry {
+    Key key;
+    Value value;
+  };
+
+  explicit StaticHashTable(size_t capacity)
+      : capacity_(capacity), count_(0)
+  {
+    if ((capacity_ & (capacity_ - 1)) != 0) {
+      assert(!"Hash table capacity must be a power of two");
+      entry_pool_ = nullptr;
+      meta_ = nullptr;
+      return;
+    }
+
+    shift_ = 32 - __builtin_ctz(capacity_);
+    entry_pool_ = static_cast<Entry *>(HT_ALLOC(sizeof(Entry) * capacity_));
+    meta_ = static_cast<uint8_t *>(HT_ALLOC(capacity_));
+    if (entry_pool_ && meta_) {
+      memset(meta_, 0, capacity_);
+      ArduinoX86::MemTelemetry::note_alloc(pool_bytes());
+    }
+    else {
+      ArduinoX86::MemTelemetry::note_fail();
+    }
+  }
+
+  ~StaticHashTable() {
+    if (entry_pool_ && meta_) {
+      ArduinoX86::MemTelemetry::note_free(pool_bytes());
+    }
+    if (entry_pool_) {
+      HT_FREE(entry_pool_);
+    }
+    if (meta_) {
+      HT_FREE(meta_);
+    }
+    if (shadow_pool_ && shadow_meta_) {
+      ArduinoX86::MemTelemetry::note_free(pool_bytes());
+    }
+    if (shadow_pool_) {
+      HT_FREE(shadow_pool_);
+    }
+    if (shadow_meta_) {
+      HT_FREE(shadow_meta_);
+    }
+  }
+
+  // Copy the entry pool and metadata into shadow buffers, allocated on first
+  // use. Returns false if the shadow allocation fails; the table itself is
+  // unaffected.
+  bool snapshot() {
+    if (!entry_pool_ || !meta_) return false;
+    bool shadow_was_allocated = shadow_pool_ && shadow_meta_;
+    if (!shadow_pool_) {
+      shadow_pool_ = static_cast<Entry *>(HT_ALLOC(sizeof(Entry) * capacity_));
+    }
+    if (!shadow_meta_) {
+      shadow_meta_ = static_cast<uint8_t *>(HT_ALLOC(capacity_));
+    }
+    if (!shadow_pool_ || !shadow_meta_) {
+      ArduinoX86::MemTelemetry::note_fail();
+      return false;
+    }
+    if (!shadow_was_allocated) {
+      ArduinoX86::MemTelemetry::note_alloc(pool_bytes());
+    }
+    memcpy(shadow_pool_, entry_pool_, sizeof(Entry) * capacity_);
+    memcpy(shadow_meta_, meta_, capacity_);
+    shadow_count_ = count_;
+    shadow_max_probe_ = max_probe_;
+    have_shadow_ = true;
+    return true;
+  }
+
+  // Roll the table back to the last snapshot. Returns false if no snapshot
+  // has been taken.
+  bool restore() {
+    if (!have_shadow_ || !entry_pool_ || !meta_) return false;
+    memcpy(entry_pool_, shadow_pool_, sizeof(Entry) * capacity_);
+    memcpy(meta_, shadow_meta_, capacity_);
+    count_ = shadow_count_;
+    max_probe_ = shadow_max_probe_;
+    return true;
+  }
+
+  bool has_snapshot() const { return have_shadow_; }
+
+  bool insert(Key key, Value value) {
+    if (!entry_pool_ || !meta_) return false;
+
+    // Migrate to a double-size table before the load factor reaches the
+    // cliff where probe chains degenerate. A failed grow (no headroom) is
+    // not an error; the table keeps absorbing inserts up to the probe bound.
+    if ((count_ + 1) * 100 > capacity_ * GROW_LOAD_PERCENT) {
+      try_grow();
+    }
+
+    if (!insert_no_grow(key, value)) {
+      // Probe bound exceeded; the table is pathologically full. Migration is
+      // the last resort before the write is dropped.
+      if (!try_grow() || !insert_no_grow(key, value)) {
+        ++failed_inserts_;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Grow ahead of a known bulk insert so the additional entries land without
+  // mid-stream migrations. Best effort: returns false if the headroom could
+  // not be fully provisioned, but inserts may still succeed via the normal
+  // grow-on-demand path.
+  bool reserve(size_t additional) {
+    if (!entry_pool_ || !meta_) return false;
+    while ((count_ + additional) * 100 > capacity_ * GROW_LOAD_PERCENT) {
+      if (!try_grow()) return false;
+    }
+    return true;
+  }
+
+  bool insert_no_grow(Key key, Value value) {
+    if (!entry_pool_ || !meta_) return false;
+
+    size_t index = hasher_(key, shift_);
+    Key cur_key = key;
+    Value cur_value = value;
+    uint8_t cur_dist = 1; // Distance from home slot, plus one. 0 marks empty.
+
+    for (size_t i = 0; i < capacity_; ++i) {
+      uint8_t slot_dist = meta_[index];
+      if (slot_dist == 0) {
+        // Empty slot; claim it.
+        entry_pool_[index].key = cur_key;
+        entry_pool_[index].value = cur_value;
+        meta_[index] = cur_dist;
+        if (cur_dist > max_probe_) max_probe_ = cur_dist;
+        ++count_;
+        return true;
+      }
+      if (slot_dist == cur_dist && entry_pool_[index].key == cur_key) {
+        // Existing key; update in place.
+        entry_pool_[index].value = cur_value;
+        return true;
+      }
+      if (slot_dist < cur_dist) {
+        // Robin-hood: the resident entry is closer to home than we are.
+        // Displace it and carry it forward.
+        Entry tmp = entry_pool_[index];
+        entry_pool_[index].key = cur_key;
+        entry_pool_[index].value = cur_value;
+        meta_[index] = cur_dist;
+        if (cur_dist > max_probe_) max_probe_ = cur_dist;
+        cur_key = tmp.key;
+        cur_value = tmp.value;
+        cur_dist = slot_dist;
+      }
+      if (cur_dist == MAX_PROBE_DIST) {
+        // Probe bound exceeded; table is pathologically full.
+        return false;
+      }
+      ++cur_dist;
+      index = (index + 1) & (capacity_ - 1);
+    }
+    return false;
+  }
+
+  bool find(Key key, Value &value_out) const {
+    if (!entry_pool_ || !meta_) return false;
+
+    size_t index = hasher_(key, shift_);
+    uint8_t dist = 1;
+    for (size_t i = 0; i < capacity_; ++i) {
+      uint8_t slot_dist = meta_[index];
+      if (slot_dist < dist) {
+        // Empty slot, or a resident closer to home than we would be: with
+        // robin-hood ordering our key cannot appear further on.
+        return false;
+      }
+      if (slot_dist == dist && entry_pool_[index].key == key) {
+        value_out = entry_pool_[index].value;
+        return true;
+      }
+      ++dist;
+      index = (index + 1) & (capacity_ - 1);
+    }
+    return false;
+  }
+
+  void clear() {
+    if (meta_) {
+      memset(meta_, 0, capacity_);
+      count_ = 0;
+      max_probe_ = 0;
+    }
+  }
+
+  size_t size() const { return count_; }
+  size_t capacity() const { return capacity_; }
+
+  /// @brief Visit every resident entry. The callback receives (key, value);
+  /// entries come out in slot order, not insertion order.
+  template <typename Visitor>
+  void for_each(Visitor&& visit) const {
+    if (!entry_pool_ || !meta_) return;
+    for (size_t i = 0; i < capacity_; i++) {
+      if (meta_[i] != 0) {
+        visit(entry_pool_[i].key, entry_pool_[i].value);
+      }
+    }
+  }
+
+  // Current load factor in percent.
+  uint8_t load_factor_percent() const {
+    return capacity_ ? (uint8_t)((count_ * 100) / capacity_) : 0;
+  }
+  // Longest probe chain produced by any insertion since the last clear().
+  uint8_t max_probe() const { return max_probe_; }
+  // Inserts dropped because the table was full and could not grow.
+  uint32_t failed_inserts() const { return failed_inserts_; }
+  // Successful migrations to a larger table since construction.
+  uint8_t grow_count() const { return grow_count_; }
+
+  // Probe-chain length for a present key (1 = home slot), or 0 if absent.
+  // Lets the native test env histogram probe distributions at varying load.
+  uint8_t probe_length(Key key) const {
+    if (!entry_pool_ || !meta_) return 0;
+    size_t index = hasher_(key, shift_);
+    uint8_t dist = 1;
+    for (size_t i = 0; i < capacity_; ++i) {
+      uint8_t slot_dist = meta_[index];
+      if (slot_dist < dist) return 0;
+      if (slot_dist == dist && entry_pool_[index].key == key) return dist;
+      ++dist;
+      index = (index + 1) & (capacity_ - 1);
+    }
+    return 0;
+  }
+
+private:
+  // Entries whose probe chain would exceed this distance are rejected.
+  static constexpr uint8_t MAX_PROBE_DIST = 255;
+  // Load factor (percent) at which insert() attempts a migration. Robin-hood
+  // probe chains are short up to here and degrade sharply past ~90%.
+  static constexpr size_t GROW_LOAD_PERCENT = 85;
+  // Growth ceiling: 1M entries keeps the pool under ~9 MB of SDRAM.
+  static constexpr size_t MAX_GROW_CAPACITY = 1u << 20;
+
+  // Migrate to a table of double the capacity, allocated before the old pool
+  // is released so a failed allocation leaves the table untouched. Any
+  // snapshot is discarded: the shadow buffers match the old geometry and a
+  // restore into the grown table would be meaningless.
+  bool try_grow() {
+    if (!entry_pool_ || !meta_) return false;
+    if (capacity_ >= MAX_GROW_CAPACITY) return false;
+
+    size_t new_capacity = capacity_ * 2;
+    Entry *new_pool = static_cast<Entry *>(HT_ALLOC(sizeof(Entry) * new_capacity));
+    uint8_t *new_meta = static_cast<uint8_t *>(HT_ALLOC(new_capacity));
+    if (!new_pool || !new_meta) {
+      if (new_pool) HT_FREE(new_pool);
+      if (new_meta) HT_FREE(new_meta);
+      ArduinoX86::MemTelemetry::note_fail();
+      return false;
+    }
+    memset(new_meta, 0, new_capacity);
+    ArduinoX86::MemTelemetry::note_alloc(
+        static_cast<uint32_t>(sizeof(Entry) * new_capacity + new_capacity));
+
+    Entry *old_pool = entry_pool_;
+    uint8_t *old_meta = meta_;
+    size_t old_capacity = capacity_;
+    uint32_t old_bytes = pool_bytes();
+
+    entry_pool_ = new_pool;
+    meta_ = new_meta;
+    capacity_ = new_capacity;
+    shift_ = 32 - __builtin_ctz(capacity_);
+    count_ = 0;
+    max_probe_ = 0;
+
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (old_meta[i] != 0) {
+        insert_no_grow(old_pool[i].key, old_pool[i].value);
+      }
+    }
+
+    HT_FREE(old_pool);
+    HT_FREE(old_meta);
+    ArduinoX86::MemTelemetry::note_free(old_bytes);
+
+    if (shadow_pool_ || shadow_meta_) {
+      if (shadow_pool_ && shadow_meta_) {
+        ArduinoX86::MemTelemetry::note_free(
+            static_cast<uint32_t>(sizeof(Entry) * old_capacity + old_capacity));
+      }
+      if (shadow_pool_) HT_FREE(shadow_pool_);
+      if (shadow_meta_) HT_FREE(shadow_meta_);
+      shadow_pool_ = nullptr;
+      shadow_meta_ = nullptr;
+      have_shadow_ = false;
+    }
+
+    ++grow_count_;
+    return true;
+  }
+
+  // Bytes one entry pool plus its metadata array occupy, for the
+  // allocation telemetry counters.
+  uint32_t pool_bytes() const {
+    return static_cast<uint32_t>(sizeof(Entry) * capacity_ + capacity_);
+  }
+
+  Entry *entry_pool_ = nullptr;
+  uint8_t *meta_ = nullptr; // Probe distance + 1 per slot; 0 marks empty.
+  Entry *shadow_pool_ = nullptr;  // Snapshot of the entry pool.
+  uint8_t *shadow_meta_ = nullptr;
+  size_t capacity_;
+  size_t count_;
+  size_t shadow_count_ = 0;
+  uint32_t failed_inserts_ = 0;
+  uint8_t shift_;
+  uint8_t max_probe_ = 0;
+  uint8_t shadow_max_probe_ = 0;
+  uint8_t grow_count_ = 0;
+  bool have_shadow_ = false;
+  HashFn hasher_;
+};
@@ -0,0 +1,90 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Self-describing header for bulk binary dumps (cycle states, bus operations,
+// batch results). The record structs these dumps splat are packed firmware
+// structs whose layout has changed across revisions, silently breaking
+// archived traces and host tooling. Every bulk dump now leads with this
+// fixed-size header so an archive carries its own record geometry: host tools
+// check the magic and version, size their reads from record_size, and gate
+// optional fields on the bitmap — and traces from mixed-firmware farms can be
+// pooled into one pipeline without out-of-band knowledge.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace ArduinoX86 {
+  /// @brief Detected CPU type of the socketed processor (CpuType cast to a
+  /// byte; 0 until detection completes), stamped into every TraceHeader so an
+  /// archived trace records which CPU produced it. Set once at CPU detection.
+  extern uint8_t TraceCpuType;
+}
+
+/// @brief What a bulk dump contains; stamped into TraceHeader::kind.
+enum class TraceKind : uint8_t {
+  Invalid               = 0x00,
+  CycleStates           = 0x01, // Raw CycleState records
+  CycleStatesCompressed = 0x02, // Delta/run-length tokens (variable length)
+  CycleStatesFrom       = 0x03, // Raw CycleState records after a read cursor
+  CycleTraceMeta        = 0x04, // Raw CycleTraceMeta records
+  BusOps                = 0x05, // Raw BusOperation records
+  BatchResults          = 0x06, // Per-test result records (variable length)
+};
+
+// "AXTR" little-endian.
+constexpr uint32_t TRACE_HEADER_MAGIC = 0x52545841ul;
+constexpr uint8_t TRACE_FORMAT_VERSION = 1;
+
+// TraceHeader::field_bitmap bits, marking optional per-record fields that are
+// present in this build.
+constexpr uint32_t TRACE_FIELD_TIMESTAMP = 0x01; // CycleState trailing DWT timestamp
+constexpr uint32_t TRACE_FIELD_SEQ       = 0x02; // BusOperation trace sequence number
+constexpr uint32_t TRACE_FIELD_REPEAT    = 0x04; // CycleState capture-time repeat counter
+
+/// @brief Fixed 12-byte header leading every bulk dump, ahead of the dump's
+/// existing count/size framing. record_size is sizeof the repeated record, or
+/// 0 for variable-length payloads (compressed tokens, batch result records).
+struct __attribute__((packed)) TraceHeader {
+  uint32_t magic;        // TRACE_HEADER_MAGIC
+  uint8_t  version;      // TRACE_FORMAT_VERSION
+  uint8_t  kind;         // TraceKind
+  uint8_t  cpu_type;     // ArduinoX86::TraceCpuType at dump time
+  uint8_t  record_size;  // Bytes per record, or 0 if variable
+  uint32_t field_bitmap; // TRACE_FIELD_* bits present in this build
+};
+static_assert(sizeof(TraceHeader) == 12, "TraceHeader must be 12 bytes");
+
+/// @brief Build a header for a bulk dump, stamping the magic, format version
+/// and detected CPU type.
+inline TraceHeader make_trace_header(TraceKind kind, uint8_t record_size, uint32_t field_bitmap) {
+  TraceHeader header;
+  header.magic = TRACE_HEADER_MAGIC;
+  header.version = TRACE_FORMAT_VERSION;
+  header.kind = static_cast<uint8_t>(kind);
+  header.cpu_type = ArduinoX86::TraceCpuType;
+  header.record_size = record_size;
+  header.field_bitmap = field_bitmap;
+  return header;
+}
@@ -0,0 +1,386 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER   
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <limits>
+
+#include <bus_emulator/IBusBackend.h>
+#include <StaticHashTable.h>
+
+// On target, DEBUG_SERIAL comes from the firmware's serial plumbing when
+// this library is built inside the PlatformIO project; standalone sketch
+// builds fall back to the default port, and the native test env substitutes
+// a stdout shim (see host/SerialShim.h).
+#if defined(ARDUINO)
+  #if __has_include(<serial_config.h>)
+    #include <serial_config.h>
+  #else
+    #ifndef DEBUG_SERIAL
+    #define DEBUG_SERIAL Serial
+    #endif
+  #endif
+#else
+#include <host/SerialShim.h>
+#endif
+
+class HashBackend : public IBusBackend {
+public:
+  explicit HashBackend(size_t mem_capacity = 65536)
+    : mem_table_(mem_capacity), base_seed_(0) {
+    // Historical default window: Random inside 0x1024-0xFFFFFF (and Random
+    // outside any region anyway), so fresh backends behave as before.
+    regions_[0] = { 0x1024, 0xFFFFFF, DefaultStrategy::Random };
+    region_count_ = 1;
+  }
+
+  ~HashBackend() {
+    DEBUG_SERIAL.println("## HASH_BACKEND: Memory freed");
+  }
+
+  IBusBackendType type() const override {
+    return IBusBackendType::HashTable;
+  }
+
+  size_t size() const override {
+    return 0;
+  }
+
+  // ---------------- Memory Interface ----------------
+  uint8_t read_u8(uint32_t address) override {
+    return (address & 1) ? (lookup_word(address) >> 8) : (lookup_word(address) & 0xFF);
+  }
+
+  uint16_t read_u16(uint32_t address) override {
+    return lookup_word(address);
+  }
+
+  uint16_t read_bus(uint32_t address, bool bhe) override {
+    return lookup_word(address);
+  }
+
+  uint8_t *get_ptr(uint32_t addr) override { 
+    // Can't get a pointer with this backend.
+    return NULL; 
+  }
+
+  void write_u8(uint32_t address, uint8_t value) override {
+    const uint32_t addr16 = address >> 1;
+    uint16_t word = lookup_word(address);
+    if (address & 1) {
+      word = (word & 0x00FF) | (value << 8); // write high byte
+    } else {
+      word = (word & 0xFF00) | value;        // write low byte
+    }
+    table_write(addr16, word);
+  }
+
+  void write_u16(uint32_t address, uint16_t value) override {
+    const uint32_t addr16 = address >> 1;
+    table_write(addr16, value);
+  }
+
+  void write_bus(uint32_t address, uint16_t value, bool bhe) override {
+    const uint32_t addr16 = address >> 1;
+    const bool a0 = address & 1;
+    uint16_t word = lookup_word(address);
+
+    if (a0 && bhe) {
+      // Write high byte only
+      word = (word & 0x00FF) | ((value & 0x00FF) << 8);
+    } else if (!a0 && bhe) {
+      // Write full word
+      word = value;
+    } else if (!a0 && !bhe) {
+      // Write low byte only
+      word = (word & 0xFF00) | (value & 0x00FF);
+    } else {
+      // a0 == 1 && bhe == 0: refresh cycle
+      return;
+    }
+
+    table_write(addr16, word);
+  }
+
+  void set_memory(uint32_t address, const uint8_t* buffer, size_t length) override {
+    if (length == 0) return;
+
+    // Provision headroom for the whole upload up front so it doesn't trigger
+    // mid-stream table migrations.
+    mem_table_.reserve(length / 2 + 2);
+
+    size_t i = 0;
+    // Unaligned leading byte merges with the resident word via the byte path.
+    if (address & 1) {
+      write_u8(address, buffer[0]);
+      i = 1;
+    }
+    // Aligned interior: insert whole little-endian words directly, skipping
+    // the read-merge lookup write_u8 pays per byte.
+    for (; i + 1 < length; i += 2) {
+      const uint32_t addr16 = (address + i) >> 1;
+      const uint16_t word = (uint16_t)(buffer[i] | ((uint16_t)buffer[i + 1] << 8));
+      table_write(addr16, word);
+    }
+    // Unaligned trailing byte.
+    if (i < length) {
+      write_u8(address + i, buffer[i]);
+    }
+  }
+
+  // Commit a word to the hash table, which grows itself under load. A failed
+  // insert means the table could not grow (allocation failure or at the size
+  // ceiling); warn once instead of silently dropping the write, and don't
+  // cache a value the table doesn't hold.
+  void table_write(uint32_t addr16, uint16_t word) {
+    if (!mem_table_.insert(addr16, word)) {
+      if (mem_table_.failed_inserts() == 1) {
+        DEBUG_SERIAL.println("## HASH_BACKEND: Table full and cannot grow, dropping writes!");
+      }
+      return;
+    }
+    cache_fill(addr16, word);
+  }
+
+  void erase_memory() override {
+    char buf[96];
+    snprintf(buf, sizeof(buf), "## HASH_BACKEND: Memory erased (was %u%% load, max probe %u, grows %u, drops %lu)",
+      mem_table_.load_factor_percent(), mem_table_.max_probe(),
+      mem_table_.grow_count(), (unsigned long)mem_table_.failed_inserts());
+    mem_table_.clear();
+    cache_invalidate();
+    DEBUG_SERIAL.println(buf);
+  }
+
+  // Table health statistics, for spotting tests that degrade probe behavior.
+  uint8_t load_factor_percent() const { return mem_table_.load_factor_percent(); }
+  uint8_t max_probe() const { return mem_table_.max_probe(); }
+
+  size_t table_size() const override { return mem_table_.size(); }
+  size_t table_capacity() const override { return mem_table_.capacity(); }
+  uint8_t table_max_probe() const override { return mem_table_.max_probe(); }
+
+  /// @brief Visit every resident word as (byte address, word value). The
+  /// table holds exactly the words written since the last erase (including
+  /// bulk uploads), so this enumerates the dirtied memory without scanning
+  /// the address space. Words come out in slot order, not address order.
+  template <typename Visitor>
+  void for_each_word(Visitor&& visit) const {
+    mem_table_.for_each([&](uint32_t addr16, uint16_t value) {
+      visit(addr16 << 1, value);
+    });
+  }
+
+  bool snapshot_memory() override {
+    if (!mem_table_.snapshot()) {
+      DEBUG_SERIAL.println("## HASH_BACKEND: Snapshot failed (no shadow memory?)");
+      return false;
+    }
+    DEBUG_SERIAL.println("## HASH_BACKEND: Memory snapshot taken");
+    return true;
+  }
+
+  bool restore_memory() override {
+    if (!mem_table_.restore()) {
+      DEBUG_SERIAL.println("## HASH_BACKEND: Restore failed (no snapshot taken?)");
+      return false;
+    }
+    cache_invalidate();
+    return true;
+  }
+
+  void randomize_memory(uint32_t seed) override {
+    base_seed_ = seed;
+    mem_table_.clear();
+    cache_invalidate();
+  }
+
+  void debug_mem(uint32_t address, size_t length) override {
+    char buf[64];
+    
+    for (size_t i = 0; i < length; ++i) {
+      uint8_t value = read_u8(address + i);
+      snprintf(buf, 64, "0x%08lX: 0x%02X\n\r", address + i, value);
+      DEBUG_SERIAL.print(buf);
+    }
+  }
+
+  // ---------------- I/O Interface (Stubbed) ----------------
+  uint8_t io_read_u8(uint16_t) override { return 0xFF; }
+  uint16_t io_read_u16(uint16_t) override { return 0xFFFF; }
+  uint16_t io_read_bus(uint16_t, bool) override { return 0xFFFF; }
+  void io_write_u8(uint16_t, uint8_t) override {}
+  void io_write_u16(uint16_t, uint16_t) override {}
+  void io_write_bus(uint16_t, uint16_t, bool) override {}
+
+  void set_strategy(DefaultStrategy strategy, uint32_t start, uint32_t end) override {
+    // Replace the whole map with a single region, preserving the original
+    // one-window semantics for existing hosts.
+    regions_[0] = { start, end, strategy };
+    region_count_ = 1;
+    // Cached words may hold defaults generated under the old strategy.
+    cache_invalidate();
+  }
+
+  bool add_strategy(DefaultStrategy strategy, uint32_t start, uint32_t end) override {
+    if ((region_count_ >= MAX_STRATEGY_REGIONS) || (end < start)) {
+      return false;
+    }
+    // Keep the table sorted by start so gen_default_u16 can stop scanning
+    // at the first region past the address. On overlap, the earlier-starting
+    // (or earlier-added, for equal starts) region wins.
+    size_t at = region_count_;
+    while ((at > 0) && (regions_[at - 1].start > start)) {
+      regions_[at] = regions_[at - 1];
+      at--;
+    }
+    regions_[at] = { start, end, strategy };
+    region_count_++;
+    cache_invalidate();
+    return true;
+  }
+
+private:
+  // Direct-mapped hot-entry cache in front of the hash table. Instruction
+  // fetch hammers the same few word addresses (prefetch runs are sequential
+  // and the load/store programs loop over a tiny region), so most lookups
+  // collapse to a compare and a load here instead of a full hash+probe.
+  // Write-through on stores; invalidated whenever the table contents or the
+  // default-value strategy change underneath it.
+  static const size_t CACHE_ENTRIES = 64; // Must be a power of two
+  struct CacheEntry {
+    uint32_t addr16;
+    uint16_t word;
+    bool valid;
+  };
+  CacheEntry cache_[CACHE_ENTRIES] = {};
+
+  inline void cache_fill(uint32_t addr16, uint16_t word) {
+    CacheEntry &e = cache_[addr16 & (CACHE_ENTRIES - 1)];
+    e.addr16 = addr16;
+    e.word = word;
+    e.valid = true;
+  }
+
+  void cache_invalidate() {
+    for (size_t i = 0; i < CACHE_ENTRIES; i++) {
+      cache_[i].valid = false;
+    }
+  }
+
+  // Resolve the stored (or default-generated) word for an address, checking
+  // the hot-entry cache before the hash table. Defaults are deterministic
+  // per address, so caching them is safe.
+  inline uint16_t lookup_word(uint32_t address) {
+    const uint32_t addr16 = address >> 1;
+    const CacheEntry &e = cache_[addr16 & (CACHE_ENTRIES - 1)];
+    if (e.valid && (e.addr16 == addr16)) {
+      return e.word;
+    }
+    uint16_t word = 0;
+    if (!mem_table_.find(addr16, word)) {
+      // If the address is not found, generate a default value based on the strategy.
+      word = gen_default_u16(address);
+    }
+    cache_fill(addr16, word);
+    return word;
+  }
+
+  StaticHashTable<uint32_t, uint16_t> mem_table_;
+
+  uint32_t base_seed_;
+
+  // Sorted interval table of default-value strategies (see add_strategy).
+  // Small and scanned linearly; the hot-entry cache absorbs repeated lookups
+  // so the scan only runs when a default is first materialized.
+  static const size_t MAX_STRATEGY_REGIONS = 8;
+  struct StrategyRegion {
+    uint32_t start; // First address covered (inclusive)
+    uint32_t end;   // Last address covered (inclusive)
+    DefaultStrategy strategy;
+  };
+  StrategyRegion regions_[MAX_STRATEGY_REGIONS] = {};
+  size_t region_count_ = 0;
+
+  uint16_t gen_default_u16(uint32_t address) {
+    // Generate a default 16-bit value from the first region covering the
+    // address; addresses outside every region read random, as the old
+    // single-window code did.
+    for (size_t i = 0; i < region_count_; i++) {
+      const StrategyRegion &r = regions_[i];
+      if (r.start > address) {
+        break; // Sorted by start; no later region can cover this address.
+      }
+      if (address <= r.end) {
+        switch (r.strategy) {
+          case DefaultStrategy::Zero:
+            return 0x0000;
+          case DefaultStrategy::Ones:
+            return 0xFFFF;
+          case DefaultStrategy::Random: // FALLTHROUGH
+          default:
+            return gen_random_u16(address);
+        }
+      }
+    }
+    return gen_random_u16(address);
+  }
+
+  // uint16_t gen_random_u16(uint32_t address) {
+  //   // combine seed and input into one 64-bit word
+  //   uint64_t z = (uint64_t(base_seed_) << 32) | address;
+
+  //   // avalanche (SplitMix64)
+  //   z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  //   z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  //   z = z ^ (z >> 31);
+
+  //   // return    16 bits
+  //   return uint16_t(z & 0xFFFFU);
+  // }  
+
+
+  static inline uint32_t murmur3_fmix32(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+  }
+
+  /// 32→16-bit hash with seed
+  static inline uint16_t hash16_murmur3(uint32_t x, uint32_t seed) {
+      // combine seed and input
+      uint32_t h = x ^ seed;
+      // avalanche
+      h = murmur3_fmix32(h);
+      // take the upper 16 bits
+      return uint16_t(h >> 16);
+  }
+  
+  // Return a random 
+  inline uint16_t gen_random_u16(uint32_t address) {
+    return hash16_murmur3(address, base_seed_); // Example seed
+  }
+};
\ No newline at end of file
@@ -62,8 +62,28 @@ public:
   virtual void     set_memory(uint32_t address, const uint8_t* buffer, size_t length) = 0;
   virtual void     erase_memory() = 0;
   virtual void     set_strategy(DefaultStrategy strategy, uint32_t start, uint32_t end) = 0;
+
+  // Multi-region strategy map: append a region on top of the one installed
+  // by set_strategy(), so lazy defaults can model zeroed RAM, 0xFF ROM holes
+  // and random uninitialized regions at once. Backends without a region
+  // table inherit the refusal.
+  virtual bool     add_strategy(DefaultStrategy strategy, uint32_t start, uint32_t end) {
+    (void)strategy; (void)start; (void)end;
+    return false;
+  }
   virtual void     randomize_memory(uint32_t seed) = 0;
   virtual void     debug_mem(uint32_t address, size_t length) = 0;
 
+  // Snapshot/restore of the backing memory for fast per-test resets.
+  // Backends without snapshot support inherit these and return false.
+  virtual bool     snapshot_memory() { return false; }
+  virtual bool     restore_memory() { return false; }
+
+  // Hash-table occupancy telemetry for cmd_server_status(). Backends
+  // without a table inherit the zero defaults.
+  virtual size_t   table_size() const { return 0; }
+  virtual size_t   table_capacity() const { return 0; }
+  virtual uint8_t  table_max_probe() const { return 0; }
+
   virtual ~IBusBackend() {}
 };
\ No newline at end of file
@@ -26,8 +26,21 @@
 #include <limits>
 #include <SDRAM.h>
 
+#include <SdramInit.h>
+
 #include <bus_emulator/IBusBackend.h>
-#include <serial_config.h>
+#include <MemTelemetry.h>
+
+// DEBUG_SERIAL comes from the firmware's serial plumbing when this library
+// is built inside the PlatformIO project; standalone sketch builds fall back
+// to the default port.
+#if __has_include(<serial_config.h>)
+  #include <serial_config.h>
+#else
+  #ifndef DEBUG_SERIAL
+  #define DEBUG_SERIAL Serial
+  #endif
+#endif
 
 #define SMRAM_SIZE 512
 
@@ -36,25 +49,34 @@ public:
   SdramBackend(size_t size, size_t mask)
     : size_(size), mask_(mask) {
       
+      ensure_sdram();
       mem_ = (uint8_t*)SDRAM.malloc(size);
       if (!mem_) {
           DEBUG_SERIAL.println("## SDRAM: Failed to allocate memory!");
+          ArduinoX86::MemTelemetry::note_fail();
           size_ = 0;
       }
       else {
           memset(mem_, 0, size_); // Initialize memory to zero
+          ArduinoX86::MemTelemetry::note_alloc(size_);
           DEBUG_SERIAL.print("## SDRAM: Allocated ");
           DEBUG_SERIAL.print(size_);
           DEBUG_SERIAL.println(" bytes memory");
       }
-    }                       
+    }
 
   ~SdramBackend() {
     if (mem_) {
       SDRAM.free(mem_);
+      ArduinoX86::MemTelemetry::note_free(size_);
       mem_ = nullptr;
       DEBUG_SERIAL.println("## SDRAM: Memory freed");
     }
+    if (shadow_) {
+      SDRAM.free(shadow_);
+      ArduinoX86::MemTelemetry::note_free(size_);
+      shadow_ = nullptr;
+    }
   }
 
   IBusBackendType type() const override {
@@ -200,21 +222,56 @@ public:
     if (!mem_) {
       return;
     }
-    // Fill memory with random data, 32-bits at a time for speed.
+    // Fill memory with random data, 32 bits per store. An inline xorshift
+    // step replaces the Arduino random() call per word; randomizing the
+    // whole region is serialized with test execution, so this is directly
+    // farm throughput.
     uint32_t *fast_ptr = reinterpret_cast<uint32_t*>(mem_);
+    uint32_t state = seed ? seed : 0xA5A5A5A5ul; // xorshift must not start at 0
 
     for (size_t i = 0; i < (size_ / 4); i++) {
- 
-      uint32_t random_u32 = static_cast<uint32_t>(random(__LONG_MAX__));
-      // This was a debug to verify that randomization was actually working.
-      // if (i < 10) {
-      //   DEBUG_SERIAL.print("## SDRAM: Randomizing memory value ");
-      //   DEBUG_SERIAL.println(random_u32, HEX);
-      // }
-      fast_ptr[i] = random_u32;
+      state = xorshift32(state);
+      fast_ptr[i] = state;
     }
   };
 
+  /// @brief The SDRAM backend is a flat array with no per-word write
+  /// tracking, so it cannot enumerate dirtied words; table_size() already
+  /// reports 0 for it. Present so BusEmulatorT instantiates for both
+  /// backends.
+  template <typename Visitor>
+  void for_each_word(Visitor&&) const {}
+
+  // Snapshot memory into a second SDRAM region, allocated on first use, so a
+  // restore is a single bulk copy instead of erasing and re-uploading the
+  // program between tests.
+  bool snapshot_memory() override {
+    if (!mem_) {
+      return false;
+    }
+    if (!shadow_) {
+      shadow_ = (uint8_t*)SDRAM.malloc(size_);
+      if (!shadow_) {
+        DEBUG_SERIAL.println("## SDRAM: Failed to allocate snapshot memory!");
+        ArduinoX86::MemTelemetry::note_fail();
+        return false;
+      }
+      ArduinoX86::MemTelemetry::note_alloc(size_);
+    }
+    memcpy(shadow_, mem_, size_);
+    DEBUG_SERIAL.println("## SDRAM: Memory snapshot taken");
+    return true;
+  }
+
+  bool restore_memory() override {
+    if (!mem_ || !shadow_) {
+      DEBUG_SERIAL.println("## SDRAM: Restore failed (no snapshot taken?)");
+      return false;
+    }
+    memcpy(mem_, shadow_, size_);
+    return true;
+  }
+
   void set_strategy(DefaultStrategy strategy, uint32_t start, uint32_t end) override {
     if (start < strategy_start_ || end > size_) {
       DEBUG_SERIAL.println("## SDRAM: Invalid strategy range");
@@ -229,6 +286,7 @@ private:
   size_t   size_;
   size_t   mask_;
   uint8_t* mem_;
+  uint8_t* shadow_ = nullptr; // Snapshot region, allocated on first snapshot.
   uint8_t* smram_;
   uint32_t base_seed_;
   uint32_t strategy_start_ = 0x1024; // Address below which to ignore strategy.
@@ -249,9 +307,21 @@ private:
   }
 
   uint16_t gen_random_u16(uint32_t address) {
-    // Generate a pseudo-random 16-bit value based on the address and base seed.
-    uint32_t seed = base_seed_ ^ address;
-    randomSeed(seed);
-    return static_cast<uint16_t>(random(std::numeric_limits<uint16_t>::max()));
+    // Generate a pseudo-random 16-bit value based on the address and base
+    // seed. Two xorshift rounds mix the address bits without the cost of
+    // reseeding the Arduino PRNG per value.
+    uint32_t x = base_seed_ ^ address;
+    x = xorshift32(x ? x : 0xA5A5A5A5ul);
+    x = xorshift32(x);
+    return static_cast<uint16_t>(x);
+  }
+
+  // One step of a 32-bit xorshift PRNG. Cheap enough to inline into fill
+  // loops; state must never be zero.
+  static uint32_t xorshift32(uint32_t x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
   }
 };
@@ -0,0 +1,42 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+// Minimal Print-style stand-in for DEBUG_SERIAL when the emulator headers
+// are compiled for the native test env (env:native). Debug output from the
+// code under test lands on stdout.
+
+#include <stdio.h>
+
+struct SerialShim {
+  void print(const char *s) { fputs(s, stdout); }
+  void println(const char *s) { fputs(s, stdout); fputc('\n', stdout); }
+  void println() { fputc('\n', stdout); }
+};
+
+static SerialShim HostDebugSerial;
+
+#ifndef DEBUG_SERIAL
+#define DEBUG_SERIAL HostDebugSerial
+#endif
@@ -75,6 +75,22 @@ public:
     shield.tickCpu();
   }
 
+  void captureSnapshot() {
+    shield.captureSnapshot();
+  }
+
+  bool startFreeRunClock(uint32_t hz) {
+    return shield.startFreeRunClock(hz);
+  }
+
+  void stopFreeRunClock() {
+    shield.stopFreeRunClock();
+  }
+
+  bool isFreeRunning() const {
+    return shield.isFreeRunning();
+  }
+
   static int getAddressBusWidth() {
     return Shield::getAddressBusWidth();
   }
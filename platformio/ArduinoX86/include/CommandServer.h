@@ -26,9 +26,15 @@
 #include <array>
 #include <cstdint>
 #include <cstdarg>
+#include <cstring>
 #include <serial_config.h>
 //#include <BoardController.h>
 #include <config.h>
+#include <protocol.h>
+#include <ConfigProfile.h>
+#include <DualCore.h>
+#include <SpscRing.h>
+#include <boards/BoardTraits.h>
 
 enum class ServerState: uint8_t {
   Reset           = 0x00, // The CPU is being reset. Also used as initial state.
@@ -71,51 +77,12 @@ public:
   static constexpr uint32_t FLAG_LOG_CYCLES         = 0x00000080; // Enable cycle logging
   static constexpr uint32_t FLAG_ALE_INTERRUPT      = 0x00000100; // Enable ALE interrupt to deassert READY at T1
   static constexpr uint32_t FLAG_RESOLVE_BUS_STEP   = 0x00000200; // Resolve the data bus when single-stepping (Execute state)
+  static constexpr uint32_t FLAG_FREE_RUN_CLOCK     = 0x00000400; // Drive CLK from a hardware timer during Load/Store phases (requires GIGA)
+  static constexpr uint32_t FLAG_TRACE_BINARY       = 0x00000800; // Trace as binary records instead of formatted text (see trace_cpu_state())
+  static constexpr uint32_t FLAG_FRAMED_PROTOCOL    = 0x00001000; // Framed protocol v2: CRC16 frames + sequence numbers (see protocol.h)
 
-  enum class ServerCommand {
-    CmdNone            = 0x00,
-    CmdVersion         = 0x01,
-    CmdResetCpu        = 0x02,
-    CmdLoad            = 0x03,
-    CmdCycle           = 0x04,
-    CmdReadAddressLatch= 0x05,
-    CmdReadStatus      = 0x06,
-    CmdRead8288Command = 0x07,
-    CmdRead8288Control = 0x08, 
-    CmdReadDataBus     = 0x09,
-    CmdWriteDataBus    = 0x0A,
-    CmdFinalize        = 0x0B,
-    CmdBeginStore      = 0x0C,
-    CmdStore           = 0x0D,
-    CmdQueueLen        = 0x0E,
-    CmdQueueBytes      = 0x0F,
-    CmdWritePin        = 0x10,
-    CmdReadPin         = 0x11,
-    CmdGetProgramState = 0x12,
-    CmdLastError       = 0x13,
-    CmdGetCycleState   = 0x14,
-    CmdAvailable00     = 0x15,
-    CmdPrefetchStore   = 0x16,
-    CmdReadAddress     = 0x17,
-    CmdCpuType         = 0x18,
-    CmdSetFlags        = 0x19,
-    CmdPrefetch        = 0x1A,
-    CmdInitScreen      = 0x1B,
-    CmdStoreAll        = 0x1C,
-    CmdSetRandomSeed   = 0x1D,
-    CmdRandomizeMem    = 0x1E,
-    CmdSetMemory       = 0x1F,
-    CmdGetCycleStates  = 0x20,
-    CmdEnableDebug     = 0x21,
-    CmdSetMemoryStrategy = 0x22,
-    CmdGetFlags        = 0x23,
-    CmdReadMemory      = 0x24,
-    CmdEraseMemory     = 0x25,
-    CmdServerStatus    = 0x26,
-    CmdClearCycleLog   = 0x27,
-    CmdSetProgramBounds = 0x28,
-    CmdInvalid
-  };
+  // ServerCommand lives in protocol.h so the M4 protocol front end can share
+  // the opcode and parameter-count definitions.
 
   enum class CommandState: uint8_t {
     WaitingForCommand = 0x01,
@@ -125,6 +92,24 @@ public:
 
   void reset();
   void run();
+
+  /// @brief Read `len` protocol bytes into buf, with the command timeout.
+  /// Used for variable-length parameter payloads (register files) that follow
+  /// a command's fixed parameter bytes.
+  bool read_parameter_bytes(uint8_t* buf, size_t len) {
+    size_t total = 0;
+    unsigned long start = millis();
+    while (total < len) {
+      int b = proto_read();
+      if (b >= 0) {
+        buf[total++] = (uint8_t)b;
+      }
+      else if (millis() - start > CMD_TIMEOUT_) {
+        return false;
+      }
+    }
+    return true;
+  }
   void change_state(ServerState new_state);
   ServerState state() const { return state_; }
   const char* get_last_error() const;
@@ -149,6 +134,11 @@ public:
 
   explicit CommandServer(BoardController<BoardType,HatType>& controller);
 
+  /// @brief Apply a stored configuration profile by replaying the equivalent
+  /// setup commands. Called from setup() with the default (slot 0) profile,
+  /// and by CmdSetProfile's apply op.
+  bool apply_profile(const ConfigProfileData& profile);
+
 private:
   static constexpr std::size_t CMD_COUNT =
     static_cast<std::size_t>(ServerCommand::CmdInvalid);
@@ -171,15 +161,38 @@ private:
   size_t commandByteN_ = 0;
   unsigned long commandStartTime_ = 0;
   unsigned long stateBeginTime_ = 0;
-  uint32_t flags_ = 0; 
+  uint32_t flags_ = 0;
   bool ale_interrupt_enabled_ = false;
+  bool responseDeferred_ = false; // Response is held until an async dump drains.
+  bool framedMode_ = false;       // Parse framed protocol v2 instead of raw command bytes.
+  bool frameActive_ = false;      // Current command arrived in a v2 frame; echo its sequence number.
+  uint8_t frameSeq_ = 0;          // Sequence number of the frame being serviced.
+  unsigned long frameStartTime_ = 0; // millis() when the partial frame at the ring head was first seen.
+
+#if !(USE_DUAL_CORE && defined(CORE_CM7))
+  // Software RX ring behind the proto_* accessors. Dual-core builds stage
+  // incoming bytes in the shared-memory rings instead.
+#if defined(ARDUINO_GIGA)
+  static constexpr uint32_t PROTO_RX_RING_SIZE = 4096;
+#else
+  static constexpr uint32_t PROTO_RX_RING_SIZE = 512;
+#endif
+  SpscRing<PROTO_RX_RING_SIZE> rxRing_;
+#endif
 
   // Error handling
   static constexpr size_t MAX_ERROR_LEN = 256;
   char errorBuffer_[MAX_ERROR_LEN] = {0};
 
   bool dispatch_command(ServerCommand cmd);
+  bool execute_command(ServerCommand cmd);
   uint8_t get_command_input_bytes(ServerCommand cmd);
+  void finish_command(bool result);
+#if USE_DUAL_CORE && defined(CORE_CM7)
+  void run_dual_core();
+#else
+  void run_framed();
+#endif
 
   // Error handling methods
   void set_error(const char* format, ...);
@@ -187,41 +200,176 @@ private:
     set_error("NO ERROR");
   }
 
+  // Transmit accumulator: response bytes are coalesced into board-sized
+  // buffers before being handed to the USB CDC stack, so bulk dumps cost one
+  // driver call per buffer instead of one per field. Every response ends in
+  // send_ok()/send_fail(), which drain the accumulator; paths that hand the
+  // stream to a direct INBAND_SERIAL writer (the async cycle dump, bus op
+  // dumps) must call proto_flush() first so bytes can't reorder.
+  static constexpr size_t PROTO_TX_BUF = BoardTraits<BoardType>::_PROTO_TX_BUF;
+  uint8_t txBuf_[PROTO_TX_BUF];
+  size_t txLen_ = 0;
+
+  void proto_drain() {
+    if (txLen_ > 0) {
+      INBAND_SERIAL.write(txBuf_, txLen_);
+      txLen_ = 0;
+    }
+  }
+
   void proto_write(const uint8_t* buf, size_t len) {
-    INBAND_SERIAL.write(buf, len);
+    protoBytesWritten_ += len;
+    if (len >= PROTO_TX_BUF) {
+      // Already a large write: drain what's pending and pass it through
+      // rather than chopping it up through the accumulator.
+      proto_drain();
+      INBAND_SERIAL.write(buf, len);
+      return;
+    }
+    if (txLen_ + len > PROTO_TX_BUF) {
+      proto_drain();
+    }
+    memcpy(&txBuf_[txLen_], buf, len);
+    txLen_ += len;
   }
 
   void proto_write(uint8_t b) {
-    INBAND_SERIAL.write(b);
+    protoBytesWritten_++;
+    if (txLen_ >= PROTO_TX_BUF) {
+      proto_drain();
+    }
+    txBuf_[txLen_++] = b;
   }
 
   void proto_flush() {
+    proto_drain();
     FLUSH;
   }
 
+#if USE_DUAL_CORE && defined(CORE_CM7)
+  // The M4 front end owns command framing; parameter and payload bytes arrive
+  // through the shared-memory payload ring rather than directly from USB.
+  // Responses above still go straight out over USB, since they need no
+  // parsing. Each read pumps raw USB bytes across to the M4 first.
+
   int proto_available() {
-    return INBAND_SERIAL.available();
+    dual_core_pump();
+    return (int)dual_core_shm()->payload_ring.available();
   }
 
   int proto_read() {
-    return INBAND_SERIAL.read();
+    dual_core_pump();
+    int b = dual_core_shm()->payload_ring.read();
+    if (b >= 0) {
+      protoBytesRead_++;
+    }
+    return b;
   }
 
   size_t proto_read(uint8_t* buf, size_t len) {
-    return INBAND_SERIAL.readBytes(buf, len);
+    // Mirrors Stream::readBytes(): block until `len` bytes have arrived or
+    // the link has stalled for the default one second timeout.
+    size_t total = 0;
+    unsigned long start = millis();
+    while (total < len) {
+      dual_core_pump();
+      uint32_t got = dual_core_shm()->payload_ring.read(buf + total, (uint32_t)(len - total));
+      if (got > 0) {
+        total += got;
+        start = millis();
+      }
+      else if (millis() - start >= 1000) {
+        break;
+      }
+    }
+    protoBytesRead_ += total;
+    return total;
   }
 
   int proto_peek() {
-    return INBAND_SERIAL.peek();
+    dual_core_pump();
+    DualCoreShm* shm = dual_core_shm();
+    if (shm->payload_ring.available() == 0) {
+      return -1;
+    }
+    return shm->payload_ring.peek(0);
+  }
+#else
+  // Incoming bytes are staged in a software ring fed from the interrupt-
+  // driven serial driver, so they accumulate between run() passes regardless
+  // of server state, the host can pipeline commands back-to-back, and reads
+  // drain the ring rather than busy-waiting on the driver FIFO.
+
+  void proto_pump() {
+    while (rxRing_.free_space() > 0 && INBAND_SERIAL.available() > 0) {
+      int b = INBAND_SERIAL.read();
+      if (b < 0) {
+        break;
+      }
+      rxRing_.write((uint8_t)b);
+    }
+  }
+
+  int proto_available() {
+    proto_pump();
+    return (int)rxRing_.available();
   }
 
+  int proto_read() {
+    proto_pump();
+    int b = rxRing_.read();
+    if (b >= 0) {
+      protoBytesRead_++;
+    }
+    return b;
+  }
+
+  size_t proto_read(uint8_t* buf, size_t len) {
+    // Mirrors Stream::readBytes(): block until `len` bytes have arrived or
+    // the link has stalled for the default one second timeout.
+    size_t total = 0;
+    unsigned long start = millis();
+    while (total < len) {
+      proto_pump();
+      uint32_t got = rxRing_.read(buf + total, (uint32_t)(len - total));
+      if (got > 0) {
+        total += got;
+        start = millis();
+      }
+      else if (millis() - start >= 1000) {
+        break;
+      }
+    }
+    protoBytesRead_ += total;
+    return total;
+  }
+
+  int proto_peek() {
+    proto_pump();
+    if (rxRing_.available() == 0) {
+      return -1;
+    }
+    return rxRing_.peek(0);
+  }
+#endif
+
   void send_ok() {
     proto_write(RESPONSE_OK);
+    if (frameActive_) {
+      // Framed protocol v2: the status trailer carries the frame's sequence
+      // number so a pipelining host can match responses to frames.
+      proto_write(frameSeq_);
+      frameActive_ = false;
+    }
     proto_flush();
   }
 
   void send_fail() {
     proto_write(RESPONSE_FAIL);
+    if (frameActive_) {
+      proto_write(frameSeq_);
+      frameActive_ = false;
+    }
     proto_flush();
   }
 
@@ -265,13 +413,87 @@ private:
   bool cmd_randomize_mem(void);
   bool cmd_set_memory(void);
   bool cmd_get_cycle_states(void);
+  bool cmd_get_cycle_states_c(void);
+  bool cmd_set_socket_gen(void);
+  bool cmd_snapshot_memory(void);
+  bool cmd_restore_snapshot(void);
+  bool cmd_get_trace_meta(void);
+  bool cmd_set_watchpoint(void);
+  bool cmd_get_watch_hit(void);
+  bool cmd_get_cycle_states_from(void);
   bool cmd_enable_debug(void);
   bool cmd_set_memory_strategy(void);
   bool cmd_get_flags(void);
   bool cmd_read_memory(void);
+  bool cmd_crc_memory(void);
+  bool cmd_get_bus_ops(void);
+  bool cmd_set_bus_log_capacity(void);
+  bool cmd_stream_memory(void);
+  bool cmd_set_wait_states(void);
+  bool cmd_set_ready_timer(void);
+  bool cmd_set_profile(void);
+  bool cmd_get_state_profile(void);
+  bool cmd_set_pin_inject(void);
+  bool cmd_set_fpu_stub(void);
+  bool cmd_set_refresh(void);
+  bool cmd_get_full_state(void);
+  bool cmd_get_test_result(void);
+  bool cmd_set_int_vector(void);
+  bool cmd_set_port_handler(void);
+  bool cmd_gen_program(void);
   bool cmd_erase_memory(void);
   bool cmd_server_status(void);
   bool cmd_clear_cycle_log(void);
   bool cmd_set_program_bounds(void);
+  bool cmd_cycle_batch(void);
+  bool cmd_upload_memory(void);
+  bool cmd_run_batch(void);
   bool cmd_null(void);
+
+  // Per-command dispatch statistics, recorded around execute_command() and
+  // exported (with the rest of the telemetry) by cmd_server_status. Byte
+  // counts come from the monotonic proto_read/proto_write counters below, so
+  // they include parameter reads, streamed payloads and response bytes
+  // attributable to each command.
+  struct CommandStats {
+    uint32_t count;         // Invocations
+    uint64_t total_us;      // Cumulative handler execution time
+    uint32_t max_us;        // Slowest single invocation
+    uint64_t bytes_read;    // Protocol bytes consumed by the handler
+    uint64_t bytes_written; // Protocol bytes produced by the handler
+  };
+  CommandStats commandStats_[SERVER_COMMAND_COUNT] = {};
+  uint64_t protoBytesRead_ = 0;
+  uint64_t protoBytesWritten_ = 0;
+
+  // Per-state dwell-time profiler, updated on every change_state(): where
+  // wall time goes inside a test (Load vs Execute vs Store vs idle), so the
+  // host can decide whether clocking, patching or serial is the next
+  // bottleneck. Exported and reset via CmdGetStateProfile.
+  struct StateDwell {
+    uint64_t total_us; // Cumulative microseconds spent in the state
+    uint32_t max_us;   // Longest single dwell
+    uint32_t entries;  // Number of completed dwells
+  };
+  static constexpr size_t STATE_COUNT = static_cast<size_t>(ServerState::Error) + 1;
+  StateDwell stateDwell_[STATE_COUNT] = {};
+
+  // Shadow copies of configuration the setup commands install elsewhere
+  // (the RNG, Cpu bounds, the bus backend's strategy table), kept so
+  // CmdSetProfile can snapshot the current session without read-back paths.
+  uint32_t profileSeed_ = 0;
+  uint32_t profileBoundsStart_ = 0;
+  uint32_t profileBoundsEnd_ = 0;
+  uint8_t  profileRegionCount_ = 0;
+  ConfigProfileRegion profileRegions_[CONFIG_PROFILE_MAX_REGIONS] = {};
+
+  /// @brief Fill a profile from the shadowed session configuration.
+  void capture_profile(ConfigProfileData& profile);
+
+  // cmd_load helpers, shared with the batch test executor.
+  bool install_registers(uint8_t reg_type);
+  bool reset_and_load(bool reset_cpu);
+  bool write_stored_registers(void);
+
+  void fill_cycle_state_buf(uint8_t* buf);
 };
\ No newline at end of file
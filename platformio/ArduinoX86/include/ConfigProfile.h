@@ -0,0 +1,123 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/// @file ConfigProfile.h
+/// @brief Flash-persisted configuration profiles (CmdSetProfile).
+///
+/// Every session used to begin with the same ritual of CmdSetFlags,
+/// CmdSetMemoryStrategy, CmdSetRandomSeed, CmdSetProgramBounds and
+/// CmdEnableDebug round trips. A profile snapshots that configuration into
+/// internal flash; slot 0 is the default profile, applied during setup()
+/// before the first command, so a rig comes back from a reconnect or a
+/// watchdog reset already configured.
+///
+/// Unlike the CpuIdCache (which lives in .noinit RAM and only survives warm
+/// resets), profiles must survive power cycles, so they live in the last
+/// flash sector of bank 2 on the Giga - well above the M4 front-end image
+/// at the start of the bank. Validity is established per slot by magic,
+/// version and checksum, exactly as the CpuIdCache does it, so erased or
+/// torn flash just reads as "no profile". Boards without a wired flash
+/// driver (currently the Due) refuse saves and report no stored profiles.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CONFIG_PROFILE_MAGIC   0x50435841ul // "AXCP"
+#define CONFIG_PROFILE_VERSION 1
+
+/// @brief Number of profile slots. Slot 0 is the default profile applied at
+/// boot; the others are selectable via CmdSetProfile.
+#define CONFIG_PROFILE_SLOTS 4
+
+/// @brief Maximum persisted memory-strategy regions, matching the backend's
+/// strategy region table.
+#define CONFIG_PROFILE_MAX_REGIONS 8
+
+/// @brief One persisted default-value strategy region, as configured by
+/// CmdSetMemoryStrategy.
+struct ConfigProfileRegion {
+  uint32_t start;
+  uint32_t end;
+  uint8_t  strategy;
+  uint8_t  reserved[3];
+};
+
+/// @brief One persisted configuration profile. Sized to a multiple of the
+/// H7 flash program page (32 bytes) so slots can be written independently
+/// aligned within the sector.
+struct ConfigProfileData {
+  uint32_t magic;
+  uint16_t version;
+  uint8_t  region_count;   // Valid entries in regions[]
+  uint8_t  debug_enabled;  // Board debug output on/off
+  uint32_t server_flags;   // CommandServer flags_ (CmdSetFlags)
+  uint32_t random_seed;    // CmdSetRandomSeed
+  uint32_t program_start;  // CmdSetProgramBounds
+  uint32_t program_end;
+  ConfigProfileRegion regions[CONFIG_PROFILE_MAX_REGIONS];
+  uint32_t reserved;
+  uint32_t checksum;
+};
+
+static_assert(sizeof(ConfigProfileData) == 128, "ConfigProfileData must stay flash-page aligned");
+
+/// @brief Compute the validity checksum over a profile. The rotate keeps
+/// reordered words from cancelling and the constant keeps an all-zero (or
+/// all-ones, erased-flash) profile from checksumming to itself.
+inline uint32_t config_profile_sum(const ConfigProfileData& profile) {
+  const uint32_t* words = reinterpret_cast<const uint32_t*>(&profile);
+  const size_t count = (sizeof(ConfigProfileData) - sizeof(uint32_t)) / sizeof(uint32_t);
+  uint32_t sum = 0xA5A5A5A5ul;
+  for (size_t i = 0; i < count; i++) {
+    sum = ((sum << 1) | (sum >> 31)) ^ words[i];
+  }
+  return sum;
+}
+
+/// @brief Returns true if the profile holds a configuration saved by this
+/// firmware version.
+inline bool config_profile_valid(const ConfigProfileData& profile) {
+  return (profile.magic == CONFIG_PROFILE_MAGIC) &&
+         (profile.version == CONFIG_PROFILE_VERSION) &&
+         (profile.checksum == config_profile_sum(profile));
+}
+
+/// @brief Read a profile slot from flash.
+/// @param slot Slot index (0 to CONFIG_PROFILE_SLOTS - 1).
+/// @param out Filled with the stored profile on success.
+/// @return True if the slot holds a valid profile.
+bool config_profile_load(uint8_t slot, ConfigProfileData& out);
+
+/// @brief Persist a profile to a flash slot. The checksum is computed here;
+/// the caller fills in everything else.
+/// @param slot Slot index (0 to CONFIG_PROFILE_SLOTS - 1).
+/// @param profile Profile to store.
+/// @return True if the profile was written and verified.
+bool config_profile_save(uint8_t slot, ConfigProfileData& profile);
+
+/// @brief Erase a profile slot (or all slots).
+/// @param slot Slot index, or 0xFF to erase every slot.
+/// @return True if the flash operation succeeded.
+bool config_profile_erase(uint8_t slot);
@@ -92,6 +92,7 @@ public:
   int execute_cycle_ct;
   int wait_states;
   int wait_state_ct;
+  int wait_states_active; // Nonzero while READY is held low for a region wait profile
   bool exception_armed;
   uint32_t predicted_fetch;
   uint32_t exception_stage;
@@ -0,0 +1,72 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Persistent cache of the CPU identification results, so warm resets of the
+// board can skip re-running the timing-based CPU ID program. The chip in the
+// socket does not change between the thousands of resets of a test run, but
+// the ID program costs hundreds of bit-banged clock cycles per boot.
+//
+// The instance lives in a .noinit section (see main.cpp), which survives warm
+// resets on cores whose linker script carries the section through. Validity is
+// established by magic and checksum, so cold power-up garbage — or zeros on
+// cores that initialize the section anyway — just falls back to a full
+// detection pass. The host can invalidate the cache after a chip swap by
+// bumping the socket generation counter (CmdSetSocketGen).
+
+#pragma once
+
+#include <stdint.h>
+
+#define CPU_ID_CACHE_MAGIC 0x58444943ul // "CIDX"
+
+struct CpuIdCache {
+  uint32_t magic;
+  uint32_t generation; // Host-settable socket generation counter.
+  uint8_t  cpu_type;   // Cached CpuType
+  uint8_t  fpu_type;   // Cached FpuType
+  uint8_t  width;      // Cached CpuBusWidth
+  uint8_t  reserved;
+  uint32_t checksum;
+};
+
+/// @brief Compute the validity checksum over a cache entry. The constant keeps
+/// an all-zero entry from checksumming to zero.
+inline uint32_t cpu_id_cache_sum(const CpuIdCache& cache) {
+  return cache.magic ^ cache.generation ^
+         (static_cast<uint32_t>(cache.cpu_type)) ^
+         (static_cast<uint32_t>(cache.fpu_type) << 8) ^
+         (static_cast<uint32_t>(cache.width) << 16) ^
+         0xA5A5A5A5ul;
+}
+
+/// @brief Returns true if the cache entry holds identification results from a
+/// previous boot.
+inline bool cpu_id_cache_valid(const CpuIdCache& cache) {
+  return (cache.magic == CPU_ID_CACHE_MAGIC) && (cache.checksum == cpu_id_cache_sum(cache));
+}
+
+/// @brief Invalidate a cache entry. The generation field is left alone so a
+/// host-set generation survives until the next detection pass stores it.
+inline void cpu_id_cache_invalidate(CpuIdCache& cache) {
+  cache.magic = 0;
+}
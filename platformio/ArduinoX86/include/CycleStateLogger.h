@@ -3,7 +3,12 @@
 
 #include <cstdlib>
 #include <cstddef>
+#include <cstring>
 #include <SDRAM.h>
+#include <SdramInit.h>
+#include <TraceSeq.h>
+#include <TraceFormat.h>
+#include <MemTelemetry.h>
 
 #include <serial_config.h>
 
@@ -15,59 +20,173 @@ struct __attribute__((packed)) CycleState {
   uint8_t  bus_control_bits;
   uint8_t  bus_command_bits;
   uint16_t pins;
+  uint8_t  repeat; // Additional identical cycles coalesced into this record
+#if CYCLE_TIMESTAMPS
+  uint32_t timestamp; // DWT->CYCCNT at log() time (see config.h)
+#endif
 
   public:
     static constexpr uint16_t ALE = 0x0001; // Address Latch Enable
     static constexpr uint16_t BHE = 0x0002; // Bus High Enable
     static constexpr uint16_t READY = 0x0004; // Ready line
     static constexpr uint16_t LOCK = 0x0008; // Lock line
+    static constexpr uint16_t HOLD = 0x0010; // Refresh generator holding the bus
+};
+
+// Per-cycle trace metadata logged alongside CycleState in binary trace mode.
+// Together the two records carry everything print_cpu_state() formats; the
+// mnemonic is derived host-side from the opcode byte.
+struct __attribute__((packed)) CycleTraceMeta {
+  uint8_t server_state; // ServerState at this cycle
+  uint8_t queue_len;    // Instruction queue length
+  uint8_t queue_byte;   // Last byte read from the queue
+  uint8_t opcode;       // Currently executing opcode
 };
 
-// Maximum number of CycleState entries to hold
+// Maximum number of CycleState entries to hold per bank
 #if defined(ARDUINO_GIGA)
 #define MAX_CYCLE_STATES 8192
 #else
 #define MAX_CYCLE_STATES 512
 #endif
 
+// The logger holds two banks of MAX_CYCLE_STATES entries each. In streaming
+// mode the banks swap when the active bank fills, and the inactive bank is
+// drained to TRACE_SERIAL in the background via service(), allowing traces
+// longer than a single bank without stopping the CPU clock.
+#define CYCLE_STATE_BANKS 2
+
 class CycleStateLogger {
 public:
   CycleStateLogger()
-    : buffer_(nullptr)
-    , next_(0)
+    : next_(0)
     , wrapped_(false)
   {
-    #if defined(ARDUINO_GIGA)
-      buffer_ = static_cast<CycleState*>(SDRAM.malloc(sizeof(CycleState) * MAX_CYCLE_STATES));
-    #else
-      buffer_ = static_cast<CycleState*>(std::malloc(sizeof(CycleState) * MAX_CYCLE_STATES));
-    #endif
+    for (size_t b = 0; b < CYCLE_STATE_BANKS; b++) {
+      #if defined(ARDUINO_GIGA)
+        ensure_sdram();
+        banks_[b] = static_cast<CycleState*>(SDRAM.malloc(sizeof(CycleState) * MAX_CYCLE_STATES));
+      #else
+        banks_[b] = static_cast<CycleState*>(std::malloc(sizeof(CycleState) * MAX_CYCLE_STATES));
+      #endif
+    }
 
-    if (!buffer_) {
+    if (!banks_[0] || !banks_[1]) {
       DEBUG_SERIAL.println("CycleStateLogger: Memory allocation failed!");
+      ArduinoX86::MemTelemetry::note_fail();
     }
     else {
-      DEBUG_SERIAL.println("CycleStateLogger: Log buffer allocated successfully.");
+      DEBUG_SERIAL.println("CycleStateLogger: Log buffers allocated successfully.");
+      ArduinoX86::MemTelemetry::note_alloc(CYCLE_STATE_BANKS * sizeof(CycleState) * MAX_CYCLE_STATES);
     }
+
+#if CYCLE_TIMESTAMPS
+    // Start the free-running DWT cycle counter used to timestamp records.
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
     reset();
   }
 
   ~CycleStateLogger() {
-      std::free(buffer_);
+      for (size_t b = 0; b < CYCLE_STATE_BANKS; b++) {
+        std::free(banks_[b]);
+        std::free(meta_banks_[b]);
+      }
   }
 
-  // Record a new cycle state
+  // Record a new cycle state. Runs of identical cycles (idle Ti, wait-state
+  // TW, HALT) are coalesced at capture time: a state matching the previous
+  // record bumps its repeat counter instead of consuming a slot, stretching
+  // the effective buffer depth by an order of magnitude for exactly the
+  // workloads that overflow it. Coalesced repeats share their record's trace
+  // sequence number, so host read cursors keep counting records.
   void log(const CycleState& state) {
     if (!enabled_) return; // Ignore if logging is disabled
-    buffer_[next_] = state;
-    next_ = (next_ + 1) % MAX_CYCLE_STATES;
-    if (next_ == 0) wrapped_ = true;
+#if !CYCLE_TIMESTAMPS
+    // Timestamped builds never coalesce; the per-cycle timestamp is the
+    // point. The previous record may sit at the top of the ring when we have
+    // wrapped, but never in a drained streaming bank.
+    if (next_ > 0 || (wrapped_ && !streaming_)) {
+      size_t prev_idx = (next_ == 0) ? MAX_CYCLE_STATES - 1 : next_ - 1;
+      CycleState& prev = banks_[active_bank_][prev_idx];
+      if (prev.repeat < 255 && same_state(prev, state)) {
+        prev.repeat++;
+        return;
+      }
+    }
+#endif
+    banks_[active_bank_][next_] = state;
+    banks_[active_bank_][next_].repeat = 0;
+#if CYCLE_TIMESTAMPS
+    // Stamp at log() time so the delta to the previous record measures the
+    // real firmware time spent on this target-CPU cycle.
+    banks_[active_bank_][next_].timestamp = DWT->CYCCNT;
+#endif
+    next_++;
+    // Advance the shared trace sequence so bus operations logged on this
+    // cycle stamp the same number.
+    seq_ = ++ArduinoX86::TraceSeq;
+    if (next_ == MAX_CYCLE_STATES) {
+      if (streaming_) {
+        // Swap banks; the full bank is drained by service() while we keep
+        // filling the other one. If the previous bank hasn't finished
+        // draining yet we have to overwrite it and count the loss.
+        if (pending_drain_) {
+          dropped_banks_++;
+        }
+        pending_bank_ = active_bank_;
+        pending_drain_ = true;
+        drain_pos_ = 0;
+        active_bank_ = (active_bank_ + 1) % CYCLE_STATE_BANKS;
+        next_ = 0;
+      }
+      else {
+        next_ = 0;
+        wrapped_ = true;
+      }
+    }
+  }
+
+  // Record a cycle state together with its trace metadata. The metadata
+  // banks are allocated on first use, so their memory is only paid for when
+  // binary tracing is actually enabled. If allocation fails, the cycle state
+  // is still logged and the metadata is simply absent from the dump.
+  void log_trace(const CycleState& state, const CycleTraceMeta& meta) {
+    if (!enabled_) return;
+    if (meta_banks_[0] || alloc_trace_meta()) {
+      meta_banks_[active_bank_][next_] = meta;
+    }
+    log(state);
+  }
+
+  // Dump the trace metadata for the logged cycles: trace header (see
+  // TraceFormat.h), entry count (4 bytes), size in bytes (4 bytes), then raw
+  // CycleTraceMeta entries matching the cycle states one-to-one. A zero count
+  // means binary tracing never ran.
+  void dump_trace_meta() {
+    write_trace_header(TraceKind::CycleTraceMeta, sizeof(CycleTraceMeta), 0);
+    uint32_t count = meta_banks_[active_bank_] ? static_cast<uint32_t>(len()) : 0;
+    TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&count), sizeof(count));
+    size_t size = count * sizeof(CycleTraceMeta);
+    TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&size), sizeof(size));
+    if (count > 0) {
+      TRACE_SERIAL.write(reinterpret_cast<const uint8_t*>(meta_banks_[active_bank_]), size);
+    }
   }
 
   // Clear all stored entries
   void reset() {
     next_ = 0;
     wrapped_ = false;
+    active_bank_ = 0;
+    pending_drain_ = false;
+    drain_pos_ = 0;
+    dropped_banks_ = 0;
+    // The shared counter is never rewound, so host read cursors stay valid
+    // across a reset; an empty buffer is conveyed by len() == 0.
+    seq_ = ArduinoX86::TraceSeq;
   }
 
   void enable_logging() {
@@ -78,37 +197,391 @@ public:
     enabled_ = false;
   }
 
-  // Number of entries currently stored
+  // Enter streaming mode: full banks are emitted to TRACE_SERIAL via
+  // service() instead of wrapping in place. One trace header leads the whole
+  // stream; each drained bank is then framed with just its entry count.
+  void begin_streaming() {
+    reset();
+    write_trace_header(TraceKind::CycleStates, sizeof(CycleState), cycle_state_fields());
+    streaming_ = true;
+  }
+
+  // Leave streaming mode, flushing any drained or partially-filled data.
+  void end_streaming() {
+    while (pending_drain_) {
+      service();
+    }
+    if (next_ > 0) {
+      write_entries(banks_[active_bank_], next_);
+      next_ = 0;
+    }
+    streaming_ = false;
+  }
+
+  bool is_streaming() const {
+    return streaming_;
+  }
+
+  // Number of banks overwritten because the serial drain could not keep up.
+  uint32_t dropped_banks() const {
+    return dropped_banks_;
+  }
+
+  // Begin a non-blocking dump of the current log buffer. The data is emitted
+  // in the same format as dump_states(), but is drained in chunks from
+  // service() so the server stays responsive while the buffer transfers.
+  void start_dump_async() {
+    dump_count_ = len();
+    dump_pos_ = 0;
+    dump_header_sent_ = false;
+    dump_pending_ = true;
+  }
+
+  bool dump_in_progress() const {
+    return dump_pending_;
+  }
+
+  // Drain a chunk of the pending bank or async dump to TRACE_SERIAL. Called
+  // from the main loop so the transfer is interleaved with cycle execution
+  // rather than blocking for the whole buffer.
+  void service() {
+    if (dump_pending_) {
+      service_dump();
+      return;
+    }
+    if (!pending_drain_) return;
+
+    if (drain_pos_ == 0) {
+      // Each bank is framed with its entry count, like dump_states().
+      uint32_t count = MAX_CYCLE_STATES;
+      TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&count), sizeof(count));
+    }
+
+    size_t remain = MAX_CYCLE_STATES - drain_pos_;
+    size_t chunk = (remain < DRAIN_CHUNK) ? remain : DRAIN_CHUNK;
+    TRACE_SERIAL.write(
+      reinterpret_cast<const uint8_t*>(banks_[pending_bank_] + drain_pos_),
+      chunk * sizeof(CycleState));
+    drain_pos_ += chunk;
+
+    if (drain_pos_ == MAX_CYCLE_STATES) {
+      pending_drain_ = false;
+      drain_pos_ = 0;
+    }
+  }
+
+  // Number of entries currently stored in the active bank
   size_t len() const {
     return wrapped_ ? MAX_CYCLE_STATES : next_;
   }
 
   void dump_states() {
-    // Dump the current log buffer as raw bytes.
+    // Dump the current log buffer as raw bytes, led by the trace header.
+    write_trace_header(TraceKind::CycleStates, sizeof(CycleState), cycle_state_fields());
     uint32_t count = len();
-#if DEBUG_DUMP    
+#if DEBUG_DUMP
     DEBUG_SERIAL.print("## CycleStateLogger: Dumping ");
     DEBUG_SERIAL.print(count);
     DEBUG_SERIAL.print(" cycles, ");
-#endif    
+#endif
     uint8_t *count_bytes = reinterpret_cast<uint8_t*>(&count);
     // Write the count first as 4 bytes
-    INBAND_SERIAL.write(count_bytes, sizeof(count));
+    TRACE_SERIAL.write(count_bytes, sizeof(count));
     // Next, write the size in bytes to follow
     size_t size = count * sizeof(CycleState);
 #if DEBUG_DUMP
     DEBUG_SERIAL.print(size);
     DEBUG_SERIAL.println(" bytes total.");
-#endif    
+#endif
     uint8_t *size_bytes = reinterpret_cast<uint8_t*>(&size);
-    INBAND_SERIAL.write(size_bytes, sizeof(size));
+    TRACE_SERIAL.write(size_bytes, sizeof(size));
     // Finally, write the actual CycleState entries
-    INBAND_SERIAL.write(reinterpret_cast<const uint8_t*>(buffer_), len() * sizeof(CycleState));
+    TRACE_SERIAL.write(reinterpret_cast<const uint8_t*>(banks_[active_bank_]), len() * sizeof(CycleState));
+  }
+
+  // Dump the current log buffer delta-compressed. Consecutive cycles differ
+  // in only a couple of fields (address_bus walks during fetch runs; pins and
+  // status bytes hold for whole T-states), so each entry is encoded as a
+  // change bitmask followed by only the changed fields, and runs of identical
+  // entries (idle Ti cycles) are run-length encoded. Typical traces shrink
+  // 5-8x, which is a direct cut in drain time at serial link rates.
+  //
+  // Format: trace header (see TraceFormat.h), entry count (4 bytes), then
+  // tokens until `count` entries have been reconstructed against a zeroed
+  // initial state:
+  //   bit 7 clear: bits 0-6 are a field change mask in struct order
+  //     (0x01 address_bus, 0x02 data_bus, 0x04 cpu_state, 0x08 cpu_status0,
+  //      0x10 bus_control_bits, 0x20 bus_command_bits, 0x40 pins), followed
+  //     by the raw little-endian bytes of each changed field.
+  //   bit 7 set (0x80): followed by one byte N; repeat the previous entry
+  //     N more times.
+  // In CYCLE_TIMESTAMPS builds every delta token additionally ends with the
+  // raw 4-byte timestamp; repeat tokens never occur since the timestamp
+  // makes consecutive entries distinct.
+  void dump_states_compressed() {
+    // Tokens are variable-length, so the header carries a record size of 0.
+    write_trace_header(TraceKind::CycleStatesCompressed, 0, cycle_state_fields());
+    uint32_t records = len();
+    // The count is total cycles represented, with capture-time coalesced
+    // repeats expanded back into run tokens, so the reconstructed stream is
+    // identical to what an uncoalesced capture would have produced.
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < records; i++) {
+      count += (uint32_t)banks_[active_bank_][i].repeat + 1;
+    }
+    uint8_t *count_bytes = reinterpret_cast<uint8_t*>(&count);
+    TRACE_SERIAL.write(count_bytes, sizeof(count));
+
+    CycleState prev;
+    memset(&prev, 0, sizeof(CycleState));
+    uint32_t run = 0;
+
+    for (uint32_t i = 0; i < records; i++) {
+      const CycleState &cur = banks_[active_bank_][i];
+      uint32_t reps = cur.repeat;
+      if ((i > 0) && same_state(cur, prev)) {
+        // Adjacent identical records only occur when a repeat counter
+        // saturated at capture time; fold this one into the run too.
+        reps += 1;
+      }
+      else {
+        flush_run(run);
+        write_delta(prev, cur);
+        prev = cur;
+      }
+      run += reps;
+    }
+    flush_run(run);
+  }
+
+  // Dump only the entries logged after `cursor`, a sequence number previously
+  // returned by this method (or 0 for the first poll). Each logged entry gets
+  // a monotonically increasing 32-bit sequence number, so a polling host
+  // transfers O(new data) per request instead of re-downloading the whole
+  // buffer. Entries that have already scrolled out of the ring are simply
+  // gone; the count reflects what is still available. A cursor ahead of the
+  // current sequence means the logger was reset since the last poll, and the
+  // full buffer is returned.
+  //
+  // Format: trace header (see TraceFormat.h), new cursor (4 bytes), entry
+  // count (4 bytes), size in bytes (4 bytes), then raw CycleState entries
+  // oldest-first.
+  void dump_states_from(uint32_t cursor) {
+    write_trace_header(TraceKind::CycleStatesFrom, sizeof(CycleState), cycle_state_fields());
+    uint32_t avail = len();
+    uint32_t count;
+    if (cursor > seq_) {
+      count = avail;
+    }
+    else {
+      count = seq_ - cursor;
+      if (count > avail) count = avail;
+    }
+
+    uint32_t new_cursor = seq_;
+    TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&new_cursor), sizeof(new_cursor));
+    TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&count), sizeof(count));
+    size_t size = count * sizeof(CycleState);
+    uint8_t *size_bytes = reinterpret_cast<uint8_t*>(&size);
+    TRACE_SERIAL.write(size_bytes, sizeof(size));
+
+    if (count == 0) return;
+
+    // The newest entry is at next_ - 1; walk back `count` entries, which may
+    // wrap around the ring, and emit up to two contiguous spans.
+    size_t start = (next_ + MAX_CYCLE_STATES - count) % MAX_CYCLE_STATES;
+    if (start + count <= MAX_CYCLE_STATES) {
+      TRACE_SERIAL.write(
+        reinterpret_cast<const uint8_t*>(banks_[active_bank_] + start),
+        count * sizeof(CycleState));
+    }
+    else {
+      size_t first = MAX_CYCLE_STATES - start;
+      TRACE_SERIAL.write(
+        reinterpret_cast<const uint8_t*>(banks_[active_bank_] + start),
+        first * sizeof(CycleState));
+      TRACE_SERIAL.write(
+        reinterpret_cast<const uint8_t*>(banks_[active_bank_]),
+        (count - first) * sizeof(CycleState));
+    }
   }
 
 private:
-  CycleState* buffer_;
+  // Optional CycleState fields compiled into this build, for the trace
+  // header's field bitmap.
+  static constexpr uint32_t cycle_state_fields() {
+#if CYCLE_TIMESTAMPS
+    return TRACE_FIELD_REPEAT | TRACE_FIELD_TIMESTAMP;
+#else
+    return TRACE_FIELD_REPEAT;
+#endif
+  }
+
+  // Emit the self-describing header that leads every bulk dump.
+  void write_trace_header(TraceKind kind, uint8_t record_size, uint32_t fields) {
+    TraceHeader header = make_trace_header(kind, record_size, fields);
+    TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+  }
+
+  // Fields a capture-time coalesce must match on: everything except the
+  // repeat counter itself (and the timestamp, absent in coalescing builds).
+  static bool same_state(const CycleState &a, const CycleState &b) {
+    return a.address_bus == b.address_bus &&
+           a.data_bus == b.data_bus &&
+           a.cpu_state == b.cpu_state &&
+           a.cpu_status0 == b.cpu_status0 &&
+           a.bus_control_bits == b.bus_control_bits &&
+           a.bus_command_bits == b.bus_command_bits &&
+           a.pins == b.pins;
+  }
+
+  // Emit a repeat token for `run` copies of the previous entry.
+  void write_run(uint8_t run) {
+    uint8_t buf[2] = { 0x80, run };
+    TRACE_SERIAL.write(buf, sizeof(buf));
+  }
+
+  // Emit a run in token-sized chunks and zero it.
+  void flush_run(uint32_t &run) {
+    while (run > 0) {
+      uint8_t chunk = (run > 255) ? 255 : (uint8_t)run;
+      write_run(chunk);
+      run -= chunk;
+    }
+  }
+
+  // Emit a change mask and the raw bytes of each field that differs.
+  void write_delta(const CycleState &prev, const CycleState &cur) {
+    uint8_t buf[1 + sizeof(CycleState)];
+    size_t n = 1;
+    uint8_t mask = 0;
+
+    // Multi-byte fields go through locals; the struct is packed, so taking
+    // member addresses directly would hand out unaligned pointers.
+    if (cur.address_bus != prev.address_bus) {
+      mask |= 0x01;
+      uint32_t address_bus = cur.address_bus;
+      memcpy(&buf[n], &address_bus, sizeof(address_bus));
+      n += sizeof(address_bus);
+    }
+    if (cur.data_bus != prev.data_bus) {
+      mask |= 0x02;
+      uint16_t data_bus = cur.data_bus;
+      memcpy(&buf[n], &data_bus, sizeof(data_bus));
+      n += sizeof(data_bus);
+    }
+    if (cur.cpu_state != prev.cpu_state) {
+      mask |= 0x04;
+      buf[n++] = cur.cpu_state;
+    }
+    if (cur.cpu_status0 != prev.cpu_status0) {
+      mask |= 0x08;
+      buf[n++] = cur.cpu_status0;
+    }
+    if (cur.bus_control_bits != prev.bus_control_bits) {
+      mask |= 0x10;
+      buf[n++] = cur.bus_control_bits;
+    }
+    if (cur.bus_command_bits != prev.bus_command_bits) {
+      mask |= 0x20;
+      buf[n++] = cur.bus_command_bits;
+    }
+    if (cur.pins != prev.pins) {
+      mask |= 0x40;
+      uint16_t pins = cur.pins;
+      memcpy(&buf[n], &pins, sizeof(pins));
+      n += sizeof(pins);
+    }
+
+#if CYCLE_TIMESTAMPS
+    // The change mask has no spare bit (0x80 is the repeat token), and the
+    // timestamp changes every cycle anyway, so it rides along raw on every
+    // delta token.
+    {
+      uint32_t timestamp = cur.timestamp;
+      memcpy(&buf[n], &timestamp, sizeof(timestamp));
+      n += sizeof(timestamp);
+    }
+#endif
+
+    buf[0] = mask;
+    TRACE_SERIAL.write(buf, n);
+  }
+
+  // Allocate the trace metadata banks, mirroring the cycle state banks.
+  bool alloc_trace_meta() {
+    for (size_t b = 0; b < CYCLE_STATE_BANKS; b++) {
+      if (!meta_banks_[b]) {
+        #if defined(ARDUINO_GIGA)
+          ensure_sdram();
+          meta_banks_[b] = static_cast<CycleTraceMeta*>(SDRAM.malloc(sizeof(CycleTraceMeta) * MAX_CYCLE_STATES));
+        #else
+          meta_banks_[b] = static_cast<CycleTraceMeta*>(std::malloc(sizeof(CycleTraceMeta) * MAX_CYCLE_STATES));
+        #endif
+        if (meta_banks_[b]) {
+          ArduinoX86::MemTelemetry::note_alloc(sizeof(CycleTraceMeta) * MAX_CYCLE_STATES);
+        }
+        else {
+          ArduinoX86::MemTelemetry::note_fail();
+        }
+      }
+    }
+    return meta_banks_[0] && meta_banks_[1];
+  }
+
+  // Entries to write per service() call.
+  static constexpr size_t DRAIN_CHUNK = 256;
+
+  // Write the next chunk of an asynchronous dump, sized to what the serial
+  // port can accept without blocking.
+  void service_dump() {
+    if (!dump_header_sent_) {
+      write_trace_header(TraceKind::CycleStates, sizeof(CycleState), cycle_state_fields());
+      uint32_t count = dump_count_;
+      TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&count), sizeof(count));
+      size_t size = dump_count_ * sizeof(CycleState);
+      TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&size), sizeof(size));
+      dump_header_sent_ = true;
+    }
+
+    int avail = TRACE_SERIAL.availableForWrite();
+    if (avail < (int)sizeof(CycleState)) return;
+
+    size_t remain = dump_count_ - dump_pos_;
+    size_t chunk = (size_t)avail / sizeof(CycleState);
+    if (chunk > DRAIN_CHUNK) chunk = DRAIN_CHUNK;
+    if (chunk > remain) chunk = remain;
+
+    TRACE_SERIAL.write(
+      reinterpret_cast<const uint8_t*>(banks_[active_bank_] + dump_pos_),
+      chunk * sizeof(CycleState));
+    dump_pos_ += chunk;
+
+    if (dump_pos_ == dump_count_) {
+      dump_pending_ = false;
+    }
+  }
+
+  void write_entries(const CycleState* entries, uint32_t count) {
+    TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&count), sizeof(count));
+    TRACE_SERIAL.write(reinterpret_cast<const uint8_t*>(entries), count * sizeof(CycleState));
+  }
+
+  CycleState* banks_[CYCLE_STATE_BANKS] = { nullptr };
+  CycleTraceMeta* meta_banks_[CYCLE_STATE_BANKS] = { nullptr };
   size_t      next_;
   bool        wrapped_;
+  uint32_t    seq_ = 0; // Shared trace sequence at the last logged entry; read cursor base
+
   bool        enabled_ = true; // Enable/disable logging
-};
\ No newline at end of file
+  bool        streaming_ = false;
+  size_t      active_bank_ = 0;
+  size_t      pending_bank_ = 0;
+  bool        pending_drain_ = false;
+  size_t      drain_pos_ = 0;
+  uint32_t    dropped_banks_ = 0;
+  bool        dump_pending_ = false;
+  bool        dump_header_sent_ = false;
+  size_t      dump_pos_ = 0;
+  uint32_t    dump_count_ = 0;
+};
@@ -51,6 +51,21 @@ enum class DebugType : uint32_t {
     EMIT       = 1u << 23  // DEBUG_EMIT
 };
 
+// Compile-time debug mask. Categories cleared here compile to nothing: the
+// check below is constexpr and constant-folds at every call site, so the
+// print call, its formatting, and its argument evaluation are all dead code
+// the optimizer removes. Dedicated "farm" builds can strip the trace
+// categories from the cycle path by overriding the mask in platformio.ini,
+// e.g. -DDEBUG_COMPILED_MASK=0x3 to keep only WARNING and ERROR. Runtime
+// filtering via DebugFilter still applies to whatever remains compiled in.
+#ifndef DEBUG_COMPILED_MASK
+#define DEBUG_COMPILED_MASK 0xFFFFFFFFu
+#endif
+
+constexpr bool debug_type_compiled(DebugType debug_type) {
+  return (static_cast<uint32_t>(DEBUG_COMPILED_MASK) & static_cast<uint32_t>(debug_type)) != 0;
+}
+
 class DebugFilter {
   uint32_t enabledTypes = 1u; // All disabled by default except ERROR
 
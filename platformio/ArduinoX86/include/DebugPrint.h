@@ -83,10 +83,20 @@ public:
     filter.setTypeEnabled(stage, enabled);
   }
 
-  void debugPrintf(DebugType stage, bool defer, const char* fmt, ...);
+  // Formatted print. The wrapper checks the compile-time mask before
+  // forwarding to the out-of-line vsnprintf implementation, so call sites for
+  // stripped categories compile to nothing, arguments included.
+  template<typename... Args>
+  inline void debugPrintf(DebugType stage, bool defer, const char* fmt, Args... args) {
+    if (!debug_type_compiled(stage)) return;
+    debugPrintfImpl(stage, defer, fmt, args...);
+  }
+
+  void debugPrintfImpl(DebugType stage, bool defer, const char* fmt, ...);
 
   // String overload
   inline void debugPrint(DebugType stage, const char* text, bool defer = false) {
+    if (!debug_type_compiled(stage)) return;
     if (!serial || !filter.isEnabled(stage) || !enabled_) return;
 
     if (defer) {
@@ -105,6 +115,7 @@ public:
   // Generic value overload
   template<typename T>
   inline void debugPrint(DebugType stage, T value, bool defer = false) {
+    if (!debug_type_compiled(stage)) return;
     if (!serial || !filter.isEnabled(stage) || !enabled_) return;
 
     if(defer) {
@@ -124,6 +135,7 @@ public:
   
   template<typename T>
   inline void debugPrint(DebugType stage, T value, int base, bool defer = false) {
+    if (!debug_type_compiled(stage)) return;
     if (!serial || !filter.isEnabled(stage) || !enabled_) return;
     if(defer) {
       // Must convert base
@@ -146,6 +158,7 @@ public:
 
   // String overload
   inline void debugPrintln(DebugType stage, const char* text, bool defer = false) {
+    if (!debug_type_compiled(stage)) return;
     if (!serial || !filter.isEnabled(stage) || !enabled_) return;
 
     if (defer) {
@@ -163,6 +176,7 @@ public:
   // Generic value overload
   template<typename T>
   inline void debugPrintln(DebugType stage, T value, bool defer = false) {
+    if (!debug_type_compiled(stage)) return;
     if (!serial || !filter.isEnabled(stage) || !enabled_) return;
 
     if (defer) {
@@ -182,6 +196,7 @@ public:
   // Generic value with base
   template<typename T>
   inline void debugPrintln(DebugType stage, T value, int base, bool defer = false) {
+    if (!debug_type_compiled(stage)) return;
     if (!serial || !filter.isEnabled(stage) || !enabled_) return;
 
     if (defer) {
@@ -203,6 +218,7 @@ public:
 
   // Println with no arguments, just newline with color
   inline void debugPrintln(DebugType stage, bool defer = false) {
+    if (!debug_type_compiled(stage)) return;
     if (!serial || !filter.isEnabled(stage) || !enabled_) return;
 
     if (defer) {
@@ -0,0 +1,124 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Non-blocking debug output front end. A synchronous DEBUG_SERIAL print can
+// stall the cycle loop mid-bus-cycle when the port's TX buffer fills — a
+// burst of BusLogger output has been seen to perturb READY timing on the 286
+// shield. DebugRingSerial stages all bytes in a lock-free ring and never
+// blocks the caller: when the ring is full, bytes are dropped and counted
+// instead of waiting. service(), called from loop(), drains the ring bounded
+// by what the hardware port can accept without blocking; the interrupt-driven
+// core UART driver takes it from there.
+
+#pragma once
+
+#include <Arduino.h>
+#include <SpscRing.h>
+
+#if defined(ARDUINO_GIGA)
+#define DEBUG_RING_SIZE 8192
+#else
+#define DEBUG_RING_SIZE 1024
+#endif
+
+template<typename SerialPort>
+class DebugRingSerial : public Print {
+public:
+  explicit DebugRingSerial(SerialPort& s) : serial_(s) {
+    ring_.reset();
+  }
+
+  size_t write(uint8_t b) override {
+    if (!ring_.write(b)) {
+      dropped_++;
+      return 0;
+    }
+    return 1;
+  }
+
+  size_t write(const uint8_t *buffer, size_t size) override {
+    uint32_t written = ring_.write(buffer, static_cast<uint32_t>(size));
+    dropped_ += static_cast<uint32_t>(size) - written;
+    return written;
+  }
+
+  using Print::write;
+
+  int availableForWrite() {
+    return static_cast<int>(ring_.free_space());
+  }
+
+  // Drain staged bytes to the hardware port, bounded by the room in its TX
+  // buffer so this never blocks. Call from loop().
+  void service() {
+    int room = serial_.availableForWrite();
+    while (room > 0) {
+      int b = ring_.read();
+      if (b < 0) break;
+      serial_.write(static_cast<uint8_t>(b));
+      room--;
+    }
+    // Once the backlog has cleared, note how much was lost to overflow.
+    if ((dropped_ > 0) && (ring_.available() == 0)) {
+      char buf[48];
+      snprintf(buf, sizeof(buf), "## DEBUG: dropped %lu bytes ##\n\r",
+        static_cast<unsigned long>(dropped_));
+      if (serial_.availableForWrite() >= static_cast<int>(strlen(buf))) {
+        serial_.print(buf);
+        dropped_ = 0;
+      }
+    }
+  }
+
+  // Number of bytes dropped because the ring was full.
+  uint32_t dropped() const {
+    return dropped_;
+  }
+
+  // Blocking drain of ring and hardware buffer. For setup/shutdown paths
+  // only; never call from the cycle loop.
+  void flush() {
+    int b;
+    while ((b = ring_.read()) >= 0) {
+      serial_.write(static_cast<uint8_t>(b));
+    }
+    serial_.flush();
+  }
+
+  operator bool() {
+    return static_cast<bool>(serial_);
+  }
+
+private:
+  SerialPort& serial_;
+  SpscRing<DEBUG_RING_SIZE> ring_;
+  uint32_t dropped_ = 0;
+};
+
+// One instance per board, wrapping the hardware debug port. DEBUG_SERIAL in
+// serial_config.h resolves to this; the definition lives in globals.cpp.
+#if defined(__SAM3X8E__)
+extern DebugRingSerial<decltype(Serial1)> DebugRing;
+#elif defined(ARDUINO_GIGA) && !defined(CORE_CM4)
+extern DebugRingSerial<decltype(Serial2)> DebugRing;
+#endif
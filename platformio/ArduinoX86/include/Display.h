@@ -30,6 +30,10 @@ public:
   virtual void init() {}
   virtual int rows() const { return 0; }
   virtual void updateCell(int line, int col, uint16_t color, const char* text) {}
+  // Repaint any cells whose contents changed since the last pass, within a
+  // small time budget. Called once per main loop; a no-op when nothing is
+  // dirty (or for headless builds).
+  virtual void service() {}
   virtual uint16_t makeColor(uint8_t r, uint8_t g, uint8_t b) {
     return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
   }
@@ -0,0 +1,130 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Dual-core protocol front end for the Giga's STM32H747 (USE_DUAL_CORE).
+//
+// The Cortex-M4 owns serial framing and command parsing; the M7 owns the
+// cycle engine. The cores communicate over lock-free SPSC rings in SRAM4,
+// which both cores can reach without FMC init and which the M4 never caches.
+// (SDRAM would also be shared, but the M7's data cache over it would need
+// maintenance on every ring access; dual_core_init() instead just marks
+// SRAM4 non-cacheable with a spare MPU region.)
+//
+//   usb_rx:       M7 -> M4. Raw bytes pumped from INBAND_SERIAL. The M7 never
+//                 parses them; dual_core_pump() is a bounded copy.
+//   cmd_ring:     M4 -> M7. Framed commands: [cmd u8][len u8][len param bytes].
+//                 A len of DC_FRAME_TIMEOUT marks a parameter timeout on the
+//                 M4, standing in for the single-core timeout path.
+//   payload_ring: M4 -> M7. Raw passthrough of streamed payload bytes for
+//                 commands where server_command_streams_payload() is true.
+//
+// Responses go straight from the M7 out over USB; they need no parsing.
+// After each command the M7 bumps cmd_done_seq, which releases the M4 from
+// payload passthrough back to framing.
+
+#pragma once
+
+#include <config.h>
+
+#if USE_DUAL_CORE && (defined(ARDUINO_GIGA) || defined(CORE_CM4))
+
+#include <Arduino.h>
+#include <string.h>
+#include <serial_config.h>
+#include <SpscRing.h>
+
+// Base of SRAM4 (D3 domain SRAM, 64KB). We don't use the RPC/OpenAMP stack,
+// so the whole bank is ours.
+#define DC_SHM_BASE 0x38000000ul
+#define DC_SHM_MAGIC 0x58383641ul // 'A86X'
+
+// Sentinel in a frame's length byte: the M4 timed out collecting parameters.
+#define DC_FRAME_TIMEOUT 0xFF
+
+typedef struct DualCoreShm {
+  volatile uint32_t magic;        // DC_SHM_MAGIC once the M7 has initialized the block.
+  volatile uint32_t m4_ready;     // Set by the M4 once it is framing commands.
+  volatile uint32_t m4_heartbeat; // Incremented every M4 loop() pass.
+  volatile uint32_t cmd_done_seq; // Incremented by the M7 after each command completes.
+  SpscRing<4096> usb_rx;
+  SpscRing<1024> cmd_ring;
+  SpscRing<4096> payload_ring;
+} DualCoreShm;
+
+static_assert(sizeof(DualCoreShm) <= 0x10000, "DualCoreShm must fit in SRAM4");
+
+inline DualCoreShm *dual_core_shm() {
+  return reinterpret_cast<DualCoreShm *>(DC_SHM_BASE);
+}
+
+#if defined(CORE_CM7)
+
+/// @brief Move pending USB bytes into the raw rx ring for the M4 to frame.
+/// Bounded by ring space and the USB FIFO, so it never blocks.
+inline void dual_core_pump() {
+  DualCoreShm *shm = dual_core_shm();
+  while (shm->usb_rx.free_space() > 0 && INBAND_SERIAL.available() > 0) {
+    int b = INBAND_SERIAL.read();
+    if (b < 0) {
+      break;
+    }
+    shm->usb_rx.write((uint8_t)b);
+  }
+}
+
+/// @brief Initialize the shared-memory rings and boot the M4 front end.
+/// The M4 image (env:giga_r1_m4) must be flashed to the second flash bank.
+/// @return true if the M4 came up and acknowledged the handshake.
+inline bool dual_core_init() {
+  // SRAM4 must be non-cacheable from the M7, or ring indices written by the
+  // M4 would be masked by stale cache lines. The M4 has no data cache. Use a
+  // spare high-numbered MPU region so we don't clobber mbed's own regions.
+  ARM_MPU_Disable();
+  MPU->RNR = 15;
+  MPU->RBAR = DC_SHM_BASE;
+  // Normal memory, shareable, non-cacheable (TEX=1, C=0, B=0).
+  MPU->RASR = ARM_MPU_RASR(0, ARM_MPU_AP_FULL, 1, 1, 0, 0, 0, ARM_MPU_REGION_SIZE_64KB);
+  ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+  // Evict any lines cached before the region change took effect.
+  SCB_CleanInvalidateDCache();
+
+  DualCoreShm *shm = dual_core_shm();
+  memset((void *)shm, 0, sizeof(DualCoreShm));
+  __DMB();
+  shm->magic = DC_SHM_MAGIC;
+  __DMB();
+
+  // Release the M4 from reset (what LL_RCC_ForceCM4Boot() does). The Giga's
+  // option bytes leave the M4 parked at power-on until the M7 sets this bit.
+  RCC->GCR |= RCC_GCR_BOOT_C2;
+
+  unsigned long start = millis();
+  while (shm->m4_ready == 0 && (millis() - start) < 500) {
+    // Wait for the M4 to come up; it only has to zero its bss and signal us.
+  }
+  return shm->m4_ready != 0;
+}
+
+#endif // CORE_CM7
+
+#endif // USE_DUAL_CORE && (ARDUINO_GIGA || CORE_CM4)
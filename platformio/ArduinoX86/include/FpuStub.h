@@ -0,0 +1,67 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// On-device 8087 BUSY handshake stub on the TEST pin.
+//
+// A WAIT instruction spins until the TEST input goes active, which on a real
+// board is the 8087's BUSY output; without a coprocessor in the socket,
+// WAIT/ESC timing tests need the host to puppeteer the TEST pin through
+// CmdWritePin, which is slow enough that suite generation skips these
+// opcodes. The stub emulates the handshake from the cycle engine: when an
+// ESC opcode (0xD8-0xDF) is read from the instruction queue as a first
+// byte, the TEST pin is driven to its busy level for a programmed number of
+// cycles, then released - so a following WAIT observes a realistic busy
+// window in fully automatic execution.
+//
+// The busy level is configurable because shields may route TEST through an
+// inverter: in busy-high mode the pin is driven 1 for the window and 0 when
+// idle, busy-low is the mirror. Enabling the stub immediately drives the
+// idle level so a WAIT with no preceding ESC completes.
+
+// Nonzero while the stub is enabled; lets cycle() skip the service call on
+// the hot path when unconfigured.
+extern uint8_t fpu_stub_enabled;
+
+/// @brief Configure the stub. Mode 0 disables (releasing the pin to host
+/// control), 1 enables with busy = high, 2 enables with busy = low.
+/// `busy_cycles` is the length of the BUSY window an ESC fetch starts.
+/// Returns false for a bad mode or a zero window with a non-zero mode.
+bool fpu_stub_config(uint8_t mode, uint32_t busy_cycles);
+
+/// @brief Begin (or restart) the BUSY window. Called from the queue prologue
+/// when a first-byte ESC opcode is observed.
+void fpu_stub_on_esc();
+
+/// @brief Count the BUSY window down one cycle and release the TEST pin to
+/// the idle level at expiry. Called once per CPU clock from cycle(), gated
+/// on fpu_stub_enabled.
+void fpu_stub_service();
+
+/// @brief Abandon any running window and drive the idle level, keeping the
+/// configuration. Called on CPU reset so a stale window can't leak into the
+/// next run.
+void fpu_stub_reset();
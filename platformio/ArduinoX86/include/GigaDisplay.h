@@ -43,10 +43,24 @@ private:
   static constexpr uint16_t gray33 = 0x630c; // 33% gray in RGB565 format
   static constexpr uint16_t gray25 = 0x4208; // 25% gray in RGB565 format
 
+  // Cell cache for dirty-region repaints. updateCell() only stores new text
+  // into the cache; service() repaints dirty cells on a time budget so a
+  // frame update can never stall the command loop for a whole panel redraw.
+  static constexpr size_t maxCellRows = 8;
+  static constexpr size_t cellTextLen = 15;
+  static constexpr unsigned long serviceBudgetUs = 2000;
+
+  struct Cell {
+    char text[cellTextLen + 1];
+    uint16_t color;
+    bool dirty;
+  };
+
   GigaDisplay_GFX &display;
   Vga *vga_;
   bool _isInitialized = false;
   int _rows;
+  Cell cells_[maxCellRows][cols] = {};
 
   unsigned long lastFpsTime = 0;
   int framesDrawn = 0;
@@ -66,6 +80,26 @@ private:
     display.drawFastVLine(x * 2 + 1, y * 2, h * 2, color);
   }
 
+  // Actually repaint one cell from the cache. Only service() calls this.
+  void paintCell(int line, int col) {
+    const Cell &cell = cells_[line][col];
+    int cellHeight = textSize * 8 + verticalPadding;
+    int cellWidth = display.width() / cols;
+
+    int x = col * cellWidth;
+    int y = topMargin + line * cellHeight;
+
+    display.fillRect(x, y, cellWidth, cellHeight, display.color565(0, 0, 0));
+    int textWidth = 6 * strlen(cell.text) * textSize;
+    int cursorX = x + (cellWidth - textWidth) / 2;
+    int cursorY = y + (cellHeight - textSize * 8) / 2;
+
+    display.setCursor(cursorX, cursorY);
+    display.setTextSize(textSize);
+    display.setTextColor(cell.color);
+    display.print(cell.text);
+  }
+
 public:
   GigaDisplay(GigaDisplay_GFX& ref) : display(ref) {
     //vga_ = new Vga();
@@ -84,6 +118,16 @@ public:
     _isInitialized = true;
     //updateCell(0, 0, display.color565(255, 255, 255), "Initialized");
     drawFrame(8, 8, 384, 224, white, gray33);
+
+    // A re-init (reset_screen()) wipes the panel, so mark any cached cell
+    // contents dirty to repaint over the next service() passes.
+    for (size_t line = 0; line < maxCellRows; line++) {
+      for (size_t col = 0; col < cols; col++) {
+        if (cells_[line][col].text[0] != '\0') {
+          cells_[line][col].dirty = true;
+        }
+      }
+    }
   }
 
   int rows() const override {
@@ -108,29 +152,40 @@ public:
     display.fillRect((x * 2) + 2, (y * 2) + 2, (width * 2) - 4, (height * 2) - 4, fillColor);
   }
 
+  // Stage a cell update. Nothing is painted here: if the text and color
+  // match what is already on screen the call is a compare and return, and
+  // otherwise the cell is marked dirty for the next service() pass.
   void updateCell(int line, int col, uint16_t color, const char* text) override {
-    return;
-    if (!_isInitialized) { return; }
-    //DEBUG_SERIAL.println("in updateCell()...");
-    int cellHeight = textSize * 8 + verticalPadding;
-    int cellWidth = display.width() / cols;
-
-    int x = col * cellWidth;
-    int y = topMargin + line * cellHeight;
-
-    display.fillRect(x, y, cellWidth, cellHeight, display.color565(0, 0, 0));
-    int textWidth = 6 * strlen(text) * textSize;
-    int cursorX = x + (cellWidth - textWidth) / 2;
-    int cursorY = y + (cellHeight - textSize * 8) / 2;
+    if (line < 0 || line >= (int)maxCellRows || col < 0 || col >= (int)cols) {
+      return;
+    }
+    Cell &cell = cells_[line][col];
+    if ((cell.color == color) && (strncmp(cell.text, text, cellTextLen) == 0)) {
+      return; // Unchanged, leave the screen alone.
+    }
+    strncpy(cell.text, text, cellTextLen);
+    cell.text[cellTextLen] = '\0';
+    cell.color = color;
+    cell.dirty = true;
+  }
 
-    // DEBUG_SERIAL.println("print() with text: " + String(text) + 
-    //                     ", cursorX: " + String(cursorX) + 
-    //                     ", cursorY: " + String(cursorY));
-    display.setCursor(cursorX, cursorY);
-    display.setTextSize(textSize);
-    display.setTextColor(color);
-    display.print(text);
-    //display.flush();
+  // Repaint dirty cells, stopping once the per-pass budget is spent. Cells
+  // that miss the budget stay dirty and paint on a later pass.
+  void service() override {
+    if (!_isInitialized) { return; }
+    unsigned long start_us = micros();
+    for (size_t line = 0; line < maxCellRows; line++) {
+      for (size_t col = 0; col < cols; col++) {
+        if (!cells_[line][col].dirty) {
+          continue;
+        }
+        paintCell(line, col);
+        cells_[line][col].dirty = false;
+        if ((micros() - start_us) >= serviceBudgetUs) {
+          return;
+        }
+      }
+    }
   }
 
   uint16_t makeColor(uint8_t r, uint8_t g, uint8_t b) override {
@@ -165,6 +165,10 @@ public:
     program_[offset + 1] = (data >> 8) & 0xFF;
   }
 
+  /// @brief Raw access to the program bytes for table-driven patching.
+  /// Callers validate their offsets against len() once, up front.
+  uint8_t *data() { return program_.data(); }
+
   size_t len() const { return len_; }
   size_t remaining() const { return (pc_ < len_) ? (len_ - pc_) : 0; }
   bool has_remaining() const { return pc_ < len_; }
@@ -0,0 +1,64 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Cycle-scheduled pin injection for interrupt delivery timing tests.
+//
+// Measuring interrupt latency requires asserting INTR or NMI at an exact
+// cycle relative to an instruction, which over the wire means single-stepping
+// to the target cycle and issuing CmdWritePin - thousands of round trips per
+// data point. An injection slot programmed via CmdSetPinInject instead
+// asserts its pin from the cycle engine at the exact Cpu::cycle_ct() tick,
+// and deasserts it at a second tick, during automatic execution. Cycle counts
+// are relative to the last CPU reset, like the counts in test results.
+//
+// Slots are one-shot: a slot disarms after its deassert fires (or after the
+// assert, when no deassert is programmed), so a stale window cannot re-fire
+// on a later run. Injection only operates on the software-clocked path;
+// free-run turbo mode never sees per-cycle servicing.
+
+// Number of independently programmable injection slots.
+static const size_t PIN_INJECT_SLOTS = 4;
+
+// Nonzero while any slot is armed; lets cycle() skip the service call on the
+// hot path when no injection is programmed.
+extern uint8_t pin_inject_armed;
+
+/// @brief Program an injection slot. `pin` indexes the CmdWritePin pin set
+/// (0=READY, 1=TEST, 2=INTR, 3=NMI). The pin is driven high when cycle_ct
+/// reaches `assert_cycle` and low again at `deassert_cycle`; a deassert of 0
+/// asserts only, leaving the pin for the host to clear. Returns false for a
+/// bad slot, pin, or window (deassert at or before assert).
+bool pin_inject_program(uint8_t slot, uint8_t pin, uint32_t assert_cycle, uint32_t deassert_cycle);
+
+/// @brief Disarm all slots, deasserting any pin an active injection is
+/// currently driving.
+void pin_inject_clear();
+
+/// @brief Fire any injections due at `cycle`. Called once per CPU clock from
+/// cycle(), gated on pin_inject_armed.
+void pin_inject_service(uint64_t cycle);
@@ -0,0 +1,61 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// Hardware-timed READY deassert window for wait-state injection (Giga only).
+//
+// In free-run turbo mode the ALE interrupt deasserts READY and the main loop
+// re-asserts it once the frozen bus cycle has been serviced, so the number of
+// wait states the CPU sees depends on whatever the firmware happened to be
+// doing. With a window programmed via CmdSetReadyTimer, the re-assert is
+// instead produced by a one-shot hardware timer (TIM16) started from the ALE
+// interrupt: the deassert duration is exact in timer ticks regardless of
+// service time, as long as the window is long enough to cover it. Servicing
+// that overruns the window releases immediately, clamping at the minimum.
+//
+// Ticks count at the TIM16 kernel clock (240 MHz on the stock Giga clock
+// tree); ready_timer_hz() reports the rate so the host can convert.
+
+/// @brief Program the READY deassert window in timer ticks. 0 disables the
+/// timer and returns the release to software. Initializes the timer on first
+/// use. Returns false where no hardware timer is wired up.
+bool ready_timer_program(uint32_t ticks);
+
+/// @brief The programmed window, in ticks (0 = disabled).
+uint32_t ready_timer_ticks();
+
+/// @brief The timer tick rate in Hz, for host-side conversion.
+uint32_t ready_timer_hz();
+
+/// @brief Start the one-shot window. Called from the ALE interrupt right
+/// after READY is deasserted; no-op when no window is programmed.
+void ready_timer_start();
+
+/// @brief Hand the READY release to the timer once the frozen cycle has been
+/// serviced: re-asserts immediately if the window already elapsed, otherwise
+/// arms the timer interrupt to re-assert exactly at expiry. Returns false if
+/// the timer isn't running (caller releases READY itself, as before).
+bool ready_timer_release();
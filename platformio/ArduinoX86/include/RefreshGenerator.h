@@ -0,0 +1,73 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// Periodic DRAM-refresh HOLD generator.
+//
+// Real PCs steal the bus for an 8237 refresh DMA cycle every ~15 us, and
+// refresh timing interacts with instruction timing in ways emulators must
+// reproduce. The generator emulates the cadence from the cycle engine: every
+// `period` target-CPU cycles it asserts HOLD for `duration` cycles, then
+// releases it and restarts the count, so refresh-aware timing suites run in
+// fully automatic execution.
+//
+// HLDA is not routed to a readable GPIO on any current shield, so the grant
+// is observed indirectly: cycles where the bus sits passive while HOLD is
+// asserted count as granted. Every cycle spent with HOLD asserted is tagged
+// CycleState::HOLD in the cycle log, so host tooling can line stolen cycles
+// up against instruction boundaries. HOLD itself is only wired on shields
+// that route it (see writePinImpl); elsewhere the generator tags cycles but
+// the CPU never sees the request.
+
+// Nonzero while a refresh cadence is programmed; lets cycle() skip the
+// service call on the hot path. Bit 1 is set while HOLD is asserted.
+extern uint8_t refresh_gen_state;
+
+// refresh_gen_state bits.
+static const uint8_t REFRESH_GEN_ENABLED = 0x01;
+static const uint8_t REFRESH_GEN_HOLDING = 0x02;
+
+/// @brief Program the refresh cadence: assert HOLD for `duration` cycles
+/// every `period` cycles. A period of 0 disables the generator, releasing
+/// HOLD if currently asserted. Returns false when duration is 0 or not less
+/// than the period.
+bool refresh_gen_program(uint32_t period, uint32_t duration);
+
+/// @brief Advance the cadence one cycle: assert HOLD at each period expiry,
+/// release it after the programmed duration, and count granted (bus passive)
+/// cycles. Called once per CPU clock from cycle(), gated on
+/// refresh_gen_state.
+void refresh_gen_service();
+
+/// @brief Restart the cadence from a full period and release any asserted
+/// HOLD, keeping the configuration. Called on CPU reset.
+void refresh_gen_reset();
+
+/// @brief HOLD windows started since the generator was (re)programmed.
+uint32_t refresh_gen_count();
+
+/// @brief Cycles spent with HOLD asserted and the bus observed passive.
+uint32_t refresh_gen_granted_cycles();
@@ -0,0 +1,123 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/// @brief Lock-free single-producer, single-consumer byte ring.
+/// The indices are free-running and wrapped with a power-of-two mask, so the
+/// full capacity is usable and empty never aliases full. With exactly one
+/// writer and one reader no atomics are needed; aligned 32-bit index updates
+/// are single-copy atomic on Cortex-M, and the data memory barriers order the
+/// buffer contents against index publication. Safe for cross-core use on the
+/// STM32H747 as long as the backing memory is not cached by either core.
+template <uint32_t SIZE>
+struct SpscRing {
+  static_assert((SIZE & (SIZE - 1)) == 0, "SpscRing size must be a power of two");
+
+  volatile uint32_t head_; // Write index. Owned by the producer.
+  volatile uint32_t tail_; // Read index. Owned by the consumer.
+  uint8_t buf_[SIZE];
+
+  void reset() {
+    head_ = 0;
+    tail_ = 0;
+  }
+
+  uint32_t available() const {
+    return head_ - tail_;
+  }
+
+  uint32_t free_space() const {
+    return SIZE - available();
+  }
+
+  /// @brief Write a single byte. Returns false if the ring is full.
+  bool write(uint8_t b) {
+    if (free_space() == 0) {
+      return false;
+    }
+    uint32_t head = head_;
+    buf_[head & (SIZE - 1)] = b;
+    __DMB();
+    head_ = head + 1;
+    return true;
+  }
+
+  /// @brief Write up to `len` bytes. Returns the number of bytes accepted.
+  uint32_t write(const uint8_t *src, uint32_t len) {
+    uint32_t n = free_space();
+    if (len < n) {
+      n = len;
+    }
+    uint32_t head = head_;
+    for (uint32_t i = 0; i < n; i++) {
+      buf_[(head + i) & (SIZE - 1)] = src[i];
+    }
+    __DMB();
+    head_ = head + n;
+    return n;
+  }
+
+  /// @brief Read a single byte, or -1 if the ring is empty.
+  int read() {
+    if (available() == 0) {
+      return -1;
+    }
+    uint32_t tail = tail_;
+    uint8_t b = buf_[tail & (SIZE - 1)];
+    __DMB();
+    tail_ = tail + 1;
+    return b;
+  }
+
+  /// @brief Read up to `len` bytes. Returns the number of bytes copied.
+  uint32_t read(uint8_t *dst, uint32_t len) {
+    uint32_t n = available();
+    if (len < n) {
+      n = len;
+    }
+    uint32_t tail = tail_;
+    for (uint32_t i = 0; i < n; i++) {
+      dst[i] = buf_[(tail + i) & (SIZE - 1)];
+    }
+    __DMB();
+    tail_ = tail + n;
+    return n;
+  }
+
+  /// @brief Peek at a byte without consuming it. Only valid for
+  /// offset < available().
+  uint8_t peek(uint32_t offset) const {
+    return buf_[(tail_ + offset) & (SIZE - 1)];
+  }
+
+  /// @brief Discard `len` bytes without copying them. Only valid for
+  /// len <= available().
+  void skip(uint32_t len) {
+    __DMB();
+    tail_ = tail_ + len;
+  }
+};
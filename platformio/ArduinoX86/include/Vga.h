@@ -24,6 +24,7 @@
 
 #include <Arduino.h>
 #include "SDRAM.h"
+#include "SdramInit.h"
 
 class Vga {
   private:
@@ -66,16 +67,97 @@ class Vga {
     };
 
     uint16_t *buffer_;
-  
+    bool dma2d_ready_ = false;
+
+#if defined(ARDUINO_GIGA)
+    // Chrom-ART (DMA2D) render path. The engine does the L8 -> RGB565
+    // conversion through its CLUT in hardware, so a frame conversion is a
+    // register setup and a start bit instead of a 64000-pixel CPU loop, and
+    // it runs while the M7 keeps driving the cycle engine.
+    void dma2d_init() {
+      // Bring up the DMA2D clock.
+      RCC->AHB3ENR |= RCC_AHB3ENR_DMA2DEN;
+      (void)RCC->AHB3ENR; // Read back to settle the clock enable.
+
+      // Expand the RGB565 palette into the ARGB8888 CLUT format and load it.
+      // The load copies into the DMA2D's internal CLUT RAM, so the staging
+      // array is only needed for the duration of the (synchronous) load.
+      static uint32_t clut[256];
+      for (int i = 0; i < 256; i++) {
+        uint16_t c = default_palette_[i];
+        uint32_t r = (c >> 11) & 0x1F;
+        uint32_t g = (c >> 5) & 0x3F;
+        uint32_t b = c & 0x1F;
+        clut[i] = 0xFF000000ul
+                | (((r << 3) | (r >> 2)) << 16)
+                | (((g << 2) | (g >> 4)) << 8)
+                | ((b << 3) | (b >> 2));
+      }
+      SCB_CleanDCache_by_Addr(reinterpret_cast<uint32_t*>(clut), sizeof(clut));
+      DMA2D->FGCMAR = reinterpret_cast<uint32_t>(clut);
+      DMA2D->FGPFCCR = (255ul << DMA2D_FGPFCCR_CS_Pos); // 256-entry ARGB8888 CLUT
+      DMA2D->FGPFCCR |= DMA2D_FGPFCCR_START;
+      while (DMA2D->FGPFCCR & DMA2D_FGPFCCR_START)
+        ;
+      dma2d_ready_ = true;
+    }
+#endif
+
   public:
     Vga() {
+      ensure_sdram();
       buffer_ = reinterpret_cast<uint16_t*>(SDRAM.malloc(W * H * 2));
+#if defined(ARDUINO_GIGA)
+      dma2d_init();
+#endif
     }
     ~Vga() {
       SDRAM.free(buffer_);
     }
 
+#if defined(ARDUINO_GIGA)
+    /// @brief Kick off a DMA2D frame conversion and return immediately.
+    /// Call convert_finish() (or poll convert_busy()) before touching the
+    /// output buffer.
+    void convert_start(uint8_t *src) {
+      // The engine reads source pixels from memory, so anything the CPU
+      // just wrote must be flushed out of the D-cache first.
+      SCB_CleanDCache_by_Addr(reinterpret_cast<uint32_t*>(src), PIXELS);
+      DMA2D->CR = DMA2D_CR_MODE_0; // Memory-to-memory with pixel format conversion
+      DMA2D->FGMAR = reinterpret_cast<uint32_t>(src);
+      DMA2D->FGOR = 0;
+      DMA2D->FGPFCCR = (DMA2D->FGPFCCR & ~DMA2D_FGPFCCR_CM) | (5ul << DMA2D_FGPFCCR_CM_Pos); // L8 input
+      DMA2D->OMAR = reinterpret_cast<uint32_t>(buffer_);
+      DMA2D->OOR = 0;
+      DMA2D->OPFCCR = 2ul << DMA2D_OPFCCR_CM_Pos; // RGB565 output
+      DMA2D->NLR = (static_cast<uint32_t>(W) << DMA2D_NLR_PL_Pos) | H;
+      DMA2D->IFCR = DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF | DMA2D_IFCR_CCEIF;
+      DMA2D->CR |= DMA2D_CR_START;
+    }
+
+    /// @brief True while a DMA2D conversion is still in flight.
+    bool convert_busy() {
+      return (DMA2D->CR & DMA2D_CR_START) != 0;
+    }
+
+    /// @brief Wait out any in-flight conversion and make the output buffer
+    /// visible to the CPU.
+    void convert_finish() {
+      while (convert_busy())
+        ;
+      SCB_InvalidateDCache_by_Addr(reinterpret_cast<uint32_t*>(buffer_), PIXELS * 2);
+    }
+#endif
+
     void convert(uint8_t *src) {
+#if defined(ARDUINO_GIGA)
+      if (dma2d_ready_) {
+        convert_start(src);
+        convert_finish();
+        return;
+      }
+#endif
+      // Software fallback: per-pixel palette lookup.
       for (int i = 0; i < PIXELS; ++i) {
         uint8_t color_index = src[i];
         buffer_[i] = default_palette_[color_index];
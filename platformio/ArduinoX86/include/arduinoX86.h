@@ -64,6 +64,21 @@ typedef struct queue {
 #define QUEUE_FLUSHED 0x02
 #define QUEUE_SUBSEQUENT 0x03
 
+// Packed per-cycle queue actions, indexed by the QS0/QS1 status pair. The
+// status lines report what the queue did on the previous clock, so the
+// decode is a pure lookup; one indexed load replaces the cascaded compares
+// on the cycle path, where queue accounting is interleaved with the
+// timing-critical data-bus window.
+#define QA_POP   0x01 // A byte was read from the queue
+#define QA_FIRST 0x02 // ...and it was the first byte of an instruction
+#define QA_FLUSH 0x04 // The queue was flushed
+constexpr uint8_t QUEUE_ACTIONS[4] = {
+  0,                 // QUEUE_IDLE
+  QA_POP | QA_FIRST, // QUEUE_FIRST
+  QA_FLUSH,          // QUEUE_FLUSHED
+  QA_POP,            // QUEUE_SUBSEQUENT
+};
+
 // Strings for pretty-printing instruction queue status from QS0,QS1
 // '.' = Idle  
 // 'F' = First byte fetched 
@@ -171,6 +186,7 @@ void cycle();
 void set_error(const char *msg);
 void clear_error();
 bool cpu_id();
+bool cpu_id_set_generation(uint32_t generation);
 void patch_load_pgm(InlineProgram *pgm, volatile registers1_t *reg);
 void patch_brkem_pgm(InlineProgram *pgm, volatile registers1_t *regs);
 
@@ -193,6 +209,12 @@ void handle_store_state();
 void handle_execute_state();
 void handle_execute_automatic();
 void handle_execute_finalize_state();
+void handle_execute_done_state();
+void handle_emu_exit_state();
+bool free_run_state_ok();
+void update_free_run_clock();
+void dispatch_free_run_state();
+void service_free_run();
 void detect_fpu_type();
 void detect_cpu_type(uint32_t cpuid_cycles);
 void reset_screen();
@@ -224,6 +246,7 @@ uint32_t read_address_pins(bool peek);
 // buzzer.cpp
 void beep(uint32_t time);
 void error_beep();
+void buzzer_service();
 
 
 
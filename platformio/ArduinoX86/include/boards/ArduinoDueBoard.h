@@ -30,9 +30,9 @@
 #include "../DebugPrint.h"   // Debug print mixin
 #include "../shields/ShieldTraits.h" // Shield-specific traits
 template<typename Shield>
-class ArduinoDueBoard : public DebugPrintMixin<decltype(Serial1)> {
+class ArduinoDueBoard : public DebugPrintMixin<decltype(DebugRing)> {
 public:
-  ArduinoDueBoard() : DebugPrintMixin(Serial1) {}
+  ArduinoDueBoard() : DebugPrintMixin(DebugRing) {}
 
   void init() {
     // Initialize GPIO via the shield
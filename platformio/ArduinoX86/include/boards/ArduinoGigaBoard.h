@@ -25,6 +25,7 @@
 
 #include <Arduino.h>
 #include <SDRAM.h>
+#include <SdramInit.h>
 
 #include <config.h>
 #include <gpio_pins.h>
@@ -34,14 +35,17 @@
 #include "../shields/ShieldTraits.h"
 
 template<typename Shield>
-class ArduinoGigaBoard : public DebugPrintMixin<decltype(Serial2)> {
+class ArduinoGigaBoard : public DebugPrintMixin<decltype(DebugRing)> {
 public:
-  ArduinoGigaBoard() : DebugPrintMixin(Serial2) {}
+  ArduinoGigaBoard() : DebugPrintMixin(DebugRing) {}
 
   void init() {
 
-    // Initialize SDRAM
-    SDRAM.begin();
+    // Initialize SDRAM. Fast-boot builds defer this to the first allocation
+    // (see SdramInit.h) so the server accepts commands sooner.
+#if !FAST_BOOT
+    ensure_sdram();
+#endif
 
     // Initialize GPIO via the shield
     Shield::initPins();
@@ -28,6 +28,9 @@ template<typename Board>
 struct BoardTraits {
   static constexpr int _DBUS_01 = 0;
   static constexpr int _CLK_PIN = 0;
+  // Protocol transmit accumulator size. Response bytes are coalesced into
+  // buffers of this size before being handed to the USB CDC stack.
+  static constexpr unsigned _PROTO_TX_BUF = 64;
   // Add other default traits here
 };
 
@@ -43,6 +46,9 @@ template<typename Shield>
 struct BoardTraits<ArduinoDueBoard<Shield>> {
   static constexpr int _DBUS_01 = 23;
   static constexpr int _CLK_PIN = 4;
+  // The SAM3X native USB endpoint is 64 bytes; two packets per hand-off
+  // halves the per-call overhead without much RAM cost.
+  static constexpr unsigned _PROTO_TX_BUF = 128;
 };
 
 // Specialization for ArduinoGigaBoard
@@ -50,4 +56,7 @@ template<typename Shield>
 struct BoardTraits<ArduinoGigaBoard<Shield>> {
   static constexpr int _DBUS_01 = 23;
   static constexpr int _CLK_PIN = 4;
+  // The mbed CDC stack takes large writes cheaply; 512 bytes per hand-off
+  // keeps bulk dumps near link bandwidth instead of per-byte call cost.
+  static constexpr unsigned _PROTO_TX_BUF = 512;
 };
@@ -15,7 +15,7 @@
     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER   
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
     DEALINGS IN THE SOFTWARE.
@@ -28,6 +28,13 @@
 
 #include <memory>
 #include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <type_traits>
+
+#include <SdramInit.h>
+#include <TraceSeq.h>
+#include <TraceFormat.h>
 
 #include <Shield.h>
 #include <BusTypes.h>
@@ -48,28 +55,135 @@
 
 #define SMRAM_SIZE 512
 
-// Maximum number of bus operations to record
-static const size_t BUS_LOGGER_MAX_OPS = 256;
+// Default and maximum bus-operation ring capacity. On the Giga the ring
+// lives in SDRAM, so it can hold far more history than the 256 entries the
+// internal RAM ring was limited to; far-call and memory-trace analysis
+// routinely need more than that. The host can resize the ring at runtime
+// (CmdSetBusLogCapacity) up to the maximum.
+#if defined(ARDUINO_GIGA)
+static const size_t BUS_LOGGER_DEFAULT_OPS = 8192;
+static const size_t BUS_LOGGER_MAX_CAPACITY = 131072;
+#else
+static const size_t BUS_LOGGER_DEFAULT_OPS = 256;
+static const size_t BUS_LOGGER_MAX_CAPACITY = 512;
+#endif
+static const size_t BUS_LOGGER_MIN_CAPACITY = 16;
 
 static const uint32_t LOADALL_286_ADDRESS = 0x800;
 static const uint32_t SMRAM_END   = 0x040000;
 static const uint32_t SMRAM_START = 0x03FE00;
 
+// Page-attribute table for the bus emulator. Addresses are divided into 1KB
+// pages and the table records which pages overlap a special region, so the
+// hot read/write paths do a single table load instead of range-comparing
+// every access against windows that 99.9% of accesses never touch. Pages are
+// indexed modulo the table size; an aliased page merely takes the slow path,
+// where the exact range checks still decide.
+static const uint32_t PAGE_ATTR_SHIFT   = 10;
+static const uint32_t PAGE_ATTR_ENTRIES = 256;
+static const uint8_t  PAGE_ATTR_LOADALL286 = 0x01; // Overlaps the Loadall 286 shadow window
+static const uint8_t  PAGE_ATTR_SMRAM      = 0x02; // Overlaps the SMM dump window
+
+// Watchpoint facility. The host registers up to BUS_MAX_WATCHPOINTS
+// address-range/op-class predicates; each bus-level access tests one
+// precomputed class mask (the OR of every enabled watchpoint's classes)
+// before scanning the small table, so the hot path costs a single AND when
+// no watchpoint covers the access class. A hit latches the trigger index
+// and address, freezes the BusLogger ring so the operations around the
+// trigger survive, and pauses automatic execution until the host reads the
+// hit. This replaces whole-trace transfers with targeted captures.
+static const size_t BUS_MAX_WATCHPOINTS = 8;
+
+static const uint8_t WATCH_MEM_READ  = 0x01; // Memory reads, including code fetches
+static const uint8_t WATCH_MEM_WRITE = 0x02;
+static const uint8_t WATCH_IO_READ   = 0x04;
+static const uint8_t WATCH_IO_WRITE  = 0x08;
+
+struct Watchpoint {
+  uint32_t start;   // First address/port covered (inclusive)
+  uint32_t end;     // Last address/port covered (inclusive)
+  uint8_t  op_mask; // WATCH_* classes this watchpoint matches; 0 disables it
+};
+
+// I/O port handler registry. Every backend stubs port I/O (reads return
+// 0xFF, writes are discarded), so a test touching a port either reads
+// garbage or needs the host to mediate the transfer. The host can instead
+// bind up to BUS_MAX_PORT_HANDLERS port ranges to simple device behaviors;
+// io_read_bus and io_write_bus dispatch through a 256-entry page table
+// over the 64K port space, so an unhandled port costs one table load.
+// Handlers produce and consume bytes: a 16-bit transfer takes (or applies)
+// two successive bytes from the handler.
+static const size_t BUS_MAX_PORT_HANDLERS = 8;
+static const size_t PORT_HANDLER_SCRIPT_BYTES = 16;
+static const uint32_t PORT_PAGE_SHIFT = 8; // 256 ports per page table entry
+static const uint32_t PORT_PAGE_ENTRIES = 256;
+
+enum class PortHandlerKind : uint8_t {
+  None     = 0x00, // Slot unbound
+  Constant = 0x01, // Reads return `value`; writes are discarded
+  Latch    = 0x02, // Reads return `value`; writes replace it
+  Counter  = 0x03, // Reads return `value` and increment it; writes reload it
+  Script   = 0x04, // Reads serve `script` in order, wrapping; writes rewind it
+};
+
+struct PortHandler {
+  PortHandlerKind kind; // Behavior; None disables the slot
+  uint16_t start;       // First port covered (inclusive)
+  uint16_t end;         // Last port covered (inclusive)
+  uint8_t  value;       // Constant/Latch value, or the Counter state
+  uint8_t  script_len;  // Bytes of `script` in use
+  uint8_t  script_pos;  // Next script byte to serve
+  uint8_t  script[PORT_HANDLER_SCRIPT_BYTES];
+};
+
 // Structure representing a single bus operation
 struct BusOperation {
   BusOperationType op_type;
   ActiveBusWidth bus_width;
   uint32_t address;
   uint16_t data;
+  uint32_t seq; // Shared trace sequence (TraceSeq) when the op was logged
 };
 
 class BusLogger {
 public:
+  BusLogger() {
+    alloc_ring(BUS_LOGGER_DEFAULT_OPS);
+  }
+
+  /// @brief Resize the ring, discarding its contents. Returns false (and
+  /// keeps the old ring) if the requested capacity is out of range or the
+  /// allocation fails.
+  bool set_capacity(size_t capacity) {
+    if (capacity < BUS_LOGGER_MIN_CAPACITY || capacity > BUS_LOGGER_MAX_CAPACITY) {
+      return false;
+    }
+    BusOperation* old_ops = ops_;
+    ops_ = nullptr;
+    alloc_ring(capacity);
+    if (!ops_) {
+      // Allocation failed; keep the old ring rather than losing logging.
+      ops_ = old_ops;
+      return false;
+    }
+    #if defined(ARDUINO_GIGA)
+      SDRAM.free(old_ops);
+    #else
+      std::free(old_ops);
+    #endif
+    count_ = 0;
+    index_ = 0;
+    overflow_ = false;
+    return true;
+  }
+
+  size_t capacity() const { return capacity_; }
+
   void log(const BusOperation& op) {
-    if (!enabled_) return; // Ignore if logging is disabled
-    
+    if (!enabled_ || !ops_) return; // Ignore if logging is disabled
+
     if ((op.op_type == BusOperationType::MemWrite8) ||
-       (op.op_type == BusOperationType::MemWrite16)) 
+       (op.op_type == BusOperationType::MemWrite16))
     {
       consecutive_writes_++;
       if (consecutive_writes_ == 3) {
@@ -80,8 +194,11 @@ public:
       consecutive_writes_ = 0; // Reset on non-write operations
     }
     ops_[index_] = op;
-    index_ = (index_ + 1) % BUS_LOGGER_MAX_OPS;
-    if (count_ < BUS_LOGGER_MAX_OPS) {
+    // Stamp with the shared trace sequence so this operation can be matched
+    // against the cycle-state record logged on the same cycle.
+    ops_[index_].seq = ArduinoX86::TraceSeq;
+    index_ = (index_ + 1) % capacity_;
+    if (count_ < capacity_) {
         ++count_;
     } else {
         overflow_ = true;
@@ -91,12 +208,37 @@ public:
   // Returns the most recent entry when relative=0, previous when relative=1, etc.
   // If relative >= count(), behavior is undefined.
   BusOperation peek_back(size_t relative) const {
-    size_t idx = (index_ + BUS_LOGGER_MAX_OPS - 1 - relative) % BUS_LOGGER_MAX_OPS;
+    size_t idx = (index_ + capacity_ - 1 - relative) % capacity_;
     return ops_[idx];
   }
 
+  /// @brief Stream the ring to the host oldest-first, straight out of its
+  /// buffer: trace header (see TraceFormat.h), count (4 bytes), size in bytes
+  /// (4 bytes), then raw BusOperation records — in two contiguous spans when
+  /// the ring has wrapped.
+  void dump_ops() const {
+    TraceHeader header = make_trace_header(TraceKind::BusOps, sizeof(BusOperation), TRACE_FIELD_SEQ);
+    TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+    uint32_t count = static_cast<uint32_t>(ops_ ? count_ : 0);
+    TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&count), sizeof(count));
+    uint32_t size = count * sizeof(BusOperation);
+    TRACE_SERIAL.write(reinterpret_cast<uint8_t*>(&size), sizeof(size));
+    if (count == 0) {
+      return;
+    }
+    size_t start = (count_ < capacity_) ? 0 : index_;
+    if (start + count <= capacity_) {
+      TRACE_SERIAL.write(reinterpret_cast<const uint8_t*>(ops_ + start), size);
+    }
+    else {
+      size_t first = capacity_ - start;
+      TRACE_SERIAL.write(reinterpret_cast<const uint8_t*>(ops_ + start), first * sizeof(BusOperation));
+      TRACE_SERIAL.write(reinterpret_cast<const uint8_t*>(ops_), (count - first) * sizeof(BusOperation));
+    }
+  }
+
   CallStackFrame peek_call_frame() const {
-    size_t idx = (index_ + BUS_LOGGER_MAX_OPS - 1) % BUS_LOGGER_MAX_OPS;    
+    size_t idx = (index_ + capacity_ - 1) % capacity_;
     CallStackFrame frame = { 0 };
     if (idx < 2) {
       // Not enough data to form a valid frame
@@ -110,7 +252,7 @@ public:
       frame.cs = ops_[idx - 1].data; // Assuming previous data holds CS
       frame.flags = ops_[idx - 2].data; // Assuming two previous data holds IP
       return frame;
-    } 
+    }
     else {
       //DEBUG_SERIAL.println("## BusLogger: Using 8-bit bus width for call frame");
       // Eight-bit bus width, we need to combine two entries
@@ -125,10 +267,10 @@ public:
       return frame;
     }
   }
-  
+
   // Indicates whether buffer has wrapped at least once
   bool overflowed() const { return overflow_; }
-  // Number of valid entries (up to BUS_LOGGER_MAX_OPS)
+  // Number of valid entries (up to capacity())
   size_t count() const { return count_; }
   void enable() { enabled_ = true; }
   void disable() { enabled_ = false; }
@@ -145,7 +287,25 @@ public:
   const BusOperation* data() const { return ops_; }
 
 private:
-  BusOperation  ops_[BUS_LOGGER_MAX_OPS];
+  // The ring is large enough that it comes out of SDRAM on the Giga,
+  // matching the cycle-state banks.
+  void alloc_ring(size_t capacity) {
+    #if defined(ARDUINO_GIGA)
+      ensure_sdram();
+      ops_ = static_cast<BusOperation*>(SDRAM.malloc(sizeof(BusOperation) * capacity));
+    #else
+      ops_ = static_cast<BusOperation*>(std::malloc(sizeof(BusOperation) * capacity));
+    #endif
+    if (ops_) {
+      capacity_ = capacity;
+    }
+    else {
+      DEBUG_SERIAL.println("## BusLogger: Memory allocation failed!");
+    }
+  }
+
+  BusOperation* ops_ = nullptr;
+  size_t capacity_ = BUS_LOGGER_DEFAULT_OPS;
   size_t count_ = 0;
   size_t index_ = 0;
   bool   overflow_ = false;
@@ -153,76 +313,104 @@ private:
   int    consecutive_writes_ = 0; // For detecting far calls/exceptions
 };
 
-class BusEmulator {
+/// @brief Bus emulator templated on its backend type, mirroring how
+/// BoardController is templated on its board and shield. The backend is held
+/// by value so its accessors dispatch statically and inline into the cycle
+/// loop instead of going through the IBusBackend vtable on every transfer.
+template<typename Backend>
+class BusEmulatorT {
 public:
-  explicit BusEmulator(IBusBackend* backend)
-    : backend_(backend) {}
+  template<typename... Args>
+  explicit BusEmulatorT(Args&&... args)
+    : backend_(std::forward<Args>(args)...) {
+    init_page_attrs();
+  }
 
   void set_cpu_type(CpuType cpu_type) {
     cpu_type_ = cpu_type;
   }
 
-  void replace_backend(IBusBackend* backend) {
-    delete backend_;
-    backend_ = backend;
-  }
-
   size_t mem_size() const {
-    return backend_->size();
+    return backend_.size();
   }
 
   // Memory reads: isFetch==true logs as CodeFetch
   uint8_t mem_read_u8(uint32_t address, bool isFetch) {
-    uint8_t val = backend_->read_u8(address);
+    uint8_t val = backend_.read_u8(address);
     //logger_.log({isFetch ? BusOperationType::CodeFetch8 : BusOperationType::MemRead8, ActiveBusWidth::E address, val});
     return val;
   }
   uint16_t mem_read_u16(uint32_t address, bool isFetch) {
-    uint16_t val = backend_->read_u16(address);
+    uint16_t val = backend_.read_u16(address);
     //logger_.log({isFetch ? BusOperationType::CodeFetch16 : BusOperationType::MemRead16, address, val});
     return val;
   }
+  /// @brief Launch the backend lookup for the bus cycle that just started.
+  /// Called at ALE, when the latched address and BHE are already known but
+  /// the data bus doesn't need driving for another two T-states, so the
+  /// hash-probe latency hides inside the T1-T3 window instead of sitting on
+  /// the critical path between clock edges. The slot is consumed (once) by
+  /// the matching mem_read_bus() and invalidated by any intervening write.
+  void mem_speculate(uint32_t address, bool bhe) {
+    spec_data_ = backend_.read_bus(address, bhe);
+    spec_address_ = address;
+    spec_bhe_ = bhe;
+    spec_valid_ = true;
+  }
+
   uint16_t mem_read_bus(uint32_t address, bool bhe, bool isFetch, bool smi_act = false) {
-    uint16_t val = backend_->read_bus(address, bhe);
-    if (smi_act && (address >= (SMRAM_END - sizeof (SmmDump386))) && (address < SMRAM_END)) {
-      // Read from SMRAM.
-      size_t offset = (SMRAM_END - 4) - (address & ~0x03); // Align to 4-byte aligned dwords, decreasing addresses from SMRAM_END
-      size_t sub_offset = ((address & 0x03) != 0) ? 1 : 0; // Adjust for stack order for "high" words
-      if (offset < sizeof(SmmDump386)) {
-        uint16_t* reg_ptr = reinterpret_cast<uint16_t*>(&smm_dump386_) + (offset / 2) + sub_offset;
-        val = *reg_ptr;
-      }
+    uint16_t val;
+    if (spec_valid_ && (spec_address_ == address) && (spec_bhe_ == bhe)) {
+      val = spec_data_;
+      spec_valid_ = false;
+    }
+    else {
+      val = backend_.read_bus(address, bhe);
+    }
+    if (smi_act && (page_attrs(address) & PAGE_ATTR_SMRAM) &&
+        (address >= (SMRAM_END - sizeof (SmmDump386))) && (address < SMRAM_END)) {
+      // Read from SMRAM. The dump image was staged in bus-address order by
+      // smm_stage_load(), so the per-access path is a plain indexed read.
+      val = smm_stage_[(address - (SMRAM_END - sizeof(SmmDump386))) >> 1];
     }
-    
+
     logger_.log({
-      isFetch ? BusOperationType::CodeFetch16 : BusOperationType::MemRead16, 
-      bus_width(address, bhe), 
-      address, 
+      isFetch ? BusOperationType::CodeFetch16 : BusOperationType::MemRead16,
+      bus_width(address, bhe),
+      address,
       val
     });
 
+    check_watchpoints(WATCH_MEM_READ, address);
     return val;
   }
   uint8_t *get_ptr(uint32_t address) {
-    uint8_t *ptr = backend_->get_ptr(address);
+    uint8_t *ptr = backend_.get_ptr(address);
     return ptr;
   }
   void mem_write_u8(uint32_t address, uint8_t value) {
-    backend_->write_u8(address, value);
+    backend_.write_u8(address, value);
     //logger_.log({BusOperationType::MemWrite8, address, value});
   }
   void mem_write_u16(uint32_t address, uint16_t value) {
-    backend_->write_u16(address, value);
+    backend_.write_u16(address, value);
     //logger_.log({BusOperationType::MemWrite16, address, value});
   }
   void mem_write_bus(uint32_t address, uint16_t value, bool bhe, bool smi_act = false) {
-    
+    // Any write invalidates the speculative read slot. Dropping it
+    // unconditionally is cheaper than byte/word overlap checks against the
+    // speculated address, and writes between ALE and the read drive are rare.
+    spec_valid_ = false;
+
     logger_.log({BusOperationType::MemWrite16, bus_width(address, bhe), address, value});
+    check_watchpoints(WATCH_MEM_WRITE, address);
 
   #if defined(CPU_286)
-    backend_->write_bus(address, value, bhe);
-    // Write to loadall286 registers if address matches
-    if ((address >= LOADALL_286_ADDRESS) && (address < (LOADALL_286_ADDRESS + sizeof(Loadall286) - 1))) {
+    backend_.write_bus(address, value, bhe);
+    // Write to loadall286 registers if address matches. The page-attribute
+    // check keeps the range arithmetic off the common path.
+    if ((page_attrs(address) & PAGE_ATTR_LOADALL286) &&
+        (address >= LOADALL_286_ADDRESS) && (address < (LOADALL_286_ADDRESS + sizeof(Loadall286) - 1))) {
       size_t offset = address - LOADALL_286_ADDRESS;
       if (offset < sizeof(Loadall286)) {
         uint16_t* reg_ptr = reinterpret_cast<uint16_t*>(&loadall286_regs_) + (offset / 2);
@@ -230,57 +418,55 @@ public:
       }
     }
   #elif defined(CPU_386)
-    // Write to SmmDump386 registers if address matches
-    // The SMM dump is written in stack order (decreasing addresses). So we need a little bit of 
-    // logic to write the structure in forward order.
-    if (smi_act && (address >= (SMRAM_END - sizeof (SmmDump386))) && (address < SMRAM_END)) {
-      size_t offset = (SMRAM_END - 4) - (address & ~0x03); // Align to 4-byte aligned dwords, decreasing addresses from SMRAM_END
-      size_t sub_offset = ((address & 0x03) != 0) ? 1 : 0; // Adjust for stack order for "high" words
-      if (offset < sizeof(SmmDump386)) {
-        //DEBUG_SERIAL.println("## BusEmulator: Writing to SmmDump386 register");
-        uint16_t* reg_ptr = reinterpret_cast<uint16_t*>(&smm_dump386_) + (offset / 2) + sub_offset;
-        *reg_ptr = value;
-      }
+    // Write to the SMRAM staging window if the address matches. The word
+    // lands at its bus-address slot; the stack-order conversion back into
+    // SmmDump386 happens once, when smm_dump386_regs() is next read.
+    if (smi_act && (page_attrs(address) & PAGE_ATTR_SMRAM) &&
+        (address >= (SMRAM_END - sizeof (SmmDump386))) && (address < SMRAM_END)) {
+      smm_stage_[(address - (SMRAM_END - sizeof(SmmDump386))) >> 1] = value;
+      smm_stage_dirty_ = true;
     }
     else {
       // Normal write
-      backend_->write_bus(address, value, bhe);
+      backend_.write_bus(address, value, bhe);
     }
-  #else 
-    backend_->write_bus(address, value, bhe);
+  #else
+    backend_.write_bus(address, value, bhe);
   #endif
   }
 
   uint8_t io_read_u8(uint16_t port) {
-    uint8_t val = backend_->io_read_u8(port);
+    uint8_t val = backend_.io_read_u8(port);
     //logger_.log({BusOperationType::IoRead8, port, val});
     return val;
   }
   uint16_t io_read_u16(uint16_t port) {
-    uint16_t val = backend_->io_read_u16(port);
+    uint16_t val = backend_.io_read_u16(port);
     //logger_.log({BusOperationType::IoRead16, port, val});
     return val;
   }
   uint16_t io_read_bus(uint16_t port, bool bhe) {
-    uint16_t val = backend_->io_read_bus(port, bhe);
+    uint16_t val = backend_.io_read_bus(port, bhe);
     logger_.log({BusOperationType::IoRead16, bus_width(port, bhe), port, val});
+    check_watchpoints(WATCH_IO_READ, port);
     return val;
   }
   void io_write_u8(uint16_t port, uint8_t value) {
-    backend_->io_write_u8(port, value);
+    backend_.io_write_u8(port, value);
     //logger_.log({BusOperationType::IoWrite8, port, value});
   }
   void io_write_u16(uint16_t port, uint16_t value) {
-    backend_->io_write_u16(port, value);
+    backend_.io_write_u16(port, value);
     //logger_.log({BusOperationType::IoWrite16, port, value});
   }
   void io_write_bus(uint16_t port, uint16_t value, bool bhe) {
-    backend_->io_write_bus(port, value, bhe);
+    backend_.io_write_bus(port, value, bhe);
     logger_.log({BusOperationType::IoWrite16, bus_width(port, bhe), port, value});
-  
+    check_watchpoints(WATCH_IO_WRITE, port);
+
     // Write to Loadall386 registers if port matches
-    if (cpu_type_ == CpuType::i80386 && 
-        (port >= STORE_IO_BASE) && (port < (STORE_IO_BASE + sizeof(Loadall386) - 1))) 
+    if (cpu_type_ == CpuType::i80386 &&
+        (port >= STORE_IO_BASE) && (port < (STORE_IO_BASE + sizeof(Loadall386) - 1)))
     {
       size_t offset = port - STORE_IO_BASE;
       if (offset < sizeof(Loadall386)) {
@@ -290,6 +476,18 @@ public:
     }
   }
 
+  /// @brief Log an I/O transfer served by the variant's port-handler
+  /// registry, so handler-served ports appear in the bus operation log and
+  /// trip I/O watchpoints exactly like backend-served ones.
+  void log_io_read(uint16_t port, uint16_t val, bool bhe) {
+    logger_.log({BusOperationType::IoRead16, bus_width(port, bhe), port, val});
+    check_watchpoints(WATCH_IO_READ, port);
+  }
+  void log_io_write(uint16_t port, uint16_t val, bool bhe) {
+    logger_.log({BusOperationType::IoWrite16, bus_width(port, bhe), port, val});
+    check_watchpoints(WATCH_IO_WRITE, port);
+  }
+
   void halt(uint32_t address) {
     if ((address & 0x2) != 0) {
       logger_.log({BusOperationType::Halt,  ActiveBusWidth::Sixteen, address, 0});
@@ -300,20 +498,32 @@ public:
   }
 
   void set_memory(uint32_t address, const uint8_t* buffer, size_t length) {
-    backend_->set_memory(address, buffer, length);
+    spec_valid_ = false;
+    backend_.set_memory(address, buffer, length);
   }
 
   void erase_memory() {
-    backend_->erase_memory();
+    spec_valid_ = false;
+    backend_.erase_memory();
+  }
+
+  bool snapshot_memory() {
+    return backend_.snapshot_memory();
+  }
+
+  bool restore_memory() {
+    spec_valid_ = false;
+    return backend_.restore_memory();
   }
 
   void debug_memory(uint32_t address, size_t length) {
-    backend_->debug_mem(address, length);
+    backend_.debug_mem(address, length);
   }
 
   /// @brief Randomizes the contents of the emulated memory with random data.
   void randomize_memory(uint32_t seed) {
-    backend_->randomize_memory(seed);
+    spec_valid_ = false;
+    backend_.randomize_memory(seed);
   }
   void enable_logging() {
     logger_.enable();
@@ -325,17 +535,72 @@ public:
     logger_.reset();
   }
   bool far_call_detected() {
-    // Check that the last 3 bus operations were writes. 
+    // Check that the last 3 bus operations were writes.
     // This is indicative of a far call or exception if we are reading from the IVT.
     return logger_.get_consecutive_writes() >= 3;
   }
   void set_memory_strategy(IBusBackend::DefaultStrategy strategy, uint32_t start, uint32_t end) {
-    backend_->set_strategy(strategy, start, end);
+    spec_valid_ = false;
+    backend_.set_strategy(strategy, start, end);
+  }
+
+  bool add_memory_strategy(IBusBackend::DefaultStrategy strategy, uint32_t start, uint32_t end) {
+    spec_valid_ = false;
+    return backend_.add_strategy(strategy, start, end);
+  }
+
+  /// @brief Install or disable a watchpoint. An op_mask of 0 disables the
+  /// slot. Returns false for an out-of-range index.
+  bool set_watchpoint(size_t index, uint32_t start, uint32_t end, uint8_t op_mask) {
+    if (index >= BUS_MAX_WATCHPOINTS) {
+      return false;
+    }
+    watchpoints_[index].start = start;
+    watchpoints_[index].end = end;
+    watchpoints_[index].op_mask = op_mask;
+    recompute_watch_classes();
+    return true;
+  }
+
+  void clear_watchpoints() {
+    for (size_t i = 0; i < BUS_MAX_WATCHPOINTS; i++) {
+      watchpoints_[i].op_mask = 0;
+    }
+    watch_classes_ = 0;
+    clear_watch_hit();
+  }
+
+  bool watch_hit() const { return watch_hit_; }
+  uint8_t watch_hit_index() const { return watch_hit_index_; }
+  uint32_t watch_hit_addr() const { return watch_hit_addr_; }
+
+  /// @brief Clear the hit latch, unfreezing the bus log if the hit froze it.
+  void clear_watch_hit() {
+    if (watch_hit_ && watch_froze_log_) {
+      logger_.enable();
+    }
+    watch_hit_ = false;
+    watch_froze_log_ = false;
   }
 
+  // Hash-table occupancy, for the server status telemetry block.
+  size_t table_size() const { return backend_.table_size(); }
+  size_t table_capacity() const { return backend_.table_capacity(); }
+  uint8_t table_max_probe() const { return backend_.table_max_probe(); }
+
+  // Dirtied-word enumeration for the end-of-test result bundle. On the hash
+  // backend this walks exactly the words written since the last erase; the
+  // SDRAM backend has no write tracking and reports zero words.
+  size_t dirty_word_count() const { return backend_.table_size(); }
+  template <typename Visitor>
+  void for_each_dirty_word(Visitor&& visit) const { backend_.for_each_word(visit); }
+
   // Expose log info
   const BusOperation* log_data() const { return logger_.data(); }
   size_t log_count() const { return logger_.count(); }
+  size_t log_capacity() const { return logger_.capacity(); }
+  bool log_set_capacity(size_t capacity) { return logger_.set_capacity(capacity); }
+  void log_dump_ops() const { logger_.dump_ops(); }
   bool log_overflowed() const { return logger_.overflowed(); }
   BusOperation log_peek_back(size_t rel) const { return logger_.peek_back(rel); }
   CallStackFrame log_peek_call_frame() const { return logger_.peek_call_frame(); }
@@ -349,15 +614,48 @@ public:
   }
 
   SmmDump386& smm_dump386_regs() {
+    if (smm_stage_dirty_) {
+      smm_stage_parse();
+    }
     return smm_dump386_;
   }
 
-  ~BusEmulator() {
-      delete backend_;
+  /// @brief Serialize the SmmDump386 image into the SMRAM staging window.
+  /// Called once when an SMM register set is installed; converts the
+  /// stack-order (decreasing address) layout the CPU expects into flat
+  /// bus-address order so the per-access SMRAM read is a plain indexed load.
+  void smm_stage_load() {
+    const uint32_t base = SMRAM_END - sizeof(SmmDump386);
+    for (uint32_t addr = base; addr < SMRAM_END; addr += 2) {
+      smm_stage_[(addr - base) >> 1] =
+        reinterpret_cast<uint16_t*>(&smm_dump386_)[smm_reg_word_index(addr)];
+    }
+    smm_stage_dirty_ = false;
   }
 
 private:
-  IBusBackend*  backend_;
+  /// @brief Word index into SmmDump386 for a bus address inside the SMRAM
+  /// dump window. The CPU dumps the structure in stack order (4-byte dwords
+  /// at decreasing addresses, high word first within each dword).
+  static size_t smm_reg_word_index(uint32_t address) {
+    size_t offset = (SMRAM_END - 4) - (address & ~0x03);
+    size_t sub_offset = ((address & 0x03) != 0) ? 1 : 0;
+    return (offset / 2) + sub_offset;
+  }
+
+  /// @brief Parse the SMRAM staging window back into the SmmDump386 struct.
+  /// Runs once per store, on the first smm_dump386_regs() read after the
+  /// CPU's SMM dump finishes writing the staging area.
+  void smm_stage_parse() {
+    const uint32_t base = SMRAM_END - sizeof(SmmDump386);
+    for (uint32_t addr = base; addr < SMRAM_END; addr += 2) {
+      reinterpret_cast<uint16_t*>(&smm_dump386_)[smm_reg_word_index(addr)] =
+        smm_stage_[(addr - base) >> 1];
+    }
+    smm_stage_dirty_ = false;
+  }
+
+  Backend       backend_;
   BusLogger     logger_;
   CpuType       cpu_type_ = CpuType::Undetected; // Default CPU type
 
@@ -366,6 +664,84 @@ private:
   Loadall386 loadall386_regs_;
   SmmDump386 smm_dump386_;
 
+  // The SMM dump image serialized in bus-address order, so the per-access
+  // SMRAM path is a plain indexed word read/write. The dirty flag marks a
+  // store in progress; smm_dump386_regs() parses the window back into the
+  // struct on its next read.
+  uint16_t smm_stage_[(sizeof(SmmDump386) + 1) / 2] = {};
+  bool smm_stage_dirty_ = false;
+
+  // One flag byte per 1KB page; see the PAGE_ATTR_* constants above.
+  uint8_t page_attrs_[PAGE_ATTR_ENTRIES];
+
+  // Speculative read slot filled by mem_speculate() at ALE and consumed by
+  // the matching mem_read_bus(); see mem_speculate().
+  uint32_t spec_address_ = 0;
+  uint16_t spec_data_ = 0;
+  bool     spec_bhe_ = false;
+  bool     spec_valid_ = false;
+
+  Watchpoint watchpoints_[BUS_MAX_WATCHPOINTS] = {};
+  uint8_t  watch_classes_ = 0; // OR of every enabled watchpoint's op_mask
+  bool     watch_hit_ = false;
+  bool     watch_froze_log_ = false;
+  uint8_t  watch_hit_index_ = 0;
+  uint32_t watch_hit_addr_ = 0;
+
+  void recompute_watch_classes() {
+    watch_classes_ = 0;
+    for (size_t i = 0; i < BUS_MAX_WATCHPOINTS; i++) {
+      watch_classes_ |= watchpoints_[i].op_mask;
+    }
+  }
+
+  /// @brief Test an access against the watchpoint table. The class-mask test
+  /// up front keeps this to a single AND on the hot path when no enabled
+  /// watchpoint covers the access class. The first hit latches; further
+  /// accesses pass through untested until the host clears it.
+  inline void check_watchpoints(uint8_t op_class, uint32_t address) {
+    if (((watch_classes_ & op_class) == 0) || watch_hit_) {
+      return;
+    }
+    for (size_t i = 0; i < BUS_MAX_WATCHPOINTS; i++) {
+      const Watchpoint &wp = watchpoints_[i];
+      if ((wp.op_mask & op_class) && (address >= wp.start) && (address <= wp.end)) {
+        watch_hit_ = true;
+        watch_hit_index_ = static_cast<uint8_t>(i);
+        watch_hit_addr_ = address;
+        // Freeze the bus log so the ring keeps the operations around the
+        // trigger instead of scrolling them out.
+        if (logger_.is_enabled()) {
+          logger_.disable();
+          watch_froze_log_ = true;
+        }
+        return;
+      }
+    }
+  }
+
+  /// @brief Look up the attribute flags for the page containing an address.
+  /// A single masked load; no flags set means no special region can overlap
+  /// the access and the exact range checks are skipped entirely.
+  uint8_t page_attrs(uint32_t address) const {
+    return page_attrs_[(address >> PAGE_ATTR_SHIFT) & (PAGE_ATTR_ENTRIES - 1)];
+  }
+
+  /// @brief Set a flag on every page overlapping [start, end).
+  void mark_page_attrs(uint32_t start, uint32_t end, uint8_t flag) {
+    for (uint32_t page = start >> PAGE_ATTR_SHIFT; page <= ((end - 1) >> PAGE_ATTR_SHIFT); page++) {
+      page_attrs_[page & (PAGE_ATTR_ENTRIES - 1)] |= flag;
+    }
+  }
+
+  /// @brief Build the page-attribute table. Future special regions (e.g. 386
+  /// SMRAM relocation) only need another mark_page_attrs() call here.
+  void init_page_attrs() {
+    memset(page_attrs_, 0, sizeof(page_attrs_));
+    mark_page_attrs(LOADALL_286_ADDRESS, LOADALL_286_ADDRESS + sizeof(Loadall286), PAGE_ATTR_LOADALL286);
+    mark_page_attrs(SMRAM_END - sizeof(SmmDump386), SMRAM_END, PAGE_ATTR_SMRAM);
+  }
+
   /// @brief Determine bus width based on address and BHE
   ActiveBusWidth bus_width(uint32_t address, bool bhe) const {
     if (address & 1) {
@@ -381,16 +757,397 @@ private:
   }
 };
 
-// Factory helper: choose backend based on platform
+// Dispatch a call to whichever typed emulator is active. Both arms call a
+// concrete BusEmulatorT, so the backend access inlines; the only runtime cost
+// is one well-predicted branch on the backend kind.
+#define BUS_DISPATCH(call) \
+  ((kind_ == BackendKind::Sdram) ? sdram_->call : hash_->call)
+
+/// @brief Top-level variant over the supported backend types. The runtime
+/// FLAG_USE_SDRAM_BACKEND selection happens here, once per call, instead of
+/// through a virtual backend interface on every bus transfer.
+class BusEmulator {
+public:
+  enum class BackendKind : uint8_t {
+    Hash,
+    Sdram
+  };
+
+  explicit BusEmulator(BackendKind kind) {
+    select(kind);
+  }
+
+  ~BusEmulator() {
+    destroy();
+  }
+
+  BackendKind backend_kind() const { return kind_; }
+
+  /// @brief Switch to the hash table backend. Memory contents, the bus log,
+  /// and shadow registers are reset, as with the old backend replacement.
+  void use_hash_backend() {
+    if (hash_ && (kind_ == BackendKind::Hash)) return;
+    destroy();
+    select(BackendKind::Hash);
+  }
+
+  /// @brief Switch to the SDRAM backend. Memory contents, the bus log, and
+  /// shadow registers are reset, as with the old backend replacement.
+  void use_sdram_backend() {
+    if (sdram_ && (kind_ == BackendKind::Sdram)) return;
+    destroy();
+    select(BackendKind::Sdram);
+  }
+
+  void set_cpu_type(CpuType cpu_type) {
+    cpu_type_ = cpu_type;
+    // Every detection path lands here, so this is where the trace subsystem
+    // learns which CPU to stamp into bulk dump headers.
+    ArduinoX86::TraceCpuType = static_cast<uint8_t>(cpu_type);
+    BUS_DISPATCH(set_cpu_type(cpu_type));
+  }
+
+  size_t mem_size() const { return BUS_DISPATCH(mem_size()); }
+
+  uint8_t mem_read_u8(uint32_t address, bool isFetch) {
+    return BUS_DISPATCH(mem_read_u8(address, isFetch));
+  }
+  uint16_t mem_read_u16(uint32_t address, bool isFetch) {
+    return BUS_DISPATCH(mem_read_u16(address, isFetch));
+  }
+  uint16_t mem_read_bus(uint32_t address, bool bhe, bool isFetch, bool smi_act = false) {
+    return BUS_DISPATCH(mem_read_bus(address, bhe, isFetch, smi_act));
+  }
+  void mem_speculate(uint32_t address, bool bhe) {
+    BUS_DISPATCH(mem_speculate(address, bhe));
+  }
+  uint8_t *get_ptr(uint32_t address) { return BUS_DISPATCH(get_ptr(address)); }
+  void mem_write_u8(uint32_t address, uint8_t value) {
+    BUS_DISPATCH(mem_write_u8(address, value));
+  }
+  void mem_write_u16(uint32_t address, uint16_t value) {
+    BUS_DISPATCH(mem_write_u16(address, value));
+  }
+  void mem_write_bus(uint32_t address, uint16_t value, bool bhe, bool smi_act = false) {
+    BUS_DISPATCH(mem_write_bus(address, value, bhe, smi_act));
+  }
+
+  uint8_t io_read_u8(uint16_t port) { return BUS_DISPATCH(io_read_u8(port)); }
+  uint16_t io_read_u16(uint16_t port) { return BUS_DISPATCH(io_read_u16(port)); }
+  uint16_t io_read_bus(uint16_t port, bool bhe) {
+    if (port_pages_[(port >> PORT_PAGE_SHIFT) & (PORT_PAGE_ENTRIES - 1)]) {
+      PortHandler* handler = find_port_handler(port);
+      if (handler != nullptr) {
+        uint16_t val = port_handler_read(*handler, port, bhe);
+        BUS_DISPATCH(log_io_read(port, val, bhe));
+        return val;
+      }
+    }
+    return BUS_DISPATCH(io_read_bus(port, bhe));
+  }
+  void io_write_u8(uint16_t port, uint8_t value) { BUS_DISPATCH(io_write_u8(port, value)); }
+  void io_write_u16(uint16_t port, uint16_t value) { BUS_DISPATCH(io_write_u16(port, value)); }
+  void io_write_bus(uint16_t port, uint16_t value, bool bhe) {
+    if (port_pages_[(port >> PORT_PAGE_SHIFT) & (PORT_PAGE_ENTRIES - 1)]) {
+      PortHandler* handler = find_port_handler(port);
+      if (handler != nullptr) {
+        port_handler_write(*handler, port, value, bhe);
+        BUS_DISPATCH(log_io_write(port, value, bhe));
+        return;
+      }
+    }
+    BUS_DISPATCH(io_write_bus(port, value, bhe));
+  }
+
+  void halt(uint32_t address) { BUS_DISPATCH(halt(address)); }
+
+  void set_memory(uint32_t address, const uint8_t* buffer, size_t length) {
+    BUS_DISPATCH(set_memory(address, buffer, length));
+  }
+  void erase_memory() { BUS_DISPATCH(erase_memory()); }
+  bool snapshot_memory() { return BUS_DISPATCH(snapshot_memory()); }
+  bool restore_memory() { return BUS_DISPATCH(restore_memory()); }
+  void debug_memory(uint32_t address, size_t length) {
+    BUS_DISPATCH(debug_memory(address, length));
+  }
+  void randomize_memory(uint32_t seed) { BUS_DISPATCH(randomize_memory(seed)); }
+  void enable_logging() { BUS_DISPATCH(enable_logging()); }
+  void disable_logging() { BUS_DISPATCH(disable_logging()); }
+  void reset_logging() { BUS_DISPATCH(reset_logging()); }
+  bool far_call_detected() { return BUS_DISPATCH(far_call_detected()); }
+  void set_memory_strategy(IBusBackend::DefaultStrategy strategy, uint32_t start, uint32_t end) {
+    BUS_DISPATCH(set_memory_strategy(strategy, start, end));
+  }
+  bool add_memory_strategy(IBusBackend::DefaultStrategy strategy, uint32_t start, uint32_t end) {
+    return BUS_DISPATCH(add_memory_strategy(strategy, start, end));
+  }
+
+  bool set_watchpoint(size_t index, uint32_t start, uint32_t end, uint8_t op_mask) {
+    return BUS_DISPATCH(set_watchpoint(index, start, end, op_mask));
+  }
+  void clear_watchpoints() { BUS_DISPATCH(clear_watchpoints()); }
+  bool watch_hit() const { return BUS_DISPATCH(watch_hit()); }
+  uint8_t watch_hit_index() const { return BUS_DISPATCH(watch_hit_index()); }
+  uint32_t watch_hit_addr() const { return BUS_DISPATCH(watch_hit_addr()); }
+  void clear_watch_hit() { BUS_DISPATCH(clear_watch_hit()); }
+
+  // Expose log info
+  const BusOperation* log_data() const { return BUS_DISPATCH(log_data()); }
+  size_t log_count() const { return BUS_DISPATCH(log_count()); }
+  size_t log_capacity() const { return BUS_DISPATCH(log_capacity()); }
+  size_t table_size() const { return BUS_DISPATCH(table_size()); }
+  size_t table_capacity() const { return BUS_DISPATCH(table_capacity()); }
+  uint8_t table_max_probe() const { return BUS_DISPATCH(table_max_probe()); }
+  size_t dirty_word_count() const { return BUS_DISPATCH(dirty_word_count()); }
+  template <typename Visitor>
+  void for_each_dirty_word(Visitor&& visit) const { return BUS_DISPATCH(for_each_dirty_word(visit)); }
+
+  bool log_set_capacity(size_t capacity) { return BUS_DISPATCH(log_set_capacity(capacity)); }
+  void log_dump_ops() const { BUS_DISPATCH(log_dump_ops()); }
+  bool log_overflowed() const { return BUS_DISPATCH(log_overflowed()); }
+  BusOperation log_peek_back(size_t rel) const { return BUS_DISPATCH(log_peek_back(rel)); }
+  CallStackFrame log_peek_call_frame() const { return BUS_DISPATCH(log_peek_call_frame()); }
+
+  Loadall286& loadall286_regs() { return BUS_DISPATCH(loadall286_regs()); }
+  Loadall386& loadall386_regs() { return BUS_DISPATCH(loadall386_regs()); }
+  SmmDump386& smm_dump386_regs() { return BUS_DISPATCH(smm_dump386_regs()); }
+  void smm_stage_load() { BUS_DISPATCH(smm_stage_load()); }
+
+  // --- Per-region wait-state profile --------------------------------------
+  // One wait count byte per 1KB page (same wrap as the page attribute
+  // table); I/O transfers use a single profile value, since decoded ports
+  // are sparse. The cycle engine reads these at ALE, one table load per bus
+  // cycle, and holds READY low for the returned count. All zero by default,
+  // so READY is never driven unless the host programs a profile. Lives here
+  // rather than in the typed emulators so it survives backend switches.
+
+  uint8_t mem_wait_states(uint32_t address) const {
+    return wait_map_[(address >> PAGE_ATTR_SHIFT) & (PAGE_ATTR_ENTRIES - 1)];
+  }
+
+  uint8_t io_wait_states() const { return io_wait_states_; }
+
+  /// @brief Program `count` wait states for memory transfers in
+  /// [start, end). Pages the range only partially covers take the count for
+  /// the whole page, matching the page attribute granularity.
+  void set_wait_states(uint32_t start, uint32_t end, uint8_t count) {
+    if (end <= start) return;
+    for (uint32_t page = start >> PAGE_ATTR_SHIFT; page <= ((end - 1) >> PAGE_ATTR_SHIFT); page++) {
+      wait_map_[page & (PAGE_ATTR_ENTRIES - 1)] = count;
+    }
+  }
+
+  void set_io_wait_states(uint8_t count) { io_wait_states_ = count; }
+
+  void clear_wait_states() {
+    memset(wait_map_, 0, sizeof(wait_map_));
+    io_wait_states_ = 0;
+  }
+
+  // --- Emulated interrupt controller --------------------------------------
+  // A single host-armed vector standing in for an 8259 in automatic-EOI
+  // mode. When armed, the cycle engine answers both INTA bus cycles with
+  // this vector itself instead of dropping to single-step for the host to
+  // supply it, and the IVT fetch that follows is an ordinary read served
+  // from emulated memory. Disarmed by default so the classic host-driven
+  // acknowledge path is unchanged. Lives here rather than in the typed
+  // emulators so it survives backend switches.
+
+  bool intr_vector_armed() const { return intr_vector_armed_; }
+
+  uint8_t intr_vector() const { return intr_vector_; }
+
+  void set_intr_vector(uint8_t vector) {
+    intr_vector_ = vector;
+    intr_vector_armed_ = true;
+  }
+
+  void clear_intr_vector() {
+    intr_vector_ = 0;
+    intr_vector_armed_ = false;
+  }
+
+  // --- Registered I/O port handlers ---------------------------------------
+  // See the PortHandler definitions above. The registry lives here rather
+  // than in the typed emulators so bindings survive backend switches.
+
+  /// @brief Bind a handler slot to a port range, or unbind it with
+  /// PortHandlerKind::None. Returns false for an out-of-range index or
+  /// script length.
+  bool set_port_handler(size_t index, PortHandlerKind kind, uint16_t start, uint16_t end,
+                        uint8_t value, const uint8_t* script, uint8_t script_len) {
+    if (index >= BUS_MAX_PORT_HANDLERS) {
+      return false;
+    }
+    if (script_len > PORT_HANDLER_SCRIPT_BYTES) {
+      return false;
+    }
+    PortHandler& handler = port_handlers_[index];
+    handler.kind = kind;
+    handler.start = start;
+    handler.end = end;
+    handler.value = value;
+    handler.script_len = script_len;
+    handler.script_pos = 0;
+    if (script_len > 0) {
+      memcpy(handler.script, script, script_len);
+    }
+    recompute_port_pages();
+    return true;
+  }
+
+  void clear_port_handlers() {
+    for (size_t i = 0; i < BUS_MAX_PORT_HANDLERS; i++) {
+      port_handlers_[i].kind = PortHandlerKind::None;
+    }
+    memset(port_pages_, 0, sizeof(port_pages_));
+  }
+
+private:
+  void select(BackendKind kind) {
+    kind_ = kind;
+    if (kind_ == BackendKind::Sdram) {
+      sdram_ = new (&backend_storage_) BusEmulatorT<SdramBackend>(MEMORY_SIZE, ADDRESS_SPACE_MASK);
+      sdram_->set_cpu_type(cpu_type_);
+    }
+    else {
+      hash_ = new (&backend_storage_) BusEmulatorT<HashBackend>();
+      hash_->set_cpu_type(cpu_type_);
+    }
+  }
+
+  void destroy() {
+    // Placement-constructed: run the destructor without freeing the slot.
+    if (hash_) {
+      hash_->~BusEmulatorT();
+      hash_ = nullptr;
+    }
+    if (sdram_) {
+      sdram_->~BusEmulatorT();
+      sdram_ = nullptr;
+    }
+  }
+
+  void recompute_port_pages() {
+    memset(port_pages_, 0, sizeof(port_pages_));
+    for (size_t i = 0; i < BUS_MAX_PORT_HANDLERS; i++) {
+      const PortHandler& handler = port_handlers_[i];
+      if (handler.kind == PortHandlerKind::None) {
+        continue;
+      }
+      for (uint32_t page = handler.start >> PORT_PAGE_SHIFT;
+           page <= (uint32_t)(handler.end >> PORT_PAGE_SHIFT); page++) {
+        port_pages_[page & (PORT_PAGE_ENTRIES - 1)] = 1;
+      }
+    }
+  }
+
+  /// @brief Scan the handler table for one covering `port`. Only reached
+  /// when the page table says a handler may cover this page.
+  PortHandler* find_port_handler(uint16_t port) {
+    for (size_t i = 0; i < BUS_MAX_PORT_HANDLERS; i++) {
+      PortHandler& handler = port_handlers_[i];
+      if ((handler.kind != PortHandlerKind::None) && (port >= handler.start) && (port <= handler.end)) {
+        return &handler;
+      }
+    }
+    return nullptr;
+  }
+
+  uint8_t port_handler_read_u8(PortHandler& handler) {
+    switch (handler.kind) {
+      case PortHandlerKind::Constant:
+      case PortHandlerKind::Latch:
+        return handler.value;
+      case PortHandlerKind::Counter:
+        return handler.value++;
+      case PortHandlerKind::Script: {
+        if (handler.script_len == 0) {
+          return 0xFF;
+        }
+        uint8_t byte = handler.script[handler.script_pos];
+        if (++handler.script_pos >= handler.script_len) {
+          handler.script_pos = 0;
+        }
+        return byte;
+      }
+      default:
+        return 0xFF;
+    }
+  }
+
+  void port_handler_write_u8(PortHandler& handler, uint8_t value) {
+    switch (handler.kind) {
+      case PortHandlerKind::Latch:
+      case PortHandlerKind::Counter:
+        handler.value = value;
+        break;
+      case PortHandlerKind::Script:
+        // A write rewinds the sequence so the host can re-run it.
+        handler.script_pos = 0;
+        break;
+      default:
+        // Constant discards writes.
+        break;
+    }
+  }
+
+  /// @brief Compose a bus-level read from handler bytes, placing them on
+  /// the byte lanes the port and BHE select. Inactive lanes float to 0xFF
+  /// like an undecoded port.
+  uint16_t port_handler_read(PortHandler& handler, uint16_t port, bool bhe) {
+    if (port & 1) {
+      return (uint16_t)(((uint16_t)port_handler_read_u8(handler) << 8) | 0x00FF);
+    }
+    uint16_t val = port_handler_read_u8(handler);
+    if (bhe) {
+      val |= (uint16_t)port_handler_read_u8(handler) << 8;
+    }
+    else {
+      val |= 0xFF00;
+    }
+    return val;
+  }
+
+  void port_handler_write(PortHandler& handler, uint16_t port, uint16_t value, bool bhe) {
+    if (port & 1) {
+      port_handler_write_u8(handler, (uint8_t)(value >> 8));
+      return;
+    }
+    port_handler_write_u8(handler, (uint8_t)value);
+    if (bhe) {
+      port_handler_write_u8(handler, (uint8_t)(value >> 8));
+    }
+  }
+
+  BackendKind kind_ = BackendKind::Hash;
+  BusEmulatorT<HashBackend>* hash_ = nullptr;
+  BusEmulatorT<SdramBackend>* sdram_ = nullptr;
+
+  // In-place storage for whichever backend variant is live, sized and
+  // aligned for the larger of the two instantiations. Backend switching
+  // placement-constructs into this slot instead of pairing new/delete, so
+  // toggling FLAG_USE_SDRAM_BACKEND across thousands of sessions cannot
+  // fragment the heap and the worst-case object footprint is fixed at
+  // compile time. (The backends' bulk memory - the SDRAM array, the hash
+  // table pools - is still allocated by the backends themselves.)
+  std::aligned_union_t<0, BusEmulatorT<SdramBackend>, BusEmulatorT<HashBackend>> backend_storage_;
+  CpuType cpu_type_ = CpuType::Undetected;
+  uint8_t wait_map_[PAGE_ATTR_ENTRIES] = {};
+  uint8_t io_wait_states_ = 0;
+  uint8_t intr_vector_ = 0;
+  bool intr_vector_armed_ = false;
+  PortHandler port_handlers_[BUS_MAX_PORT_HANDLERS] = {};
+  uint8_t port_pages_[PORT_PAGE_ENTRIES] = {}; // Nonzero if a handler may cover the page
+};
+
+#undef BUS_DISPATCH
+
+// Factory helper: choose backend based on platform. The single emulator
+// instance lives in static storage, so its worst-case footprint (including
+// the in-place backend slot) is fixed at link time instead of carved from
+// the heap at startup.
 inline BusEmulator* create_bus_emulator() {
-#if defined(ARDUINO_GIGA)
-  return new BusEmulator(
-      //new SdramBackend(MEMORY_SIZE, ADDRESS_SPACE_MASK)
-      new HashBackend()
-  );
-#else
-  return new BusEmulator(
-      new HashBackend()
-  );
-#endif
+  static BusEmulator emulator(BusEmulator::BackendKind::Hash);
+  return &emulator;
 }
@@ -45,6 +45,66 @@
 #define CMD_TIMEOUT 100 // Command timeout in milliseconds
 #define MAX_ERROR_CYCLES 5
 #define EXECUTE_TIMEOUT 1000
+
+// Frequency for the hardware-timer CPU clock used when free-run turbo mode is
+// engaged (FLAG_FREE_RUN_CLOCK). Only supported on the Giga; other boards fall
+// back to the bit-banged clock.
+#define FREE_RUN_CLOCK_HZ 1000000
+
+// Hardware watchdog (Giga only): the IWDG is started in setup() and kicked
+// from loop(), so a firmware wedge that stops the main loop entirely ends in
+// an MCU reset within seconds instead of a dead rig waiting for an operator.
+// The IWDG cannot be stopped once started; the timeout is generous so
+// legitimate long operations (memory CRC, snapshots, uploads) never trip it.
+// Disable with -DUSE_WATCHDOG=0.
+#ifndef USE_WATCHDOG
+#define USE_WATCHDOG 1
+#endif
+#define WATCHDOG_TIMEOUT_MS 8000
+
+// Cycle budget for host-driven automatic execution. A wedged target CPU (we
+// see this with marginal 286 parts) can otherwise cycle forever in Execute;
+// on expiry the server resets the target, returns to ServerState::Reset and
+// reports the event via CmdLastError. The USB session survives, so the host
+// recovers in milliseconds instead of waiting for a power cycle.
+#define EXECUTE_WATCHDOG_CYCLES 5000000
+
+// Fast-boot profile for headless farm rigs (env:giga_r1_m7_fastboot).
+// Defers SDRAM controller init until the first buffer is actually allocated
+// (see SdramInit.h) and compiles the buzzer out, so a power-cycled rig
+// accepts its first command as soon as USB enumerates. Display init is
+// already deferred until CmdInitScreen. Enable with -DFAST_BOOT=1.
+#ifndef FAST_BOOT
+#define FAST_BOOT 0
+#endif
+
+// Stamp every CycleState record with the Cortex-M DWT cycle counter at
+// log() time, turning a cycle trace into a firmware profile: gaps between
+// timestamps show where the firmware itself stalls between target-CPU
+// clocks (serial hiccups, debug prints, display updates). Adds 4 bytes per
+// record, so it is off by default to keep traces compact. Enable with
+// -DCYCLE_TIMESTAMPS=1.
+#ifndef CYCLE_TIMESTAMPS
+#define CYCLE_TIMESTAMPS 0
+#endif
+
+// Dedicated trace channel (Giga only): registers a second CDC interface
+// (SerialTrace) on the composite USB device and routes CycleStateLogger and
+// BusLogger streaming to it, leaving the command channel free. Lets the host
+// drain test N's trace while test N+1 runs. Requires host support: trace
+// dumps arrive on the second port instead of in-band. Enable with
+// -DUSE_TRACE_SERIAL=1.
+#ifndef USE_TRACE_SERIAL
+#define USE_TRACE_SERIAL 0
+#endif
+
+// Experimental dual-core mode (Giga only): the Cortex-M4 runs the serial
+// protocol front end while the M7 runs the cycle engine, linked by lock-free
+// rings in SRAM4 (see DualCore.h). Requires the env:giga_r1_m4 companion
+// image on the second flash bank. Enable with -DUSE_DUAL_CORE=1.
+#ifndef USE_DUAL_CORE
+#define USE_DUAL_CORE 0
+#endif
 // What vector to use for the BRKEM call. No reason to change this really.
 #define BRKEM_VECTOR ((uint8_t)0x00)
 
@@ -434,4 +434,191 @@
 
 #endif
 
+// ----------------------- Per-cycle GPIO port snapshot ------------------------
+// A PortSnapshot captures every GPIO input data register in one pass so the
+// cycle loop can decode address, status and command bits from a single
+// consistent sample instead of re-reading the same volatile IDR registers
+// once per field. The SNAP_PIN_* macros mirror the READ_PIN_* macros above,
+// extracting the same bit from the snapshot. On boards without snapshot
+// support they fall back to live pin reads.
+
+#if defined(ARDUINO_GIGA)
+
+typedef struct {
+  uint32_t a, b, c, d, e, g, h, i, j, k;
+} PortSnapshot;
+
+#define CAPTURE_PORT_SNAPSHOT(s)  \
+    do {                          \
+      (s).a = GPIOA->IDR;         \
+      (s).b = GPIOB->IDR;         \
+      (s).c = GPIOC->IDR;         \
+      (s).d = GPIOD->IDR;         \
+      (s).e = GPIOE->IDR;         \
+      (s).g = GPIOG->IDR;         \
+      (s).h = GPIOH->IDR;         \
+      (s).i = GPIOI->IDR;         \
+      (s).j = GPIOJ->IDR;         \
+      (s).k = GPIOK->IDR;         \
+    } while (0)
+
+    #define SNAP_PIN_D00(s)   (((s).b & BIT07) != 0)
+    #define SNAP_PIN_D01(s)   (((s).a & BIT09) != 0)
+    #define SNAP_PIN_D02(s)   (((s).a & BIT03) != 0)
+    #define SNAP_PIN_D03(s)   (((s).a & BIT02) != 0)
+    #define SNAP_PIN_D04(s)   (((s).j & BIT08) != 0)
+    #define SNAP_PIN_D05(s)   (((s).a & BIT07) != 0)
+    #define SNAP_PIN_D06(s)   (((s).d & BIT13) != 0)
+    #define SNAP_PIN_D07(s)   (((s).b & BIT04) != 0)
+    #define SNAP_PIN_D08(s)   (((s).b & BIT08) != 0)
+    #define SNAP_PIN_D09(s)   (((s).b & BIT09) != 0)
+    #define SNAP_PIN_D10(s)   (((s).k & BIT01) != 0)
+    #define SNAP_PIN_D11(s)   (((s).j & BIT10) != 0)
+    #define SNAP_PIN_D12(s)   (((s).j & BIT11) != 0)
+    #define SNAP_PIN_D13(s)   (((s).h & BIT06) != 0)
+    #define SNAP_PIN_D14(s)   (((s).g & BIT14) != 0)
+    #define SNAP_PIN_D15(s)   (((s).c & BIT07) != 0)
+    #define SNAP_PIN_D16(s)   (((s).h & BIT13) != 0)
+    #define SNAP_PIN_D17(s)   (((s).i & BIT09) != 0)
+    #define SNAP_PIN_D18(s)   (((s).d & BIT05) != 0)
+    #define SNAP_PIN_D19(s)   (((s).d & BIT06) != 0)
+    #define SNAP_PIN_D20(s)   (((s).b & BIT11) != 0)
+    #define SNAP_PIN_D21(s)   (((s).h & BIT04) != 0)
+    #define SNAP_PIN_D22(s)   (((s).j & BIT12) != 0)
+    #define SNAP_PIN_D23(s)   (((s).g & BIT13) != 0)
+    #define SNAP_PIN_D24(s)   (((s).g & BIT12) != 0)
+    #define SNAP_PIN_D25(s)   (((s).j & BIT00) != 0)
+    #define SNAP_PIN_D26(s)   (((s).j & BIT14) != 0)
+    #define SNAP_PIN_D27(s)   (((s).j & BIT01) != 0)
+    #define SNAP_PIN_D28(s)   (((s).j & BIT15) != 0)
+    #define SNAP_PIN_D29(s)   (((s).j & BIT02) != 0)
+    #define SNAP_PIN_D30(s)   (((s).k & BIT03) != 0)
+    #define SNAP_PIN_D31(s)   (((s).j & BIT03) != 0)
+    #define SNAP_PIN_D32(s)   (((s).k & BIT04) != 0)
+    #define SNAP_PIN_D33(s)   (((s).j & BIT04) != 0)
+    #define SNAP_PIN_D34(s)   (((s).k & BIT05) != 0)
+    #define SNAP_PIN_D35(s)   (((s).j & BIT05) != 0)
+    #define SNAP_PIN_D36(s)   (((s).k & BIT06) != 0)
+    #define SNAP_PIN_D37(s)   (((s).j & BIT06) != 0)
+    #define SNAP_PIN_D38(s)   (((s).j & BIT07) != 0)
+    #define SNAP_PIN_D39(s)   (((s).i & BIT14) != 0)
+    #define SNAP_PIN_D40(s)   (((s).e & BIT06) != 0)
+    #define SNAP_PIN_D41(s)   (((s).k & BIT07) != 0)
+    #define SNAP_PIN_D42(s)   (((s).i & BIT15) != 0)
+    #define SNAP_PIN_D43(s)   (((s).i & BIT10) != 0)
+    #define SNAP_PIN_D44(s)   (((s).g & BIT10) != 0)
+    #define SNAP_PIN_D45(s)   (((s).i & BIT13) != 0)
+    #define SNAP_PIN_D46(s)   (((s).h & BIT15) != 0)
+    #define SNAP_PIN_D47(s)   (((s).b & BIT02) != 0)
+    #define SNAP_PIN_D48(s)   (((s).k & BIT00) != 0)
+    #define SNAP_PIN_D49(s)   (((s).e & BIT04) != 0)
+    #define SNAP_PIN_D50(s)   (((s).i & BIT11) != 0)
+    #define SNAP_PIN_D51(s)   (((s).e & BIT05) != 0)
+    #define SNAP_PIN_D52(s)   (((s).k & BIT02) != 0)
+    #define SNAP_PIN_D53(s)   (((s).g & BIT07) != 0)
+
+    #define SNAP_PIN_D84(s)   (((s).a & BIT04) != 0)
+    #define SNAP_PIN_D85(s)   (((s).a & BIT05) != 0)
+    #define SNAP_PIN_D93(s)   (((s).b & BIT05) != 0)
+    #define SNAP_PIN_D94(s)   (((s).b & BIT13) != 0)
+
+    #define SNAP_PIN_A0(s)    (((s).c & BIT04) != 0)
+    #define SNAP_PIN_A1(s)    (((s).c & BIT05) != 0)
+    #define SNAP_PIN_A2(s)    (((s).b & BIT00) != 0)
+    #define SNAP_PIN_A3(s)    (((s).b & BIT01) != 0)
+    #define SNAP_PIN_A4(s)    (((s).c & BIT03) != 0)
+    #define SNAP_PIN_A5(s)    (((s).c & BIT02) != 0)
+    #define SNAP_PIN_A6(s)    (((s).c & BIT00) != 0)
+    #define SNAP_PIN_A7(s)    (((s).a & BIT00) != 0)
+
+    #define SNAP_PIN_D76(s)   SNAP_PIN_A0(s)
+    #define SNAP_PIN_D77(s)   SNAP_PIN_A1(s)
+    #define SNAP_PIN_D78(s)   SNAP_PIN_A2(s)
+    #define SNAP_PIN_D79(s)   SNAP_PIN_A3(s)
+    #define SNAP_PIN_D80(s)   SNAP_PIN_A4(s)
+    #define SNAP_PIN_D81(s)   SNAP_PIN_A5(s)
+    #define SNAP_PIN_D82(s)   SNAP_PIN_A6(s)
+    #define SNAP_PIN_D83(s)   SNAP_PIN_A7(s)
+
+#else
+    // No snapshot support; fall back to live pin reads.
+    typedef struct { uint8_t unused; } PortSnapshot;
+    #define CAPTURE_PORT_SNAPSHOT(s)  do { (void)(s); } while (0)
+
+    #define SNAP_PIN_D00(s)   READ_PIN_D00
+    #define SNAP_PIN_D01(s)   READ_PIN_D01
+    #define SNAP_PIN_D02(s)   READ_PIN_D02
+    #define SNAP_PIN_D03(s)   READ_PIN_D03
+    #define SNAP_PIN_D04(s)   READ_PIN_D04
+    #define SNAP_PIN_D05(s)   READ_PIN_D05
+    #define SNAP_PIN_D06(s)   READ_PIN_D06
+    #define SNAP_PIN_D07(s)   READ_PIN_D07
+    #define SNAP_PIN_D08(s)   READ_PIN_D08
+    #define SNAP_PIN_D09(s)   READ_PIN_D09
+    #define SNAP_PIN_D10(s)   READ_PIN_D10
+    #define SNAP_PIN_D11(s)   READ_PIN_D11
+    #define SNAP_PIN_D12(s)   READ_PIN_D12
+    #define SNAP_PIN_D13(s)   READ_PIN_D13
+    #define SNAP_PIN_D14(s)   READ_PIN_D14
+    #define SNAP_PIN_D15(s)   READ_PIN_D15
+    #define SNAP_PIN_D16(s)   READ_PIN_D16
+    #define SNAP_PIN_D17(s)   READ_PIN_D17
+    #define SNAP_PIN_D18(s)   READ_PIN_D18
+    #define SNAP_PIN_D19(s)   READ_PIN_D19
+    #define SNAP_PIN_D20(s)   READ_PIN_D20
+    #define SNAP_PIN_D21(s)   READ_PIN_D21
+    #define SNAP_PIN_D22(s)   READ_PIN_D22
+    #define SNAP_PIN_D23(s)   READ_PIN_D23
+    #define SNAP_PIN_D24(s)   READ_PIN_D24
+    #define SNAP_PIN_D25(s)   READ_PIN_D25
+    #define SNAP_PIN_D26(s)   READ_PIN_D26
+    #define SNAP_PIN_D27(s)   READ_PIN_D27
+    #define SNAP_PIN_D28(s)   READ_PIN_D28
+    #define SNAP_PIN_D29(s)   READ_PIN_D29
+    #define SNAP_PIN_D30(s)   READ_PIN_D30
+    #define SNAP_PIN_D31(s)   READ_PIN_D31
+    #define SNAP_PIN_D32(s)   READ_PIN_D32
+    #define SNAP_PIN_D33(s)   READ_PIN_D33
+    #define SNAP_PIN_D34(s)   READ_PIN_D34
+    #define SNAP_PIN_D35(s)   READ_PIN_D35
+    #define SNAP_PIN_D36(s)   READ_PIN_D36
+    #define SNAP_PIN_D37(s)   READ_PIN_D37
+    #define SNAP_PIN_D38(s)   READ_PIN_D38
+    #define SNAP_PIN_D39(s)   READ_PIN_D39
+    #define SNAP_PIN_D40(s)   READ_PIN_D40
+    #define SNAP_PIN_D41(s)   READ_PIN_D41
+    #define SNAP_PIN_D42(s)   READ_PIN_D42
+    #define SNAP_PIN_D43(s)   READ_PIN_D43
+    #define SNAP_PIN_D44(s)   READ_PIN_D44
+    #define SNAP_PIN_D45(s)   READ_PIN_D45
+    #define SNAP_PIN_D46(s)   READ_PIN_D46
+    #define SNAP_PIN_D47(s)   READ_PIN_D47
+    #define SNAP_PIN_D48(s)   READ_PIN_D48
+    #define SNAP_PIN_D49(s)   READ_PIN_D49
+    #define SNAP_PIN_D50(s)   READ_PIN_D50
+    #define SNAP_PIN_D51(s)   READ_PIN_D51
+    #define SNAP_PIN_D52(s)   READ_PIN_D52
+    #define SNAP_PIN_D53(s)   READ_PIN_D53
+    #define SNAP_PIN_D84(s)   READ_PIN_D84
+    #define SNAP_PIN_D85(s)   READ_PIN_D85
+    #define SNAP_PIN_D93(s)   READ_PIN_D93
+    #define SNAP_PIN_D94(s)   READ_PIN_D94
+    #define SNAP_PIN_A0(s)    READ_PIN_A0
+    #define SNAP_PIN_A1(s)    READ_PIN_A1
+    #define SNAP_PIN_A2(s)    READ_PIN_A2
+    #define SNAP_PIN_A3(s)    READ_PIN_A3
+    #define SNAP_PIN_A4(s)    READ_PIN_A4
+    #define SNAP_PIN_A5(s)    READ_PIN_A5
+    #define SNAP_PIN_A6(s)    READ_PIN_A6
+    #define SNAP_PIN_A7(s)    READ_PIN_A7
+    #define SNAP_PIN_D76(s)   SNAP_PIN_A0(s)
+    #define SNAP_PIN_D77(s)   SNAP_PIN_A1(s)
+    #define SNAP_PIN_D78(s)   SNAP_PIN_A2(s)
+    #define SNAP_PIN_D79(s)   SNAP_PIN_A3(s)
+    #define SNAP_PIN_D80(s)   SNAP_PIN_A4(s)
+    #define SNAP_PIN_D81(s)   SNAP_PIN_A5(s)
+    #define SNAP_PIN_D82(s)   SNAP_PIN_A6(s)
+    #define SNAP_PIN_D83(s)   SNAP_PIN_A7(s)
+#endif
+
 #endif // _GPIO_PINS_H
\ No newline at end of file
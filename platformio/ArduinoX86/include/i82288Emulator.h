@@ -15,7 +15,7 @@
     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER   
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
     DEALINGS IN THE SOFTWARE.
@@ -25,27 +25,66 @@
 
 #include <BusTypes.h>
 
+// Packed 82288 output bits. A set bit means the line is asserted
+// (electrically low for the command outputs, high for ALE).
+constexpr uint8_t I82288_ALE  = 0x01;
+constexpr uint8_t I82288_MRDC = 0x02;
+constexpr uint8_t I82288_MWTC = 0x04;
+constexpr uint8_t I82288_IORC = 0x08;
+constexpr uint8_t I82288_IOWC = 0x10;
+constexpr uint8_t I82288_INTA = 0x20;
+
+// 82288 output state as a pure function of the latched status nibble
+// (S0, S1, M/IO, COD/INTA) and the current T-state, built at compile time
+// so tick() costs one table load instead of decoding the status with
+// branches every cycle. These emulated bits feed
+// readBusControllerCommandLines() in the cycle hot loop.
+//
+// T1 raises ALE with all commands inactive; TS/TC (modeled as T2 here)
+// asserts the command decoded from the latch and holds it through wait
+// states until READY completes the cycle.
+struct I82288CmdTable {
+  uint8_t v[16][6];
+
+  constexpr I82288CmdTable() : v{} {
+    for (int status = 0; status < 16; status++) {
+      uint8_t cmd = 0;
+      switch (status) {
+        case 0b0000: cmd = I82288_INTA; break;
+        case 0b1001: cmd = I82288_IORC; break;
+        case 0b1010: cmd = I82288_IOWC; break;
+        case 0b0101: // FALLTHRU (CODE)
+        case 0b1101: cmd = I82288_MRDC; break;
+        case 0b0110: cmd = I82288_MWTC; break;
+        default: break; // HALT and PASV assert nothing.
+      }
+      v[status][TI] = 0;
+      v[status][T1] = I82288_ALE;
+      v[status][T2] = cmd;
+      // The 82288 state machine never leaves TI/T1/T2; zero the rest.
+      v[status][T3] = 0;
+      v[status][T4] = 0;
+      v[status][TW] = 0;
+    }
+  }
+};
+
+constexpr I82288CmdTable I82288_CMD{};
+
 /// @brief BusController emulates the Intel 82288 bus controller.
 class BusController {
 
   public:
-    BusController()
-      : ale_(false), mrdc_(true), iorc_(true), mwtc_(true), iowc_(true), inta_(true) {
-        last_status_ = 0x03; // Start in passive state
-      }
+    BusController() {
+      reset();
+    }
 
   private:
-    uint8_t last_status_; // S0-S1, M/IO and COD/INTA of previous cycle
-    uint8_t status_; // S0-S1, M/IO and COD/INTA of current cycle
-    uint8_t status_latch_;
-    TCycle t_cycle_;
-
-    bool ale_;
-    bool mrdc_;
-    bool iorc_;
-    bool mwtc_;
-    bool iowc_;
-    bool inta_;
+    uint8_t last_status_ = 0x03; // S0-S1, M/IO and COD/INTA of previous cycle
+    uint8_t status_ = 0x03;      // S0-S1, M/IO and COD/INTA of current cycle
+    uint8_t status_latch_ = 0x03;
+    TCycle t_cycle_ = TI;
+    uint8_t cmd_ = 0; // Packed output state (I82288_* bits)
 
   public:
     uint8_t status() const {
@@ -53,66 +92,24 @@ class BusController {
     }
 
     void reset() {
-      ale_ = false;
-      mrdc_ = true;
-      iorc_ = true;
-      mwtc_ = true;
-      iowc_ = true;
-      inta_ = true;
       last_status_ = 0x03;
       status_ = 0x03;
       status_latch_ = 0x03;
       t_cycle_ = TI;
+      cmd_ = 0;
     }
 
     void tick(uint8_t new_status, bool ready) {
-
       last_status_ = status_;
       status_ = new_status;
 
       switch (t_cycle_) {
-        case TI:
-          break;
         case T1:
-          ale_ = false;
           t_cycle_ = T2;
-          switch(status_latch_ & 0x0F) {
-            case 0b0000:
-              inta_ = false;
-              break;
-            case 0b1001:
-              iorc_ = false;
-              break;
-            case 0b1010:
-              iowc_ = false;
-              break;
-            case 0b1101: // FALLTHRU (CODE)
-            case 0b0101:
-              mrdc_ = false;
-              break;
-            case 0b0110:
-              mwtc_ = false;
-              break;          
-            case 0b0111: // FALLTHRU (PASV)
-            case 0b1111:
-              iorc_ = true;
-              iowc_ = true;
-              mrdc_ = true;
-              mwtc_ = true;  
-              inta_ = true;
-              break;
-            default:
-              break;       
-          }
           break;
         case T2:
-          if(ready) {
+          if (ready) {
             // If READY is high we can complete the bus cycle.
-            iorc_ = true;
-            iowc_ = true;
-            mrdc_ = true;
-            mwtc_ = true;  
-            inta_ = true;
             t_cycle_ = TI;
           }
           break;
@@ -121,27 +118,31 @@ class BusController {
       }
 
       if ((last_status_ & 0x03) == 0x03 && (status_ & 0x03) != 0x03) {
-        // We started a bus cycle; enter T1 and set ALE
-        ale_ = true;
+        // We started a bus cycle; enter T1 (the table raises ALE there).
         t_cycle_ = T1;
         status_latch_ = status_;
       }
+
+      cmd_ = I82288_CMD.v[status_latch_ & 0x0F][t_cycle_];
     }
 
-    bool mrdc() {
-      return mrdc_;
+    // Command accessors return the electrical (active-low) pin level.
+    bool mrdc() const {
+      return (cmd_ & I82288_MRDC) == 0;
     }
-    bool iorc() {
-      return iorc_;
+    bool iorc() const {
+      return (cmd_ & I82288_IORC) == 0;
     }
-    bool mwtc() {
-      return mwtc_;
+    bool mwtc() const {
+      return (cmd_ & I82288_MWTC) == 0;
     }
-    bool iowc() {
-      return iowc_;
+    bool iowc() const {
+      return (cmd_ & I82288_IOWC) == 0;
     }
-    bool inta() {
-      return inta_;
+    bool inta() const {
+      return (cmd_ & I82288_INTA) == 0;
     }
-
-};
\ No newline at end of file
+    bool ale() const {
+      return (cmd_ & I82288_ALE) != 0;
+    }
+};
@@ -15,7 +15,7 @@
     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER   
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
     DEALINGS IN THE SOFTWARE.
@@ -25,28 +25,66 @@
 
 #include <BusTypes.h>
 
+// Packed 8288 output bits. The command bit order matches
+// readBusControllerCommandLines() so the packed byte can feed the protocol
+// directly; ALE rides in an otherwise unused bit.
+constexpr uint8_t I8288_MRDC  = 0x01;
+constexpr uint8_t I8288_AMWC  = 0x02;
+constexpr uint8_t I8288_MWTC  = 0x04;
+constexpr uint8_t I8288_IORC  = 0x08;
+constexpr uint8_t I8288_AIOWC = 0x10;
+constexpr uint8_t I8288_IOWC  = 0x20;
+constexpr uint8_t I8288_ALE   = 0x40;
+
+// 8288 output state as a pure function of the latched bus status and the
+// current T-state, built at compile time so tick() costs one table load
+// instead of re-deriving the lines with branches every cycle.
+//
+// Per T-state: T1 raises ALE only; T2 asserts the advanced/read commands
+// (MRDC for CODE/MEMR, IORC, AMWC, AIOWC); T3 adds the delayed write
+// commands (MWTC, IOWC); T4 and idle drop everything. TW mirrors T3 so the
+// asserted commands hold through wait states.
+struct I8288CmdTable {
+  uint8_t v[8][6];
+
+  constexpr I8288CmdTable() : v{} {
+    for (int status = 0; status < 8; status++) {
+      uint8_t first = 0;  // Asserted from T2
+      uint8_t second = 0; // Asserted from T3
+      switch (status) {
+        case IOR:  first = I8288_IORC; break;
+        case IOW:  first = I8288_AIOWC; second = I8288_IOWC; break;
+        case MEMW: first = I8288_AMWC;  second = I8288_MWTC; break;
+        case CODE: first = I8288_MRDC; break;
+        case MEMR: first = I8288_MRDC; break;
+        default: break; // INTA, HALT, PASV assert no command lines.
+      }
+      v[status][TI] = 0;
+      v[status][T1] = I8288_ALE;
+      v[status][T2] = first;
+      v[status][T3] = (uint8_t)(first | second);
+      v[status][T4] = 0;
+      v[status][TW] = (uint8_t)(first | second);
+    }
+  }
+};
+
+constexpr I8288CmdTable I8288_CMD{};
+
 /// @brief BusController emulates a bus controller such as the Intel 8288.
 class BusController {
 
   public:
-    bool ale;
-    bool mrdc;
-    bool amwc;
-    bool iorc;
-    bool mwtc;
-    bool aiowc;
-    bool iowc;
-
-    BusController() 
-      : ale(false), mrdc(false), amwc(false), iorc(false), mwtc(false), aiowc(false), iowc(false) {
-        last_status_ = PASV; // Start in passive state
-      }
+    BusController() {
+      reset();
+    }
 
   private:
-    BusStatus last_status_; // S0-S2 of previous cycle
-    BusStatus status_; // S0-S2 of current cycle
-    BusStatus status_latch_;
-    TCycle t_cycle_;
+    BusStatus last_status_ = PASV; // S0-S2 of previous cycle
+    BusStatus status_ = PASV;      // S0-S2 of current cycle
+    BusStatus status_latch_ = PASV;
+    TCycle t_cycle_ = TI;
+    uint8_t cmd_ = 0; // Packed output state (I8288_* bits)
 
   public:
     BusStatus status() const {
@@ -54,91 +92,43 @@ class BusController {
     }
 
     void reset() {
-      ale = false;
-      mrdc = false;
-      amwc = false;
-      iorc = false;
-      mwtc = false;
-      aiowc = false;
-      iowc = false;
-
       last_status_ = PASV;
       status_ = PASV;
       status_latch_ = PASV;
       t_cycle_ = TI;
+      cmd_ = 0;
     }
 
     void tick(BusStatus new_status) {
-      
       last_status_ = status_;
       status_ = new_status;
 
       // TODO: Handle wait states
       switch (t_cycle_) {
-        case TI:
-          break;
-        case T1:
-          ale = false;
-          t_cycle_ = T2;
-          switch(status_latch_) {
-              case IOR:
-                iorc = true;
-                break;
-              case IOW:
-                // Set AIOWC line on T3, IOWC is delayed to T3
-                aiowc = true;
-                break;
-              case MEMW:
-                // Set AMWC line on T2, MWTC is delayed to T3
-                amwc = true;
-                break;
-              case CODE:
-                mrdc = true;
-                break;          
-              case MEMR:
-                mrdc = true;
-                break;           
-              default:
-                break;       
-          }
-          break;
-        case T2:
-          t_cycle_ = T3;
-            switch(status_latch_) {
-              case INTA:
-                break;
-              case IOW:
-                iowc = true;
-                break;
-              case MEMW:
-                mwtc = true;
-                break;
-              default:
-                break;
-            }        
-          break;
-        case T3:
-          t_cycle_ = T4;
-          iorc = false;
-          amwc = false;
-          iowc = false;
-          mrdc = false;
-          aiowc = false;
-          mwtc = false;     
-          break;
-        case TW:
-          break;
-        case T4:
-          t_cycle_ = TI;
-          break;
+        case T1: t_cycle_ = T2; break;
+        case T2: t_cycle_ = T3; break;
+        case T3: t_cycle_ = T4; break;
+        case T4: t_cycle_ = TI; break;
+        default: break;
       }
 
       if (last_status_ == PASV && status_ != PASV) {
-        // We started a bus cycle; enter t1 and set ALE
-        ale = true;
+        // We started a bus cycle; enter T1 (the table raises ALE there).
         t_cycle_ = T1;
         status_latch_ = status_;
       }
+
+      cmd_ = I8288_CMD.v[status_latch_][t_cycle_];
     }
 
-};
\ No newline at end of file
+    /// @brief The packed output state (I8288_* bits) for the current cycle.
+    uint8_t command_bits() const { return cmd_; }
+
+    bool ale() const   { return (cmd_ & I8288_ALE) != 0; }
+    bool mrdc() const  { return (cmd_ & I8288_MRDC) != 0; }
+    bool amwc() const  { return (cmd_ & I8288_AMWC) != 0; }
+    bool iorc() const  { return (cmd_ & I8288_IORC) != 0; }
+    bool mwtc() const  { return (cmd_ & I8288_MWTC) != 0; }
+    bool aiowc() const { return (cmd_ & I8288_AIOWC) != 0; }
+    bool iowc() const  { return (cmd_ & I8288_IOWC) != 0; }
+};
@@ -25,4 +25,9 @@
 
 void ale_interrupt_handler();
 void readyo_interrupt_handler();
-void cycle_edge_interrupt_handler();
\ No newline at end of file
+void cycle_edge_interrupt_handler();
+void free_run_ale_handler();
+
+// Set by free_run_ale_handler() when a bus cycle has been frozen with wait
+// states and is waiting to be serviced by the main loop.
+extern volatile bool free_run_cycle_pending;
\ No newline at end of file
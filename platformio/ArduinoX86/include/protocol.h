@@ -0,0 +1,244 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Wire-level definitions for the client-server protocol: the command opcodes
+// and how many parameter bytes each command expects. These live outside
+// CommandServer so the M4 protocol front end (src/m4) can frame commands
+// without pulling in the board and shield headers.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+
+enum class ServerCommand {
+  CmdNone            = 0x00,
+  CmdVersion         = 0x01,
+  CmdResetCpu        = 0x02,
+  CmdLoad            = 0x03,
+  CmdCycle           = 0x04,
+  CmdReadAddressLatch= 0x05,
+  CmdReadStatus      = 0x06,
+  CmdRead8288Command = 0x07,
+  CmdRead8288Control = 0x08,
+  CmdReadDataBus     = 0x09,
+  CmdWriteDataBus    = 0x0A,
+  CmdFinalize        = 0x0B,
+  CmdBeginStore      = 0x0C,
+  CmdStore           = 0x0D,
+  CmdQueueLen        = 0x0E,
+  CmdQueueBytes      = 0x0F,
+  CmdWritePin        = 0x10,
+  CmdReadPin         = 0x11,
+  CmdGetProgramState = 0x12,
+  CmdLastError       = 0x13,
+  CmdGetCycleState   = 0x14,
+  CmdAvailable00     = 0x15,
+  CmdPrefetchStore   = 0x16,
+  CmdReadAddress     = 0x17,
+  CmdCpuType         = 0x18,
+  CmdSetFlags        = 0x19,
+  CmdPrefetch        = 0x1A,
+  CmdInitScreen      = 0x1B,
+  CmdStoreAll        = 0x1C,
+  CmdSetRandomSeed   = 0x1D,
+  CmdRandomizeMem    = 0x1E,
+  CmdSetMemory       = 0x1F,
+  CmdGetCycleStates  = 0x20,
+  CmdEnableDebug     = 0x21,
+  CmdSetMemoryStrategy = 0x22,
+  CmdGetFlags        = 0x23,
+  CmdReadMemory      = 0x24,
+  CmdEraseMemory     = 0x25,
+  CmdServerStatus    = 0x26,
+  CmdClearCycleLog   = 0x27,
+  CmdSetProgramBounds = 0x28,
+  CmdCycleBatch      = 0x29,
+  CmdUploadMemory    = 0x2A,
+  CmdRunBatch        = 0x2B,
+  CmdGetCycleStatesC = 0x2C,
+  CmdSetSocketGen    = 0x2D,
+  CmdSnapshotMemory  = 0x2E,
+  CmdRestoreSnapshot = 0x2F,
+  CmdGetTraceMeta    = 0x30,
+  CmdSetWatchpoint   = 0x31,
+  CmdGetWatchHit     = 0x32,
+  CmdGetCycleStatesFrom = 0x33,
+  CmdCrcMemory       = 0x34,
+  CmdGetBusOps       = 0x35,
+  CmdSetBusLogCapacity = 0x36,
+  CmdStreamMemory    = 0x37,
+  CmdSetWaitStates   = 0x38,
+  CmdSetIntVector    = 0x39,
+  CmdSetPortHandler  = 0x3A,
+  CmdGenProgram      = 0x3B,
+  CmdSetReadyTimer   = 0x3C,
+  CmdSetProfile      = 0x3D,
+  CmdGetStateProfile = 0x3E,
+  CmdSetPinInject    = 0x3F,
+  CmdSetFpuStub      = 0x40,
+  CmdSetRefresh      = 0x41,
+  CmdGetFullState    = 0x42,
+  CmdGetTestResult   = 0x43,
+  CmdInvalid
+};
+
+/// @brief Number of defined command opcodes, including CmdInvalid.
+constexpr size_t SERVER_COMMAND_COUNT = static_cast<size_t>(ServerCommand::CmdInvalid) + 1;
+
+/// @brief Fixed parameter byte counts, indexed by ServerCommand. Both cores
+/// must agree on these counts: the M4 front end uses them to frame commands,
+/// and CommandServer uses them to size its parameter reads. The table is
+/// constexpr so lookups are a single indexed load on the hot parse path,
+/// alongside the dispatch switch in CommandServer. Order must match the
+/// ServerCommand enum exactly.
+constexpr std::array<uint8_t, SERVER_COMMAND_COUNT> SERVER_COMMAND_PARAM_BYTES = {{
+    0,  // CmdNone
+    0,  // CmdVersion
+    0,  // CmdResetCpu
+    1,  // CmdLoad: Type of register file to load
+    1,  // CmdCycle: Number of cycles to execute
+    0,  // CmdReadAddressLatch
+    0,  // CmdReadStatus
+    0,  // CmdRead8288Command
+    0,  // CmdRead8288Control
+    0,  // CmdReadDataBus
+    2,  // CmdWriteDataBus: 16-bit value to write
+    0,  // CmdFinalize
+    0,  // CmdBeginStore
+    0,  // CmdStore
+    0,  // CmdQueueLen
+    0,  // CmdQueueBytes
+    2,  // CmdWritePin: Pin to write, value to write
+    1,  // CmdReadPin: Pin to read
+    0,  // CmdGetProgramState
+    0,  // CmdLastError
+    1,  // CmdGetCycleState: Flags. Bit 0 set to 1 will cycle CPU first
+    0,  // CmdAvailable00 (null)
+    0,  // CmdPrefetchStore
+    0,  // CmdReadAddress
+    0,  // CmdCpuType
+    4,  // CmdSetFlags: uint32_t flags to set
+    0,  // CmdPrefetch
+    0,  // CmdInitScreen
+    0,  // CmdStoreAll
+    4,  // CmdSetRandomSeed: uint32_t seed for randomization
+    4,  // CmdRandomizeMem: uint32_t seed for randomization
+    8,  // CmdSetMemory: address (4 bytes) and size (4 bytes)
+    0,  // CmdGetCycleStates
+    1,  // CmdEnableDebug: 0 to disable debug, 1 to enable debug
+    9,  // CmdSetMemoryStrategy: Strategy (1 byte; bit 7 appends a region), start_addr (4 bytes), end_addr (4 bytes)
+    0,  // CmdGetFlags
+    8,  // CmdReadMemory: address (4 bytes) and size (4 bytes)
+    0,  // CmdEraseMemory
+    0,  // CmdServerStatus
+    0,  // CmdClearCycleLog
+    8,  // CmdSetProgramBounds: start_addr (4 bytes), end_addr (4 bytes)
+    2,  // CmdCycleBatch: Number of cycles to execute (16-bit)
+    8,  // CmdUploadMemory: address (4 bytes) and size (4 bytes). Payload + CRC32 streamed after.
+    3,  // CmdRunBatch: test count (2 bytes), register type (1 byte). Test records streamed after.
+    0,  // CmdGetCycleStatesC
+    4,  // CmdSetSocketGen: uint32_t socket generation counter
+    0,  // CmdSnapshotMemory
+    0,  // CmdRestoreSnapshot
+    0,  // CmdGetTraceMeta
+    10, // CmdSetWatchpoint: index (1 byte), op class mask (1 byte), start (4 bytes), end (4 bytes)
+    0,  // CmdGetWatchHit
+    4,  // CmdGetCycleStatesFrom: uint32_t read cursor from the previous fetch
+    8,  // CmdCrcMemory: address (4 bytes) and size (4 bytes)
+    0,  // CmdGetBusOps
+    4,  // CmdSetBusLogCapacity: uint32_t ring capacity in entries
+    8,  // CmdStreamMemory: address (4 bytes) and size (4 bytes)
+    10, // CmdSetWaitStates: space (1 byte), start (4 bytes), end (4 bytes), wait count (1 byte)
+    2,  // CmdSetIntVector: mode (1 byte), vector (1 byte)
+    24, // CmdSetPortHandler: index (1 byte), kind (1 byte), start (2 bytes), end (2 bytes), value (1 byte), script length (1 byte), script (16 bytes)
+    11, // CmdGenProgram: seed (4 bytes), address (4 bytes), length (2 bytes), class mask (1 byte)
+    4,  // CmdSetReadyTimer: deassert window in timer ticks (4 bytes); 0 disables
+    2,  // CmdSetProfile: op (1 byte: 0=save, 1=erase, 2=apply), slot (1 byte)
+    1,  // CmdGetStateProfile: op (1 byte: 0=read, 1=read+reset, 2=reset)
+    10, // CmdSetPinInject: slot (1 byte; 0xFF clears all), pin (1 byte), assert cycle (4 bytes), deassert cycle (4 bytes)
+    5,  // CmdSetFpuStub: mode (1 byte: 0=off, 1=busy-high, 2=busy-low), busy window in cycles (4 bytes)
+    8,  // CmdSetRefresh: period in cycles (4 bytes; 0 disables), HOLD duration in cycles (4 bytes)
+    0,  // CmdGetFullState
+    1,  // CmdGetTestResult: flags (1 byte; bit 0 includes dirtied memory words)
+    0,  // CmdInvalid
+}};
+
+/// @brief Get the number of fixed parameter bytes the client sends for a command.
+/// @param cmd
+/// @return The number of input bytes expected for the command
+inline uint8_t server_command_param_bytes(ServerCommand cmd) {
+    const size_t idx = static_cast<size_t>(cmd);
+    return (idx < SERVER_COMMAND_PARAM_BYTES.size()) ? SERVER_COMMAND_PARAM_BYTES[idx] : 0;
+}
+
+/// @brief Returns true for commands that stream a variable-length payload after
+/// their fixed parameter bytes (register files, memory images). The M4 front
+/// end passes payload bytes through raw rather than trying to frame them.
+inline bool server_command_streams_payload(ServerCommand cmd) {
+    switch(cmd) {
+        case ServerCommand::CmdLoad:         // Register file, sized by CPU type.
+        case ServerCommand::CmdSetMemory:    // Memory payload.
+        case ServerCommand::CmdUploadMemory: // Memory payload + CRC32 trailer.
+        case ServerCommand::CmdRunBatch:     // Per-test register + program records.
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Framed protocol v2 (opt-in via CommandServer FLAG_FRAMED_PROTOCOL).
+//
+// The classic protocol is an unframed command byte plus a fixed parameter
+// count with no integrity check: a single dropped byte desynchronizes the
+// session permanently. In framed mode the host sends each command as:
+//
+//   [SOF] [seq] [len] [cmd] [param bytes...] [crc16 lo] [crc16 hi]
+//
+// where `len` counts the command byte plus its parameter bytes and the
+// CRC-16/CCITT (poly 0x1021, init 0xFFFF) covers seq through the last
+// parameter byte. Response payloads are unchanged, but the trailing status
+// byte is followed by the frame's sequence number, so the host may queue
+// multiple frames before reading responses and match each status trailer to
+// the frame that produced it. Commands that stream a variable-length payload
+// (see server_command_streams_payload) send the payload raw after the frame,
+// exactly as in the classic protocol. A corrupted frame is answered with a
+// failure trailer and the parser resynchronizes on the next SOF byte.
+constexpr uint8_t PROTO_FRAME_SOF = 0x5B;
+constexpr uint16_t PROTO_CRC16_INIT = 0xFFFF;
+
+/// @brief Update a CRC-16/CCITT over a span of frame bytes.
+/// @param crc Running CRC, seeded with PROTO_CRC16_INIT.
+/// @param data Bytes to fold in.
+/// @param len Number of bytes.
+/// @return The updated CRC.
+inline uint16_t proto_crc16_update(uint16_t crc, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
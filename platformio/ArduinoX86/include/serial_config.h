@@ -23,15 +23,53 @@
 
 #pragma once
 
-#define PACKET_SIZE 64 // Size of the packet buffer
+#include <config.h>
 
-#if defined(__SAM3X8E__) // If Arduino DUE
+// Size of the packet buffer. The Giga's USB CDC stack accepts large writes
+// cheaply, so it stages well above the 64-byte full-speed packet size.
+// Response coalescing is sized separately, per board, via
+// BoardTraits::_PROTO_TX_BUF.
+#if defined(ARDUINO_GIGA)
+#define PACKET_SIZE 512
+#else
+#define PACKET_SIZE 64
+#endif
+
+// DEBUG_SERIAL routes through the DebugRing staging ring (DebugRingSerial.h)
+// so debug output never blocks the cycle loop; DEBUG_HW_SERIAL is the
+// underlying hardware port the ring drains to. The M4 protocol front end
+// keeps the raw port: it has no cycle loop to protect and no drain hook.
+#if defined(CORE_CM4) // Arduino GIGA, Cortex-M4 core
+  #define INBAND_SERIAL Serial
+  #define DEBUG_SERIAL Serial2
+  #define FLUSH
+#elif defined(__SAM3X8E__) // If Arduino DUE
   #define INBAND_SERIAL SerialUSB
-  #define DEBUG_SERIAL Serial1
+  #define DEBUG_HW_SERIAL Serial1
+  #define DEBUG_SERIAL DebugRing
   #define FLUSH SERIAL.flush()
-#elif defined(ARDUINO_GIGA) // If Arduino GIGA
+  #include <DebugRingSerial.h>
+#elif defined(ARDUINO_GIGA) // If Arduino GIGA, Cortex-M7 core
   #define INBAND_SERIAL Serial
-  #define DEBUG_SERIAL Serial2
-  #define FLUSH 
+  #define DEBUG_HW_SERIAL Serial2
+  #define DEBUG_SERIAL DebugRing
+  #define FLUSH
+  #include <DebugRingSerial.h>
+#endif
+
+// TRACE_SERIAL carries bulk trace streams (CycleStateLogger and BusLogger
+// dumps). By default it aliases INBAND_SERIAL, preserving the classic
+// single-channel wire format. With USE_TRACE_SERIAL=1 on the Giga, traces
+// move to a second CDC interface registered on the composite USB device, so
+// the host can drain one test's trace while the command channel runs the
+// next. TRACE_SERIAL_DEDICATED marks builds where the channels are distinct.
+#if USE_TRACE_SERIAL && defined(ARDUINO_GIGA) && !defined(CORE_CM4)
+  #include <PluggableUSBSerial.h>
+  extern arduino::USBSerial SerialTrace;
+  #define TRACE_SERIAL SerialTrace
+  #define TRACE_SERIAL_DEDICATED 1
+#else
+  #define TRACE_SERIAL INBAND_SERIAL
+  #define TRACE_SERIAL_DEDICATED 0
 #endif
 
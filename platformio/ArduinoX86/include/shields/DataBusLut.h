@@ -0,0 +1,155 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <Arduino.h>
+
+// Precomputed scatter/gather tables for the data bus GPIO encode/decode.
+//
+// Every shield routes data bus bits D0-D15 to Arduino pins D22-D37, which the
+// Giga scatters across GPIOJ, GPIOG and GPIOK in no useful order. Assembling
+// the bus value bit-by-bit costs a chain of 16 test-and-OR steps, executed
+// twice per bus cycle. The tables below translate each involved 8-bit port
+// lane to its data-bus contribution (and a data byte back to a port BSRR
+// word), so a full 16-bit read is four table loads and three ORs, and a write
+// is one BSRR store per port. The tables are generated constexpr from the
+// same pin mapping gpio_pins.h encodes, so they live in flash and cost
+// nothing at startup.
+//
+// The Due scatters the same pins across four PIO ports at arbitrary bit
+// positions up to bit 26, which would need shifted lanes per port; it keeps
+// the bitwise path.
+
+#if defined(ARDUINO_GIGA)
+
+// One data-bus bit carried by one bit of an 8-bit port input lane.
+struct DbusLanePin {
+  uint8_t lane_bit;   // Bit position within the IDR lane
+  uint16_t data_mask; // Data-bus bit this lane bit carries
+};
+
+// Gather table: 8-bit port lane value -> partial data-bus value.
+struct DbusReadLut {
+  uint16_t v[256];
+  template<size_t N>
+  constexpr DbusReadLut(const DbusLanePin (&pins)[N]) : v{} {
+    for (size_t i = 0; i < 256; i++) {
+      uint16_t out = 0;
+      for (size_t p = 0; p < N; p++) {
+        if (i & (1u << pins[p].lane_bit)) {
+          out |= pins[p].data_mask;
+        }
+      }
+      v[i] = out;
+    }
+  }
+};
+
+// One port bit driven by one bit of an 8-bit data-bus lane.
+struct DbusWritePin {
+  uint8_t data_bit; // Bit position within the data byte
+  uint8_t port_bit; // GPIO port bit it drives
+};
+
+// Scatter table: data byte -> port BSRR word (set bits low, reset bits high).
+struct DbusWriteLut {
+  uint32_t v[256];
+  template<size_t N>
+  constexpr DbusWriteLut(const DbusWritePin (&pins)[N]) : v{} {
+    for (size_t i = 0; i < 256; i++) {
+      uint32_t bsrr = 0;
+      for (size_t p = 0; p < N; p++) {
+        if (i & (1u << pins[p].data_bit)) {
+          bsrr |= (1ul << pins[p].port_bit);
+        }
+        else {
+          bsrr |= (1ul << (pins[p].port_bit + 16));
+        }
+      }
+      v[i] = bsrr;
+    }
+  }
+};
+
+// Pin mapping from gpio_pins.h (D22-D37, identical for every shield):
+//   D0=J12  D1=G13  D2=G12  D3=J0   D4=J14  D5=J1   D6=J15  D7=J2
+//   D8=K3   D9=J3   D10=K4  D11=J4  D12=K5  D13=J5  D14=K6  D15=J6
+
+constexpr DbusLanePin DBUS_PINS_J_LO[] = {
+  {0, 0x0008}, {1, 0x0020}, {2, 0x0080}, {3, 0x0200},
+  {4, 0x0800}, {5, 0x2000}, {6, 0x8000},
+};
+constexpr DbusLanePin DBUS_PINS_J_HI[] = { {4, 0x0001}, {6, 0x0010}, {7, 0x0040} };
+constexpr DbusLanePin DBUS_PINS_G_HI[] = { {4, 0x0004}, {5, 0x0002} };
+constexpr DbusLanePin DBUS_PINS_K_LO[] = { {3, 0x0100}, {4, 0x0400}, {5, 0x1000}, {6, 0x4000} };
+
+constexpr DbusReadLut DBUS_RD_J_LO(DBUS_PINS_J_LO);
+constexpr DbusReadLut DBUS_RD_J_HI(DBUS_PINS_J_HI);
+constexpr DbusReadLut DBUS_RD_G_HI(DBUS_PINS_G_HI);
+constexpr DbusReadLut DBUS_RD_K_LO(DBUS_PINS_K_LO);
+
+// Write tables: the low data byte lands on GPIOJ and GPIOG, the high byte on
+// GPIOK and GPIOJ.
+constexpr DbusWritePin DBUS_WPINS_LO_J[] = {
+  {0, 12}, {3, 0}, {4, 14}, {5, 1}, {6, 15}, {7, 2},
+};
+constexpr DbusWritePin DBUS_WPINS_LO_G[] = { {1, 13}, {2, 12} };
+constexpr DbusWritePin DBUS_WPINS_HI_K[] = { {0, 3}, {2, 4}, {4, 5}, {6, 6} };
+constexpr DbusWritePin DBUS_WPINS_HI_J[] = { {1, 3}, {3, 4}, {5, 5}, {7, 6} };
+
+constexpr DbusWriteLut DBUS_WR_LO_J(DBUS_WPINS_LO_J);
+constexpr DbusWriteLut DBUS_WR_LO_G(DBUS_WPINS_LO_G);
+constexpr DbusWriteLut DBUS_WR_HI_K(DBUS_WPINS_HI_K);
+constexpr DbusWriteLut DBUS_WR_HI_J(DBUS_WPINS_HI_J);
+
+/// @brief Gather the full 16-bit data bus from the GPIO input registers.
+inline uint16_t dbusRead16() {
+  uint32_t j = GPIOJ->IDR;
+  return DBUS_RD_J_LO.v[j & 0xFF]
+       | DBUS_RD_J_HI.v[(j >> 8) & 0xFF]
+       | DBUS_RD_G_HI.v[(GPIOG->IDR >> 8) & 0xFF]
+       | DBUS_RD_K_LO.v[GPIOK->IDR & 0xFF];
+}
+
+/// @brief Scatter the low data byte (D0-D7) onto the bus pins.
+inline void dbusWriteLow(uint16_t data) {
+  GPIOJ->BSRR = DBUS_WR_LO_J.v[data & 0xFF];
+  GPIOG->BSRR = DBUS_WR_LO_G.v[data & 0xFF];
+}
+
+/// @brief Scatter the high data byte (D8-D15) onto the bus pins.
+inline void dbusWriteHigh(uint16_t data) {
+  GPIOJ->BSRR = DBUS_WR_HI_J.v[(data >> 8) & 0xFF];
+  GPIOK->BSRR = DBUS_WR_HI_K.v[(data >> 8) & 0xFF];
+}
+
+/// @brief Scatter a full 16-bit value onto the bus pins, one BSRR store per
+/// port.
+inline void dbusWrite16(uint16_t data) {
+  GPIOJ->BSRR = DBUS_WR_LO_J.v[data & 0xFF] | DBUS_WR_HI_J.v[(data >> 8) & 0xFF];
+  GPIOG->BSRR = DBUS_WR_LO_G.v[data & 0xFF];
+  GPIOK->BSRR = DBUS_WR_HI_K.v[(data >> 8) & 0xFF];
+}
+
+#endif // ARDUINO_GIGA
@@ -32,6 +32,7 @@ void cycle();
 #include <BusTypes.h>
 #include <shields/ShieldBase.h>
 #include <shields/Pins.h>
+#include <shields/DataBusLut.h>
 #include <DebugFilter.h>
 
 #define CPU_386
@@ -216,6 +217,45 @@ void cycle();
 #define READ_ABUS_22 READ_PIN_D00
 #define READ_ABUS_23 READ_PIN_D01
 
+// Snapshot equivalents of the pin decode macros above, reading from a
+// PortSnapshot captured at the clock edge.
+#define SNAP_ALE_PIN(s)  (!SNAP_PIN_D09(s))
+#define SNAP_BHE_PIN(s)  SNAP_PIN_D13(s)
+#define SNAP_LOCK_PIN(s) SNAP_PIN_D07(s)
+#define SNAP_RW_PIN(s)   SNAP_PIN_D82(s)
+#define SNAP_DC_PIN(s)   SNAP_PIN_D08(s)
+#define SNAP_M_IO_PIN(s) SNAP_PIN_D10(s)
+
+#define SNAP_MRDC_PIN(s) (!(!SNAP_PIN_A5(s) && SNAP_M_IO_PIN(s)))
+#define SNAP_MWTC_PIN(s) (!(!SNAP_PIN_A4(s) && SNAP_M_IO_PIN(s)))
+#define SNAP_IORC_PIN(s) (!(!SNAP_PIN_A5(s) && !SNAP_M_IO_PIN(s)))
+#define SNAP_IOWC_PIN(s) (!(!SNAP_PIN_A4(s) && !SNAP_M_IO_PIN(s)))
+
+#define SNAP_ABUS_00(s) SNAP_PIN_D38(s)
+#define SNAP_ABUS_01(s) SNAP_PIN_D39(s)
+#define SNAP_ABUS_02(s) SNAP_PIN_D40(s)
+#define SNAP_ABUS_03(s) SNAP_PIN_D41(s)
+#define SNAP_ABUS_04(s) SNAP_PIN_D42(s)
+#define SNAP_ABUS_05(s) SNAP_PIN_D43(s)
+#define SNAP_ABUS_06(s) SNAP_PIN_D44(s)
+#define SNAP_ABUS_07(s) SNAP_PIN_D45(s)
+#define SNAP_ABUS_08(s) SNAP_PIN_D46(s)
+#define SNAP_ABUS_09(s) SNAP_PIN_D47(s)
+#define SNAP_ABUS_10(s) SNAP_PIN_D48(s)
+#define SNAP_ABUS_11(s) SNAP_PIN_D49(s)
+#define SNAP_ABUS_12(s) SNAP_PIN_D50(s)
+#define SNAP_ABUS_13(s) SNAP_PIN_D51(s)
+#define SNAP_ABUS_14(s) SNAP_PIN_D52(s)
+#define SNAP_ABUS_15(s) SNAP_PIN_D53(s)
+#define SNAP_ABUS_16(s) SNAP_PIN_D21(s)
+#define SNAP_ABUS_17(s) SNAP_PIN_D20(s)
+#define SNAP_ABUS_18(s) SNAP_PIN_D17(s)
+#define SNAP_ABUS_19(s) SNAP_PIN_D16(s)
+#define SNAP_ABUS_20(s) SNAP_PIN_D15(s)
+#define SNAP_ABUS_21(s) SNAP_PIN_D14(s)
+#define SNAP_ABUS_22(s) SNAP_PIN_D00(s)
+#define SNAP_ABUS_23(s) SNAP_PIN_D01(s)
+
 #define PRE_RESET_CYCLE_COUNT 5 // How many cycles to wait before asserting RESET. This gives time for pins to settle.
 
 // How many cycles to hold the RESET signal high. Intel says "greater than 4" although 4 seems to work.
@@ -309,6 +349,10 @@ public:
     return ADDRESS_DIGITS;
   }
 
+  static int clockPinImpl() {
+    return CLK_PIN;
+  }
+
   /// @brief Return true if the current shield has a multiplexed bus.
   static bool hasMultiplexedBusImpl() {
     return false;
@@ -353,42 +397,27 @@ public:
   }
 
   static TCycle getNextCycleImpl(TCycle current_cycle, BusStatus current_status, BusStatus latched_status) {
-    // Return the next cycle for the CPU
-     switch (current_cycle) {
-      case TI:
-        return TI;
-        break;
-      
+    // Advance via a single indexed load from the shared transition table.
+    // The condition bit is only computed for the rows that consult it.
+    bool cond = false;
+    switch (current_cycle) {
       case T1:
         // Begin a bus cycle only if signalled, otherwise wait in T1
-        if (current_status != PASV) {
-          return T2;
-        }
+        cond = (current_status != PASV);
         break;
-
       case T2:
-        if (isTransferDoneImpl(latched_status)) {
-          return TI;
-        } else {
-  #if DEBUG_TSTATE
-          debugPrintlnColor(ansi::yellow, "Setting T-cycle to Tw");
-  #endif
-          return TW;
-        }
-        break;
-
-      case TW:
-        // Transition to TI if read/write signals are complete
-        if (isTransferDoneImpl(latched_status)) {
-          return TI;
-        }
+        cond = isTransferDoneImpl(latched_status);
         break;
-
       default:
         break;
     }
-
-    return TI; // Default to TI if no other condition matches
+    TCycle next = TCYCLE_NEXT_286[current_cycle][cond ? 1 : 0];
+  #if DEBUG_TSTATE
+    if ((next == TW) && (current_cycle == T2)) {
+      debugPrintlnColor(ansi::yellow, "Setting T-cycle to Tw");
+    }
+  #endif
+    return next;
   }
 
   static const char * getTCycleString(TCycle cycle) {
@@ -431,6 +460,21 @@ public:
       setBusDirection(BusDirection::Input, width);
     }
 
+    #if defined(ARDUINO_GIGA)
+    // Table-driven gather (see DataBusLut.h): four lane loads and three ORs
+    // instead of sixteen test-and-OR steps. Lanes outside the active width
+    // are masked after the load.
+    uint16_t data = dbusRead16();
+    if (!peek) {
+      if (width == ActiveBusWidth::EightLow) {
+        data &= 0x00FF;
+      }
+      else if (width == ActiveBusWidth::EightHigh) {
+        data &= 0xFF00;
+      }
+    }
+    return data;
+    #else
     uint16_t data = 0;
 
     if (peek || (width == ActiveBusWidth::EightLow) || (width == ActiveBusWidth::Sixteen)) {
@@ -455,6 +499,7 @@ public:
       if (READ_DBUS_15) data |= 0x8000;
     }
     return data;
+    #endif
   }
 
   void writeDataBus(uint16_t data, ActiveBusWidth width) {
@@ -488,26 +533,16 @@ public:
     #elif defined(ARDUINO_GIGA)
       setBusDirection(BusDirection::Output, width);
 
-      if ((width == ActiveBusWidth::EightLow) || (width == ActiveBusWidth::Sixteen)) {
-        WRITE_BIT(data, 0x01, SET_DBUS_00, CLEAR_DBUS_00);
-        WRITE_BIT(data, 0x02, SET_DBUS_01, CLEAR_DBUS_01);
-        WRITE_BIT(data, 0x04, SET_DBUS_02, CLEAR_DBUS_02);
-        WRITE_BIT(data, 0x08, SET_DBUS_03, CLEAR_DBUS_03);
-        WRITE_BIT(data, 0x10, SET_DBUS_04, CLEAR_DBUS_04);
-        WRITE_BIT(data, 0x20, SET_DBUS_05, CLEAR_DBUS_05);
-        WRITE_BIT(data, 0x40, SET_DBUS_06, CLEAR_DBUS_06);
-        WRITE_BIT(data, 0x80, SET_DBUS_07, CLEAR_DBUS_07);
+      // Table-driven scatter (see DataBusLut.h): one precomputed BSRR store
+      // per port instead of a set/clear branch per bit.
+      if (width == ActiveBusWidth::Sixteen) {
+        dbusWrite16(data);
       }
-
-      if ((width == ActiveBusWidth::EightHigh) || (width == ActiveBusWidth::Sixteen)) {
-        WRITE_BIT(data, 0x0100, SET_DBUS_08, CLEAR_DBUS_08);
-        WRITE_BIT(data, 0x0200, SET_DBUS_09, CLEAR_DBUS_09);
-        WRITE_BIT(data, 0x0400, SET_DBUS_10, CLEAR_DBUS_10);
-        WRITE_BIT(data, 0x0800, SET_DBUS_11, CLEAR_DBUS_11);
-        WRITE_BIT(data, 0x1000, SET_DBUS_12, CLEAR_DBUS_12);
-        WRITE_BIT(data, 0x2000, SET_DBUS_13, CLEAR_DBUS_13);
-        WRITE_BIT(data, 0x4000, SET_DBUS_14, CLEAR_DBUS_14);
-        WRITE_BIT(data, 0x8000, SET_DBUS_15, CLEAR_DBUS_15);        
+      else if (width == ActiveBusWidth::EightLow) {
+        dbusWriteLow(data);
+      }
+      else {
+        dbusWriteHigh(data);
       }
     #endif
   }
@@ -519,32 +554,34 @@ public:
       //setBusDirection(BusDirection::Input, ActiveBusWidth::Sixteen);
     }
 
+    ensureSnapshot();
+    const PortSnapshot& s = snapshot_;
     uint32_t address = 0;
     // Read the address bus pins
-    if (READ_ABUS_00) address |= 0x00000001;
-    if (READ_ABUS_01) address |= 0x00000002;
-    if (READ_ABUS_02) address |= 0x00000004;
-    if (READ_ABUS_03) address |= 0x00000008;
-    if (READ_ABUS_04) address |= 0x00000010;
-    if (READ_ABUS_05) address |= 0x00000020;
-    if (READ_ABUS_06) address |= 0x00000040;
-    if (READ_ABUS_07) address |= 0x00000080;
-    if (READ_ABUS_08) address |= 0x00000100;
-    if (READ_ABUS_09) address |= 0x00000200;
-    if (READ_ABUS_10) address |= 0x00000400;
-    if (READ_ABUS_11) address |= 0x00000800;
-    if (READ_ABUS_12) address |= 0x00001000;
-    if (READ_ABUS_13) address |= 0x00002000;
-    if (READ_ABUS_14) address |= 0x00004000;
-    if (READ_ABUS_15) address |= 0x00008000;
-    if (READ_ABUS_16) address |= 0x00010000;
-    if (READ_ABUS_17) address |= 0x00020000;
-    if (READ_ABUS_18) address |= 0x00040000;
-    if (READ_ABUS_19) address |= 0x00080000;
-    if (READ_ABUS_20) address |= 0x00100000;
-    if (READ_ABUS_21) address |= 0x00200000;
-    if (READ_ABUS_22) address |= 0x00400000;
-    if (READ_ABUS_23) address |= 0x00800000;
+    if (SNAP_ABUS_00(s)) address |= 0x00000001;
+    if (SNAP_ABUS_01(s)) address |= 0x00000002;
+    if (SNAP_ABUS_02(s)) address |= 0x00000004;
+    if (SNAP_ABUS_03(s)) address |= 0x00000008;
+    if (SNAP_ABUS_04(s)) address |= 0x00000010;
+    if (SNAP_ABUS_05(s)) address |= 0x00000020;
+    if (SNAP_ABUS_06(s)) address |= 0x00000040;
+    if (SNAP_ABUS_07(s)) address |= 0x00000080;
+    if (SNAP_ABUS_08(s)) address |= 0x00000100;
+    if (SNAP_ABUS_09(s)) address |= 0x00000200;
+    if (SNAP_ABUS_10(s)) address |= 0x00000400;
+    if (SNAP_ABUS_11(s)) address |= 0x00000800;
+    if (SNAP_ABUS_12(s)) address |= 0x00001000;
+    if (SNAP_ABUS_13(s)) address |= 0x00002000;
+    if (SNAP_ABUS_14(s)) address |= 0x00004000;
+    if (SNAP_ABUS_15(s)) address |= 0x00008000;
+    if (SNAP_ABUS_16(s)) address |= 0x00010000;
+    if (SNAP_ABUS_17(s)) address |= 0x00020000;
+    if (SNAP_ABUS_18(s)) address |= 0x00040000;
+    if (SNAP_ABUS_19(s)) address |= 0x00080000;
+    if (SNAP_ABUS_20(s)) address |= 0x00100000;
+    if (SNAP_ABUS_21(s)) address |= 0x00200000;
+    if (SNAP_ABUS_22(s)) address |= 0x00400000;
+    if (SNAP_ABUS_23(s)) address |= 0x00800000;
     return address;
   }
 
@@ -592,6 +629,9 @@ public:
       case OutputPin::Smi:
         WRITE_SMI_PIN(value);
         break;
+      case OutputPin::Hold:
+        digitalWrite(HOLD_PIN, value ? HIGH : LOW);
+        break;
       default:
         // Handle other pins if necessary
         break;
@@ -689,33 +729,41 @@ public:
     return result;
   }
 
-  static bool readBHEPinImpl() {
+  bool readBHEPinImpl() {
     // Read the BHE pin (Bus High Enable)
-    return READ_BHE_PIN;
+    ensureSnapshot();
+    return SNAP_BHE_PIN(snapshot_);
   }
-  static bool readALEPinImpl() {
-    return READ_ALE_PIN;
+  bool readALEPinImpl() {
+    ensureSnapshot();
+    return SNAP_ALE_PIN(snapshot_);
   }
-  static bool readLockPinImpl() {
-    return READ_LOCK_PIN;
+  bool readLockPinImpl() {
+    ensureSnapshot();
+    return SNAP_LOCK_PIN(snapshot_);
   }
   static bool readReadyPinImpl() {
+    // READY is driven by us, so read it live rather than from the snapshot.
     return READ_READY_PIN;
   }
-  static bool readMRDCPinImpl() {
-    return READ_MRDC_PIN;
+  bool readMRDCPinImpl() {
+    ensureSnapshot();
+    return SNAP_MRDC_PIN(snapshot_);
   }
   static bool readAMWCPinImpl() {
     return READ_AMWC_PIN;
   }
-  static bool readMWTCPinImpl() {
-    return READ_MWTC_PIN;
+  bool readMWTCPinImpl() {
+    ensureSnapshot();
+    return SNAP_MWTC_PIN(snapshot_);
   }
-  static bool readIORCPinImpl() {
-    return READ_IORC_PIN;
+  bool readIORCPinImpl() {
+    ensureSnapshot();
+    return SNAP_IORC_PIN(snapshot_);
   }
-  static bool readIOWCPinImpl() {
-    return READ_IOWC_PIN;
+  bool readIOWCPinImpl() {
+    ensureSnapshot();
+    return SNAP_IOWC_PIN(snapshot_);
   }
   static bool readAIOWCPinImpl() {
     return READ_AIOWC_PIN;
@@ -728,36 +776,41 @@ public:
     WRITE_PIN_D05(value);
   }
 
-  static uint8_t readCpuStatusLinesImpl() {
+  uint8_t readCpuStatusLinesImpl() {
     // Read the CPU status lines
+    ensureSnapshot();
+    const PortSnapshot& s = snapshot_;
     uint8_t status = 0;
-    if (READ_RW_PIN) { status |= 0x01; };
-    if (READ_DC_PIN) { status |= 0x02; }; 
-    if (READ_M_IO_PIN) { status |= 0x04; };
+    if (SNAP_RW_PIN(s)) { status |= 0x01; };
+    if (SNAP_DC_PIN(s)) { status |= 0x02; };
+    if (SNAP_M_IO_PIN(s)) { status |= 0x04; };
 
     return status;
   }
 
-  static uint8_t readBusControllerCommandLinesImpl() {
+  uint8_t readBusControllerCommandLinesImpl() {
     // Read the bus controller command lines
+    ensureSnapshot();
+    const PortSnapshot& s = snapshot_;
     uint8_t command = 0;
-    command |= readMRDCPinImpl() ? 0x01 : 0;     // MRDC - Pin 51
+    command |= SNAP_MRDC_PIN(s) ? 0x01 : 0;      // MRDC - Pin 51
     command |= readAMWCPinImpl() ? 0x02 : 0;     // AMWC - Pin 52
-    command |= readMWTCPinImpl() ? 0x04 : 0;     // MWTC - Pin 53
-    command |= readIORCPinImpl() ? 0x08 : 0;     // IORC - Pin 46
+    command |= SNAP_MWTC_PIN(s) ? 0x04 : 0;      // MWTC - Pin 53
+    command |= SNAP_IORC_PIN(s) ? 0x08 : 0;      // IORC - Pin 46
     command |= readAIOWCPinImpl() ? 0x10 : 0;    // AIOWC- Pin 48
-    command |= readIOWCPinImpl() ? 0x20 : 0;     // IOWC - Pin 47
+    command |= SNAP_IOWC_PIN(s) ? 0x20 : 0;      // IOWC - Pin 47
     command |= readINTAPinImpl() ? 0x40 : 0;     // INTA - Pin 45
     // Although not an 8288 command status, we have an extra bit, so we can stick BHE in here.
     // This saves us from needing to add an extra byte - that adds up!
-    command |= READ_BHE_PIN ? 0x80 : 0;
+    command |= SNAP_BHE_PIN(s) ? 0x80 : 0;
     return command;
   }
 
-  static uint8_t readBusControllerControlLinesImpl() {
+  uint8_t readBusControllerControlLinesImpl() {
     // Read the bus controller control lines
+    ensureSnapshot();
     uint8_t control = 0;
-    control |= READ_ALE_PIN ? 0x01 : 0;     // ALE      - Pin 50
+    control |= SNAP_ALE_PIN(snapshot_) ? 0x01 : 0;     // ALE      - Pin 50
     //control |= READ_PIN_D49 ? 0x02 : 0;     // DTR      - Pin 49
     //control |= READ_PIN_D43 ? 0x04 : 0;     // MCE/PDEN - Pin 43
     //control |= READ_PIN_D44 ? 0x08 : 0;     // DEN      - Pin 44
@@ -31,6 +31,7 @@ void cycle();
 #include <gpio_pins.h>
 #include <shields/ShieldBase.h>
 #include <shields/Pins.h>
+#include <shields/DataBusLut.h>
 #include <DebugFilter.h>
 
 #define CPU_8088
@@ -294,6 +295,49 @@ void cycle();
 #define READ_IOWC_PIN     READ_PIN_D47
 #define READ_INTA_PIN     READ_PIN_D45
 
+// Snapshot equivalents of the pin decode macros, reading from a PortSnapshot
+// captured at the clock edge.
+#define SNAP_ALE_PIN(s)   SNAP_PIN_D50(s)
+#define SNAP_MRDC_PIN(s)  SNAP_PIN_D51(s)
+#define SNAP_AMWC_PIN(s)  SNAP_PIN_D52(s)
+#define SNAP_MWTC_PIN(s)  SNAP_PIN_D53(s)
+#define SNAP_IORC_PIN(s)  SNAP_PIN_D46(s)
+#define SNAP_AIOWC_PIN(s) SNAP_PIN_D48(s)
+#define SNAP_IOWC_PIN(s)  SNAP_PIN_D47(s)
+#define SNAP_INTA_PIN(s)  SNAP_PIN_D45(s)
+#define SNAP_BHE_PIN(s)   SNAP_PIN_D17(s)
+#define SNAP_LOCK_PIN(s)  SNAP_PIN_D10(s)
+
+#define SNAP_S0_PIN(s)    SNAP_PIN_D14(s)
+#define SNAP_S1_PIN(s)    SNAP_PIN_D15(s)
+#define SNAP_S2_PIN(s)    SNAP_PIN_D16(s)
+#define SNAP_S3_PIN(s)    SNAP_PIN_D38(s)
+#define SNAP_S4_PIN(s)    SNAP_PIN_D39(s)
+#define SNAP_S5_PIN(s)    SNAP_PIN_D40(s)
+#define SNAP_QS0_PIN(s)   SNAP_PIN_D09(s)
+#define SNAP_QS1_PIN(s)   SNAP_PIN_D08(s)
+
+#define SNAP_ABUS_00(s) SNAP_PIN_D22(s)
+#define SNAP_ABUS_01(s) SNAP_PIN_D23(s)
+#define SNAP_ABUS_02(s) SNAP_PIN_D24(s)
+#define SNAP_ABUS_03(s) SNAP_PIN_D25(s)
+#define SNAP_ABUS_04(s) SNAP_PIN_D26(s)
+#define SNAP_ABUS_05(s) SNAP_PIN_D27(s)
+#define SNAP_ABUS_06(s) SNAP_PIN_D28(s)
+#define SNAP_ABUS_07(s) SNAP_PIN_D29(s)
+#define SNAP_ABUS_08(s) SNAP_PIN_D30(s)
+#define SNAP_ABUS_09(s) SNAP_PIN_D31(s)
+#define SNAP_ABUS_10(s) SNAP_PIN_D32(s)
+#define SNAP_ABUS_11(s) SNAP_PIN_D33(s)
+#define SNAP_ABUS_12(s) SNAP_PIN_D34(s)
+#define SNAP_ABUS_13(s) SNAP_PIN_D35(s)
+#define SNAP_ABUS_14(s) SNAP_PIN_D36(s)
+#define SNAP_ABUS_15(s) SNAP_PIN_D37(s)
+#define SNAP_ABUS_16(s) SNAP_PIN_D38(s)
+#define SNAP_ABUS_17(s) SNAP_PIN_D39(s)
+#define SNAP_ABUS_18(s) SNAP_PIN_D40(s)
+#define SNAP_ABUS_19(s) SNAP_PIN_D41(s)
+
 // -------------------------- Macro definitions  ---------------------------------
 
 // Write macros
@@ -526,6 +570,10 @@ public:
     return true;
   }
 
+  static int clockPinImpl() {
+    return CLK_PIN;
+  }
+
   static bool isTransferDoneImpl(BusStatus latched_status) {
     switch (latched_status) {
       case IOR:
@@ -550,55 +598,55 @@ public:
   }
 
   static TCycle getNextCycleImpl(TCycle current_cycle, BusStatus current_status, BusStatus latched_status) {
-    // Return the next cycle for the CPU
-     switch (current_cycle) {
-      case TI:
-        break;
-      
+    // Advance via a single indexed load from the shared transition table.
+    // The condition bit (and its command-line pin reads) is only computed
+    // for the rows that consult it.
+    bool cond = false;
+    switch (current_cycle) {
       case T1:
         // Begin a bus cycle only if signalled, otherwise wait in T1
-        if (current_status != PASV) {
-          return T2;
-        }
-        break;
-
-      case T2:
-        return T3;
+        cond = (current_status != PASV);
         break;
-
       case T3:
-        if (isTransferDoneImpl(latched_status)) {
-          return T4;
-        } else {
-  #if DEBUG_TSTATE
-          debugPrintlnColor(ansi::yellow, "Setting T-cycle to Tw");
-  #endif
-          return TW;
-        }
-        break;
-
+        // FALLTHRU
       case TW:
         // Transition to T4 if read/write signals are complete
-        if (isTransferDoneImpl(latched_status)) {
-          return T4;
-        }
+        cond = isTransferDoneImpl(latched_status);
         break;
-
-      case T4:
-  #if DEBUG_TSTATE
-        debugPrintlnColor(ansi::yellow, "Setting T-cycle to T1");
-  #endif
-        return T1;
+      default:
         break;
     }
-
-    return current_cycle; // If no change, return the current cycle
+    TCycle next = TCYCLE_NEXT_808X[current_cycle][cond ? 1 : 0];
+  #if DEBUG_TSTATE
+    if ((next == TW) && (current_cycle == T3)) {
+      debugPrintlnColor(ansi::yellow, "Setting T-cycle to Tw");
+    }
+    if (next == T1 && current_cycle == T4) {
+      debugPrintlnColor(ansi::yellow, "Setting T-cycle to T1");
+    }
+  #endif
+    return next;
   }
 
   uint16_t readDataBus(ActiveBusWidth width, bool peek = false) {
     if(!peek) {
       setBusDirection(BusDirection::Input, width);
     };
+    #if defined(ARDUINO_GIGA)
+    // Table-driven gather (see DataBusLut.h): four lane loads and three ORs
+    // instead of sixteen test-and-OR steps. Lanes outside the active width
+    // are masked after the load.
+    uint16_t data = dbusRead16();
+    if (!peek) {
+      if (width == ActiveBusWidth::EightLow) {
+        data &= 0x00FF;
+      }
+      else if (width == ActiveBusWidth::EightHigh) {
+        data &= 0xFF00;
+      }
+    }
+    return data;
+    #else
     uint16_t data = 0;
     if (peek || (width == ActiveBusWidth::EightLow) || (width == ActiveBusWidth::Sixteen)) {
       // Read data from bus pins
@@ -622,6 +670,7 @@ public:
       if (READ_DBUS_15) data |= 0x8000;
     }
     return data;
+    #endif
   }
 
   void writeDataBus(uint16_t data, ActiveBusWidth width) {
@@ -655,49 +704,16 @@ public:
     #elif defined(ARDUINO_GIGA)
       setBusDirection(BusDirection::Output, width);
 
-      if ((width == ActiveBusWidth::EightLow) || (width == ActiveBusWidth::Sixteen)) {
-        DEBUG_SERIAL.print("Writing low data bus: ");
-        DEBUG_SERIAL.println(data & 0x00FF, HEX);
-        WRITE_BIT(data, 0x01, SET_DBUS_00, CLEAR_DBUS_00);
-        WRITE_BIT(data, 0x02, SET_DBUS_01, CLEAR_DBUS_01);
-        WRITE_BIT(data, 0x04, SET_DBUS_02, CLEAR_DBUS_02);
-        WRITE_BIT(data, 0x08, SET_DBUS_03, CLEAR_DBUS_03);
-        WRITE_BIT(data, 0x10, SET_DBUS_04, CLEAR_DBUS_04);
-        WRITE_BIT(data, 0x20, SET_DBUS_05, CLEAR_DBUS_05);
-        WRITE_BIT(data, 0x40, SET_DBUS_06, CLEAR_DBUS_06);
-        WRITE_BIT(data, 0x80, SET_DBUS_07, CLEAR_DBUS_07);
-
-        // SET_DBUS_00;
-        // SET_DBUS_01;
-        // SET_DBUS_02;
-        // SET_DBUS_03;
-        // SET_DBUS_04;
-        // SET_DBUS_05;
-        // SET_DBUS_06;
-        // SET_DBUS_07;
-
-        // CLEAR_DBUS_00;
-        // CLEAR_DBUS_01;
-        // CLEAR_DBUS_02;
-        // CLEAR_DBUS_03;
-        // CLEAR_DBUS_04;
-        // CLEAR_DBUS_05;
-        // CLEAR_DBUS_06;
-        // CLEAR_DBUS_07;
-
+      // Table-driven scatter (see DataBusLut.h): one precomputed BSRR store
+      // per port instead of a set/clear branch per bit.
+      if (width == ActiveBusWidth::Sixteen) {
+        dbusWrite16(data);
+      }
+      else if (width == ActiveBusWidth::EightLow) {
+        dbusWriteLow(data);
       }
-      
-      if ((width == ActiveBusWidth::EightHigh) || (width == ActiveBusWidth::Sixteen)) {
-        DEBUG_SERIAL.print("Writing high data bus: ");
-        DEBUG_SERIAL.println(data >> 8, HEX);
-        WRITE_BIT(data, 0x0100, SET_DBUS_08, CLEAR_DBUS_08);
-        WRITE_BIT(data, 0x0200, SET_DBUS_09, CLEAR_DBUS_09);
-        WRITE_BIT(data, 0x0400, SET_DBUS_10, CLEAR_DBUS_10);
-        WRITE_BIT(data, 0x0800, SET_DBUS_11, CLEAR_DBUS_11);
-        WRITE_BIT(data, 0x1000, SET_DBUS_12, CLEAR_DBUS_12);
-        WRITE_BIT(data, 0x2000, SET_DBUS_13, CLEAR_DBUS_13);
-        WRITE_BIT(data, 0x4000, SET_DBUS_14, CLEAR_DBUS_14);
-        WRITE_BIT(data, 0x8000, SET_DBUS_15, CLEAR_DBUS_15);        
+      else {
+        dbusWriteHigh(data);
       }
     #endif
   }  
@@ -707,63 +723,78 @@ public:
     // If we're not peeking, set the bus direction to input
     if (!peek) {
       setBusDirection(BusDirection::Input, ActiveBusWidth::Sixteen);
+      // The bus direction may have just changed, so the edge snapshot could
+      // predate it. Recapture so we decode the CPU-driven address lines.
+      captureSnapshot();
     }
 
+    ensureSnapshot();
+    const PortSnapshot& s = snapshot_;
     uint32_t address = 0;
     // Read the address bus pins
-    if (READ_ABUS_00) address |= 0x00000001;  // AD0  Pin 22
-    if (READ_ABUS_01) address |= 0x00000002;  // AD1  Pin 23
-    if (READ_ABUS_02) address |= 0x00000004;  // AD2  Pin 24
-    if (READ_ABUS_03) address |= 0x00000008;  // AD3  Pin 25
-    if (READ_ABUS_04) address |= 0x00000010;  // AD4  Pin 26
-    if (READ_ABUS_05) address |= 0x00000020;  // AD5  Pin 27
-    if (READ_ABUS_06) address |= 0x00000040;  // AD6  Pin 28
-    if (READ_ABUS_07) address |= 0x00000080;  // AD7  Pin 29
-    if (READ_ABUS_08) address |= 0x00000100;  // AD8  Pin 30
-    if (READ_ABUS_09) address |= 0x00000200;  // AD9  Pin 31
-    if (READ_ABUS_10) address |= 0x00000400;  // AD10 Pin 32
-    if (READ_ABUS_11) address |= 0x00000800;  // AD11 Pin 33
-    if (READ_ABUS_12) address |= 0x00001000;  // AD12 Pin 34
-    if (READ_ABUS_13) address |= 0x00002000;  // AD13 Pin 35
-    if (READ_ABUS_14) address |= 0x00004000;  // AD14 Pin 36
-    if (READ_ABUS_15) address |= 0x00008000;  // AD15 Pin 37
-    if (READ_ABUS_16) address |= 0x00010000;  // AD16 Pin 38
-    if (READ_ABUS_17) address |= 0x00020000;  // AD17 Pin 39
-    if (READ_ABUS_18) address |= 0x00040000;  // AD18 Pin 40
-    if (READ_ABUS_19) address |= 0x00080000;  // AD19 Pin 41
+    if (SNAP_ABUS_00(s)) address |= 0x00000001;  // AD0  Pin 22
+    if (SNAP_ABUS_01(s)) address |= 0x00000002;  // AD1  Pin 23
+    if (SNAP_ABUS_02(s)) address |= 0x00000004;  // AD2  Pin 24
+    if (SNAP_ABUS_03(s)) address |= 0x00000008;  // AD3  Pin 25
+    if (SNAP_ABUS_04(s)) address |= 0x00000010;  // AD4  Pin 26
+    if (SNAP_ABUS_05(s)) address |= 0x00000020;  // AD5  Pin 27
+    if (SNAP_ABUS_06(s)) address |= 0x00000040;  // AD6  Pin 28
+    if (SNAP_ABUS_07(s)) address |= 0x00000080;  // AD7  Pin 29
+    if (SNAP_ABUS_08(s)) address |= 0x00000100;  // AD8  Pin 30
+    if (SNAP_ABUS_09(s)) address |= 0x00000200;  // AD9  Pin 31
+    if (SNAP_ABUS_10(s)) address |= 0x00000400;  // AD10 Pin 32
+    if (SNAP_ABUS_11(s)) address |= 0x00000800;  // AD11 Pin 33
+    if (SNAP_ABUS_12(s)) address |= 0x00001000;  // AD12 Pin 34
+    if (SNAP_ABUS_13(s)) address |= 0x00002000;  // AD13 Pin 35
+    if (SNAP_ABUS_14(s)) address |= 0x00004000;  // AD14 Pin 36
+    if (SNAP_ABUS_15(s)) address |= 0x00008000;  // AD15 Pin 37
+    if (SNAP_ABUS_16(s)) address |= 0x00010000;  // AD16 Pin 38
+    if (SNAP_ABUS_17(s)) address |= 0x00020000;  // AD17 Pin 39
+    if (SNAP_ABUS_18(s)) address |= 0x00040000;  // AD18 Pin 40
+    if (SNAP_ABUS_19(s)) address |= 0x00080000;  // AD19 Pin 41
     return address;
   }
 
-    static bool readBHEPinImpl() {
+  bool readBHEPinImpl() {
     // Read the BHE pin (Bus High Enable)
-    return READ_BHE_PIN;
+    ensureSnapshot();
+    return SNAP_BHE_PIN(snapshot_);
   }
-  static bool readALEPinImpl() {
-    return READ_ALE_PIN;
+  bool readALEPinImpl() {
+    ensureSnapshot();
+    return SNAP_ALE_PIN(snapshot_);
   }
-  static bool readLockPinImpl() {
-    return READ_LOCK_PIN;
+  bool readLockPinImpl() {
+    ensureSnapshot();
+    return SNAP_LOCK_PIN(snapshot_);
   }
   static bool readReadyPinImpl() {
+    // READY is driven by us, so read it live rather than from the snapshot.
     return READ_READY_PIN;
   }
-  static bool readMRDCPinImpl() {
-    return READ_MRDC_PIN;
+  bool readMRDCPinImpl() {
+    ensureSnapshot();
+    return SNAP_MRDC_PIN(snapshot_);
   }
-  static bool readAMWCPinImpl() {
-    return READ_AMWC_PIN;
+  bool readAMWCPinImpl() {
+    ensureSnapshot();
+    return SNAP_AMWC_PIN(snapshot_);
   }
-  static bool readMWTCPinImpl() {
-    return READ_MWTC_PIN;
+  bool readMWTCPinImpl() {
+    ensureSnapshot();
+    return SNAP_MWTC_PIN(snapshot_);
   }
-  static bool readIORCPinImpl() {
-    return READ_IORC_PIN;
+  bool readIORCPinImpl() {
+    ensureSnapshot();
+    return SNAP_IORC_PIN(snapshot_);
   }
-  static bool readIOWCPinImpl() {
-    return READ_IOWC_PIN;
+  bool readIOWCPinImpl() {
+    ensureSnapshot();
+    return SNAP_IOWC_PIN(snapshot_);
   }
-  static bool readAIOWCPinImpl() {
-    return READ_AIOWC_PIN;
+  bool readAIOWCPinImpl() {
+    ensureSnapshot();
+    return SNAP_AIOWC_PIN(snapshot_);
   }
   static bool readINTAPinImpl() {
     return false;
@@ -789,42 +820,48 @@ public:
     }
   }
 
-  static uint8_t readCpuStatusLinesImpl() {
+  uint8_t readCpuStatusLinesImpl() {
     // Read the CPU status lines
+    ensureSnapshot();
+    const PortSnapshot& s = snapshot_;
     uint8_t status = 0;
-    if (READ_S0_PIN) { status |= 0x01; };
-    if (READ_S1_PIN) { status |= 0x02; };
-    if (READ_S2_PIN) { status |= 0x04; };
-    if (READ_S3_PIN) { status |= 0x08; };
-    if (READ_S4_PIN) { status |= 0x10; };
-    if (READ_S5_PIN) { status |= 0x20; };
-    if (READ_QS0_PIN) { status |= 0x40; };
-    if (READ_QS1_PIN) { status |= 0x80; };
+    if (SNAP_S0_PIN(s)) { status |= 0x01; };
+    if (SNAP_S1_PIN(s)) { status |= 0x02; };
+    if (SNAP_S2_PIN(s)) { status |= 0x04; };
+    if (SNAP_S3_PIN(s)) { status |= 0x08; };
+    if (SNAP_S4_PIN(s)) { status |= 0x10; };
+    if (SNAP_S5_PIN(s)) { status |= 0x20; };
+    if (SNAP_QS0_PIN(s)) { status |= 0x40; };
+    if (SNAP_QS1_PIN(s)) { status |= 0x80; };
     return status;
   }
 
-  static uint8_t readBusControllerCommandLinesImpl() {
+  uint8_t readBusControllerCommandLinesImpl() {
     // Read the bus controller command lines
+    ensureSnapshot();
+    const PortSnapshot& s = snapshot_;
     uint8_t command = 0;
-    command |= READ_MRDC_PIN ? 0x01 : 0;     // MRDC - Pin 51
-    command |= READ_AMWC_PIN ? 0x02 : 0;     // AMWC - Pin 52
-    command |= READ_MWTC_PIN ? 0x04 : 0;     // MWTC - Pin 53
-    command |= READ_IORC_PIN ? 0x08 : 0;     // IORC - Pin 46
-    command |= READ_AIOWC_PIN ? 0x10 : 0;    // AIOWC- Pin 48
-    command |= READ_IOWC_PIN ? 0x20 : 0;     // IOWC - Pin 47
-    command |= READ_INTA_PIN ? 0x40 : 0;     // INTA - Pin 45
+    command |= SNAP_MRDC_PIN(s) ? 0x01 : 0;     // MRDC - Pin 51
+    command |= SNAP_AMWC_PIN(s) ? 0x02 : 0;     // AMWC - Pin 52
+    command |= SNAP_MWTC_PIN(s) ? 0x04 : 0;     // MWTC - Pin 53
+    command |= SNAP_IORC_PIN(s) ? 0x08 : 0;     // IORC - Pin 46
+    command |= SNAP_AIOWC_PIN(s) ? 0x10 : 0;    // AIOWC- Pin 48
+    command |= SNAP_IOWC_PIN(s) ? 0x20 : 0;     // IOWC - Pin 47
+    command |= SNAP_INTA_PIN(s) ? 0x40 : 0;     // INTA - Pin 45
     // Although not an 8288 command status, we have an extra bit, so we can stick BHE in here.
-    command |= READ_BHE_PIN ? 0x80 : 0;      // BHE  - Pin 17
+    command |= SNAP_BHE_PIN(s) ? 0x80 : 0;      // BHE  - Pin 17
     return command;
   }
 
-  static uint8_t readBusControllerControlLinesImpl() {
+  uint8_t readBusControllerControlLinesImpl() {
     // Read the bus controller control lines
+    ensureSnapshot();
+    const PortSnapshot& s = snapshot_;
     uint8_t control = 0;
-    control |= READ_ALE_PIN ? 0x01 : 0;     // ALE      - Pin 50
-    control |= READ_PIN_D49 ? 0x02 : 0;     // DTR      - Pin 49
-    control |= READ_PIN_D43 ? 0x04 : 0;     // MCE/PDEN - Pin 43
-    control |= READ_PIN_D44 ? 0x08 : 0;     // DEN      - Pin 44
+    control |= SNAP_ALE_PIN(s) ? 0x01 : 0;      // ALE      - Pin 50
+    control |= SNAP_PIN_D49(s) ? 0x02 : 0;      // DTR      - Pin 49
+    control |= SNAP_PIN_D43(s) ? 0x04 : 0;      // MCE/PDEN - Pin 43
+    control |= SNAP_PIN_D44(s) ? 0x08 : 0;      // DEN      - Pin 44
     return control;
   }
 };
\ No newline at end of file
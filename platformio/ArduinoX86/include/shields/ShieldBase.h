@@ -52,6 +52,55 @@ class ShieldBase {
       static_cast<Derived*>(this)->tickCpuImpl();
     };
 
+    int clockPin() {
+      return Derived::clockPinImpl();
+    }
+
+    /// @brief Drive the CPU clock from a hardware PWM channel instead of
+    /// bit-banging it in tickCpu(). Used by free-run turbo mode: the CPU runs
+    /// continuously at `hz` while the ALE interrupt freezes individual bus
+    /// cycles with wait states for servicing.
+    /// @return True if the hardware clock was started.
+    bool startFreeRunClock(uint32_t hz) {
+#if defined(ARDUINO_GIGA)
+      if (freeRunning_) {
+        return true;
+      }
+      if (clockPin() < 0) {
+        return false;
+      }
+      clkPwm_ = new mbed::PwmOut(digitalPinToPinName(clockPin()));
+      clkPwm_->period(1.0f / (float)hz);
+      clkPwm_->write(0.5f);
+      freeRunning_ = true;
+      return true;
+#else
+      // No hardware timer support wired up for this platform; callers fall
+      // back to the bit-banged clock.
+      (void)hz;
+      return false;
+#endif
+    }
+
+    /// @brief Stop the hardware clock and return the CLK pin to bit-banged
+    /// control. The clock is left low, matching the tickCpu() idle state.
+    void stopFreeRunClock() {
+#if defined(ARDUINO_GIGA)
+      if (!freeRunning_) {
+        return;
+      }
+      delete clkPwm_;
+      clkPwm_ = nullptr;
+      pinMode(clockPin(), OUTPUT);
+      digitalWrite(clockPin(), LOW);
+      freeRunning_ = false;
+#endif
+    }
+
+    bool isFreeRunning() const {
+      return freeRunning_;
+    }
+
 
     static bool readPin(OutputPin pin) {
       return Derived::readPinImpl(pin);
@@ -117,6 +166,14 @@ class ShieldBase {
        return static_cast<Derived*>(this)->readBusControllerControlLinesImpl();
     }
 
+    /// @brief Capture all GPIO input ports in one pass at the clock edge.
+    /// Decode methods extract their bits from this snapshot lazily instead of
+    /// re-reading the same IDR registers once per field.
+    void captureSnapshot() {
+      CAPTURE_PORT_SNAPSHOT(snapshot_);
+      snapshot_valid_ = true;
+    }
+
     static int getAddressBusWidth() {
       // Default address bus width is 20 bits
       return 20;
@@ -224,6 +281,31 @@ class ShieldBase {
     ActiveBusWidth writeBusWidth = ActiveBusWidth::Sixteen; // Default write bus width is 16 bits
     size_t dataBusWidth = 16; // Default data bus width is 16 bits
 
+    PortSnapshot snapshot_ = {};
+    bool snapshot_valid_ = false;
+
+#if defined(ARDUINO_GIGA)
+    mbed::PwmOut *clkPwm_ = nullptr;
+#endif
+    bool freeRunning_ = false;
+
+  public:
+    /// Shields that support the free-run clock override this with their
+    /// CLK pin number.
+    static int clockPinImpl() {
+      return -1;
+    }
+
+  protected:
+
+  // Decode methods call this before extracting bits so that callers outside
+  // the cycle loop still get pin state from the most recent clock edge.
+  void ensureSnapshot() {
+    if (!snapshot_valid_) {
+      captureSnapshot();
+    }
+  }
+
   void setBusDirectionImpl(BusDirection direction, ActiveBusWidth width = ActiveBusWidth::Sixteen) {
     if ((direction == busDirection) && (width == writeBusWidth)) {
       return; // No change needed
@@ -32,31 +32,50 @@ class Shield80186;
 class Shield80286;
 class Shield80386;
 
+// A build only ever drives the one shield selected in config.h, so the cycle
+// engine tests these capability constants instead of runtime CPU-type checks
+// where a whole CPU-family code path can be compiled out. With the constant
+// false the branch folds away and the handler behind it is never referenced.
 template<typename Shield>
 struct ShieldTraits {
   static constexpr unsigned long kDebugBaudRate = DEBUG_BAUD_RATE; // Default baud rate
+  static constexpr bool kSupportsEmulation = false;   // NEC V20/V30 8080 emulation mode (BRKEM)
+  static constexpr bool kSupportsLoadall286 = false;  // 286 LOADALL/STOREALL register access
+  static constexpr bool kSupportsSmm386 = false;      // 386EX SMM register access
 };
 
 // Specialize for Shield8088
 template<>
 struct ShieldTraits<Shield8088> {
   static constexpr unsigned long kDebugBaudRate = DEBUG_BAUD_RATE;
+  static constexpr bool kSupportsEmulation = true; // NEC V20/V30
+  static constexpr bool kSupportsLoadall286 = false;
+  static constexpr bool kSupportsSmm386 = false;
 };
 
 // Specialize for Shield80186
 template<>
 struct ShieldTraits<Shield80186> {
   static constexpr unsigned long kDebugBaudRate = DEBUG_BAUD_RATE;
+  static constexpr bool kSupportsEmulation = false;
+  static constexpr bool kSupportsLoadall286 = false;
+  static constexpr bool kSupportsSmm386 = false;
 };
 
 // Specialize for Shield80286
 template<>
 struct ShieldTraits<Shield80286> {
   static constexpr unsigned long kDebugBaudRate = DEBUG_BAUD_RATE;
+  static constexpr bool kSupportsEmulation = false;
+  static constexpr bool kSupportsLoadall286 = true;
+  static constexpr bool kSupportsSmm386 = false;
 };
 
 // Specialize for Shield80386
 template<>
 struct ShieldTraits<Shield80386> {
   static constexpr unsigned long kDebugBaudRate = DEBUG_BAUD_RATE;
+  static constexpr bool kSupportsEmulation = false;
+  static constexpr bool kSupportsLoadall286 = false;
+  static constexpr bool kSupportsSmm386 = true;
 };
\ No newline at end of file
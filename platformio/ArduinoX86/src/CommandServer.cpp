@@ -34,6 +34,18 @@
 #include <DebugFilter.h>
 #include <programs.h>
 #include <bus_emulator/IBusBackend.h>
+#include <MemTelemetry.h>
+#include <TraceFormat.h>
+#include <ReadyTimer.h>
+#include <PinInjector.h>
+#include <FpuStub.h>
+#include <RefreshGenerator.h>
+
+#if defined(ARDUINO_GIGA)
+#include <mbed_stats.h>
+#endif
+
+#include "opcodes.h"
 
 #if defined (ARDUINO_GIGA)
 #define MAX_BUFFER_LEN 4096ul
@@ -41,6 +53,18 @@
 #define MAX_BUFFER_LEN 512ul
 #endif
 
+// Synthesize a randomized registers1_t image from a seed; defined after the
+// GenRand stream below, declared here for cmd_load().
+static void synth_load_regs(uint32_t seed, uint8_t constraint, uint16_t fixed_cs,
+                            uint16_t fixed_ip, uint8_t *out);
+
+// Constraint mask bits for seeded register randomization (CmdLoad type 4).
+#define REG_RAND_ALIGN_SP 0x01 // Force SP to an even address
+#define REG_RAND_CLEAR_TF 0x02 // Clear the trap flag
+#define REG_RAND_CLEAR_IF 0x04 // Clear the interrupt enable flag
+#define REG_RAND_CLEAR_DF 0x08 // Clear the direction flag
+#define REG_RAND_FIXED_CSIP 0x10 // Substitute the supplied CS:IP pair
+
 template<typename BoardType, typename ShieldType>
 CommandServer<BoardType,ShieldType>::CommandServer(BoardController<BoardType,ShieldType>& controller_)
   : controller_(controller_)
@@ -56,6 +80,10 @@ CommandServer<BoardType,ShieldType>::CommandServer(BoardController<BoardType,Shi
   if (controller_.getBoard().isDebugEnabled()) {
     flags_ |= FLAG_DEBUG_ENABLED;
   }
+
+#if !(USE_DUAL_CORE && defined(CORE_CM7))
+  rxRing_.reset();
+#endif
 }
 
 
@@ -74,6 +102,32 @@ void CommandServer<BoardType,ShieldType>::reset()
 template<typename BoardType, typename ShieldType>
 void CommandServer<BoardType,ShieldType>::run()
 {
+  // An async cycle log dump owns the protocol stream until it has drained;
+  // hold off new commands so response bytes can't interleave with dump data.
+  // With a dedicated trace channel the streams can't collide, so the dump
+  // drains in the background while commands keep executing.
+  if (ArduinoX86::CycleLogger->dump_in_progress()) {
+    ArduinoX86::CycleLogger->service();
+#if !TRACE_SERIAL_DEDICATED
+    return;
+#endif
+  }
+  if (responseDeferred_) {
+    responseDeferred_ = false;
+    send_ok();
+  }
+
+#if USE_DUAL_CORE && defined(CORE_CM7)
+  // The M4 front end assembles complete command frames; there is no
+  // byte-at-a-time parsing to do on this core.
+  run_dual_core();
+  return;
+#else
+  if (framedMode_) {
+    run_framed();
+    return;
+  }
+#endif
 
   switch (commandState_) {
 
@@ -107,7 +161,16 @@ void CommandServer<BoardType,ShieldType>::run()
           // We ignore command byte 0 (null command)
           break;
         } else if (command_bytes > 0) {
-          // This command requires input bytes before it is executed.
+          // This command requires input bytes before it is executed. If the
+          // client sent header and parameters back to back they are already
+          // buffered, so read them in one go and dispatch without bouncing
+          // through ReadingCommand on subsequent run() calls.
+          if (static_cast<size_t>(proto_available()) >= command_bytes) {
+            proto_read(commandBuffer_, command_bytes);
+            bool result = dispatch_command(cmd_);
+            finish_command(result);
+            break;
+          }
           commandByteN_ = 0;
           commandBytesExpected_ = command_bytes;
           commandStartTime_ = millis();  // Get start time for timeout calculation
@@ -117,11 +180,10 @@ void CommandServer<BoardType,ShieldType>::run()
           bool result = dispatch_command(cmd_);
           if (result) {
             debug_proto("Command OK!");
-            send_ok();
           } else {
             debug_proto("Command FAIL!");
-            send_fail();
           }
+          finish_command(result);
         }
       }
       break;
@@ -129,26 +191,23 @@ void CommandServer<BoardType,ShieldType>::run()
     case CommandState::ReadingCommand:
       // The previously specified command requires parameter bytes, so read them in, or timeout
       if (proto_available() > 0) {
-        // TODO: Read more than one byte at a time if available.
-        uint8_t param_byte = proto_read();
-
-        if (commandByteN_ < MAX_COMMAND_BYTES) {
-          commandBuffer_[commandByteN_++] = param_byte;
+        // Drain everything buffered toward the expected count rather than
+        // taking one byte per run() call.
+        size_t remaining = commandBytesExpected_ - commandByteN_;
+        size_t avail = static_cast<size_t>(proto_available());
+        size_t chunk = (avail < remaining) ? avail : remaining;
+        size_t got = proto_read(&commandBuffer_[commandByteN_], chunk);
+        commandByteN_ += got;
+
+        if (commandByteN_ == commandBytesExpected_) {
+          // We have received enough parameter bytes to execute the in-progress command.
+          bool result = dispatch_command(cmd_);
+          finish_command(result);
 
-          if (commandByteN_ == commandBytesExpected_) {
-            // We have received enough parameter bytes to execute the in-progress command.
-            bool result = dispatch_command(cmd_);
-            if (result) {
-              send_ok();
-            } else {
-              send_fail();
-            }
-
-            // Revert to listening for command
-            commandByteN_ = 0;
-            commandBytesExpected_ = 0;
-            commandState_ = CommandState::WaitingForCommand;
-          }
+          // Revert to listening for command
+          commandByteN_ = 0;
+          commandBytesExpected_ = 0;
+          commandState_ = CommandState::WaitingForCommand;
         }
       } else {
         // No bytes received yet, so keep track of how long we've been waiting
@@ -171,6 +230,197 @@ void CommandServer<BoardType,ShieldType>::run()
   }
 }
 
+#if USE_DUAL_CORE && defined(CORE_CM7)
+/// @brief Consume framed commands assembled by the M4 protocol front end.
+/// Frames arrive complete, so dispatch never waits on partial parameter
+/// bytes; the DC_FRAME_TIMEOUT marker stands in for the single-core
+/// parameter timeout path. Bumping cmd_done_seq after each command releases
+/// the M4 from payload passthrough for streaming commands.
+/// @tparam BoardType
+/// @tparam ShieldType
+template<typename BoardType, typename ShieldType>
+void CommandServer<BoardType,ShieldType>::run_dual_core()
+{
+  dual_core_pump();
+
+  DualCoreShm* shm = dual_core_shm();
+  if (shm->cmd_ring.available() < 2) {
+    return;
+  }
+
+  uint8_t cmd_byte = shm->cmd_ring.peek(0);
+  uint8_t param_len = shm->cmd_ring.peek(1);
+
+  if (param_len == DC_FRAME_TIMEOUT) {
+    // The M4 timed out collecting parameter bytes for this command.
+    shm->cmd_ring.skip(2);
+    debug_proto("Command timeout!");
+    send_fail();
+    shm->cmd_done_seq = shm->cmd_done_seq + 1;
+    return;
+  }
+
+  if (shm->cmd_ring.available() < (uint32_t)(2 + param_len)) {
+    // The frame header has landed but the M4 is still copying parameters.
+    return;
+  }
+
+  shm->cmd_ring.skip(2);
+  shm->cmd_ring.read(commandBuffer_, param_len);
+
+  if (cmd_byte >= static_cast<uint8_t>(ServerCommand::CmdInvalid)) {
+    send_fail();
+    shm->cmd_done_seq = shm->cmd_done_seq + 1;
+    return;
+  }
+
+  cmd_ = static_cast<ServerCommand>(cmd_byte);
+  if (cmd_ == ServerCommand::CmdNone) {
+    // We ignore command byte 0 (null command)
+    shm->cmd_done_seq = shm->cmd_done_seq + 1;
+    return;
+  }
+
+  if (cmd_ != ServerCommand::CmdServerStatus) {
+    controller_.getBoard().debugPrintf(
+      DebugType::CMD,
+      false,
+      "## CMD: Received command byte: %02X (%s)\n\r",
+      cmd_byte,
+      get_command_name(cmd_)
+    );
+  }
+
+  bool result = dispatch_command(cmd_);
+  finish_command(result);
+  shm->cmd_done_seq = shm->cmd_done_seq + 1;
+}
+#else
+/// @brief Consume framed protocol v2 commands (see protocol.h for the wire
+/// format). The RX ring stages whole frames, so the host may queue several
+/// frames back-to-back and read the status trailers afterwards; each pass
+/// services the frame at the head of the ring. A frame that fails its CRC is
+/// answered with a failure trailer and dropped, and the parser resynchronizes
+/// on the next start-of-frame byte instead of losing the session.
+/// @tparam BoardType
+/// @tparam ShieldType
+template<typename BoardType, typename ShieldType>
+void CommandServer<BoardType,ShieldType>::run_framed()
+{
+  // Resync: discard bytes until a start-of-frame byte heads the ring.
+  while (proto_available() > 0 && proto_peek() != PROTO_FRAME_SOF) {
+    proto_read();
+  }
+
+  int avail = proto_available();
+  if (avail == 0) {
+    frameStartTime_ = 0;
+    return;
+  }
+  if (frameStartTime_ == 0) {
+    frameStartTime_ = millis();
+  }
+
+  // Header is [SOF][seq][len]; the full frame is header + len + CRC16.
+  size_t need = 3;
+  uint8_t len = 0;
+  if (avail >= 3) {
+    len = rxRing_.peek(2);
+    need = 3 + (size_t)len + 2;
+  }
+  if ((size_t)avail < need || len == 0) {
+    if (millis() - frameStartTime_ >= CMD_TIMEOUT_) {
+      // Truncated or empty frame: drop the SOF byte and resync. The host
+      // notices the missing sequence number and retries the frame.
+      proto_read();
+      frameStartTime_ = 0;
+      debug_proto("Frame timeout!");
+    }
+    return;
+  }
+
+  uint8_t frame[3 + MAX_COMMAND_BYTES + 2];
+  proto_read(frame, need);
+  frameStartTime_ = 0;
+
+  uint8_t seq = frame[1];
+  uint16_t crc = proto_crc16_update(PROTO_CRC16_INIT, &frame[1], 2 + (size_t)len);
+  uint16_t rx_crc = frame[3 + len] | (static_cast<uint16_t>(frame[4 + len]) << 8);
+
+  frameSeq_ = seq;
+  frameActive_ = true;
+
+  if (crc != rx_crc) {
+    controller_.getBoard().debugPrintf(
+      DebugType::ERROR,
+      false,
+      "## proto: Frame %u failed CRC: %04X != %04X\n\r",
+      seq, crc, rx_crc
+    );
+    set_error("Frame %u failed CRC", seq);
+    send_fail();
+    return;
+  }
+
+  uint8_t cmd_byte = frame[3];
+  if (cmd_byte >= static_cast<uint8_t>(ServerCommand::CmdInvalid)) {
+    send_fail();
+    return;
+  }
+
+  cmd_ = static_cast<ServerCommand>(cmd_byte);
+  if (cmd_ == ServerCommand::CmdNone) {
+    // Unlike the classic protocol, a null command is acknowledged: it makes
+    // a cheap liveness and resync probe for the host.
+    send_ok();
+    return;
+  }
+
+  size_t command_bytes = get_command_input_bytes(cmd_);
+  if ((size_t)(len - 1) != command_bytes) {
+    set_error("Frame %u: bad parameter count for %s", seq, get_command_name(cmd_));
+    send_fail();
+    return;
+  }
+  memcpy(commandBuffer_, &frame[4], command_bytes);
+
+  if (cmd_ != ServerCommand::CmdServerStatus) {
+    controller_.getBoard().debugPrintf(
+      DebugType::CMD,
+      false,
+      "## CMD: Received frame %u: %02X (%s)\n\r",
+      seq,
+      cmd_byte,
+      get_command_name(cmd_)
+    );
+  }
+
+  bool result = dispatch_command(cmd_);
+  finish_command(result);
+}
+#endif // USE_DUAL_CORE && CORE_CM7
+
+/// @brief Sends the response byte for a completed command. If the command
+/// started an async cycle log dump, the response is deferred until the dump
+/// has fully drained so it follows the dump data on the wire.
+template<typename BoardType, typename ShieldType>
+void CommandServer<BoardType, ShieldType>::finish_command(bool result) {
+  if (result) {
+#if !TRACE_SERIAL_DEDICATED
+    if (ArduinoX86::CycleLogger->dump_in_progress()) {
+      // The dump drains to the shared stream directly; push out anything the
+      // command staged in the accumulator before the dump data follows it.
+      proto_flush();
+      responseDeferred_ = true;
+      return;
+    }
+#endif
+    send_ok();
+  } else {
+    send_fail();
+  }
+}
+
 /// @brief Returns the name of the command based on the ServerCommand enum.
 /// This is useful for debugging and logging purposes.
 /// @tparam BoardType 
@@ -221,6 +471,33 @@ const char* CommandServer<BoardType, ShieldType>::get_command_name(ServerCommand
       case ServerCommand::CmdServerStatus: return "CmdServerStatus";
       case ServerCommand::CmdClearCycleLog: return "CmdClearCycleLog";
       case ServerCommand::CmdSetProgramBounds: return "CmdSetProgramBounds";
+      case ServerCommand::CmdCycleBatch: return "CmdCycleBatch";
+      case ServerCommand::CmdUploadMemory: return "CmdUploadMemory";
+      case ServerCommand::CmdRunBatch: return "CmdRunBatch";
+      case ServerCommand::CmdGetCycleStatesC: return "CmdGetCycleStatesC";
+      case ServerCommand::CmdSetSocketGen: return "CmdSetSocketGen";
+      case ServerCommand::CmdSnapshotMemory: return "CmdSnapshotMemory";
+      case ServerCommand::CmdRestoreSnapshot: return "CmdRestoreSnapshot";
+      case ServerCommand::CmdGetTraceMeta: return "CmdGetTraceMeta";
+      case ServerCommand::CmdSetWatchpoint: return "CmdSetWatchpoint";
+      case ServerCommand::CmdGetWatchHit: return "CmdGetWatchHit";
+      case ServerCommand::CmdGetCycleStatesFrom: return "CmdGetCycleStatesFrom";
+      case ServerCommand::CmdCrcMemory: return "CmdCrcMemory";
+      case ServerCommand::CmdGetBusOps: return "CmdGetBusOps";
+      case ServerCommand::CmdSetBusLogCapacity: return "CmdSetBusLogCapacity";
+      case ServerCommand::CmdStreamMemory: return "CmdStreamMemory";
+      case ServerCommand::CmdSetWaitStates: return "CmdSetWaitStates";
+      case ServerCommand::CmdSetIntVector: return "CmdSetIntVector";
+      case ServerCommand::CmdSetPortHandler: return "CmdSetPortHandler";
+      case ServerCommand::CmdGenProgram: return "CmdGenProgram";
+      case ServerCommand::CmdSetReadyTimer: return "CmdSetReadyTimer";
+      case ServerCommand::CmdSetProfile: return "CmdSetProfile";
+      case ServerCommand::CmdGetStateProfile: return "CmdGetStateProfile";
+      case ServerCommand::CmdSetPinInject: return "CmdSetPinInject";
+      case ServerCommand::CmdSetFpuStub: return "CmdSetFpuStub";
+      case ServerCommand::CmdSetRefresh: return "CmdSetRefresh";
+      case ServerCommand::CmdGetFullState: return "CmdGetFullState";
+      case ServerCommand::CmdGetTestResult: return "CmdGetTestResult";
       case ServerCommand::CmdInvalid: return "CmdInvalid";
       default: return "Unknown";
   }
@@ -280,13 +557,43 @@ char CommandServer<BoardType, ShieldType>::get_state_char(ServerState state) {
   }
 }
 
-/// @brief Dispatches a command based on the command byte received.
+/// @brief Dispatches a command based on the command byte received, recording
+/// per-command latency and protocol byte counts around the handler (see
+/// cmd_server_status for the export format).
 /// @tparam BoardType
 /// @tparam ShieldType
 /// @param cmd_byte The command byte to dispatch.
 /// @return True if the command was successfully dispatched, false otherwise.
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::dispatch_command(ServerCommand cmd) {
+  size_t idx = static_cast<size_t>(cmd);
+  if (idx >= SERVER_COMMAND_COUNT) {
+    idx = static_cast<size_t>(ServerCommand::CmdInvalid);
+  }
+
+  const uint64_t read0 = protoBytesRead_;
+  const uint64_t written0 = protoBytesWritten_;
+  const uint32_t start_us = micros();
+
+  bool result = execute_command(cmd);
+
+  const uint32_t elapsed = micros() - start_us;
+  CommandStats& stats = commandStats_[idx];
+  stats.count++;
+  stats.total_us += elapsed;
+  if (elapsed > stats.max_us) {
+    stats.max_us = elapsed;
+  }
+  stats.bytes_read += protoBytesRead_ - read0;
+  stats.bytes_written += protoBytesWritten_ - written0;
+
+  return result;
+}
+
+/// @brief Route a command to its handler. Instrumentation lives in
+/// dispatch_command() so every entry point pays for it exactly once.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::execute_command(ServerCommand cmd) {
   switch(cmd) {
     case ServerCommand::CmdNone:
         return cmd_null();
@@ -369,7 +676,61 @@ bool CommandServer<BoardType, ShieldType>::dispatch_command(ServerCommand cmd) {
     case ServerCommand::CmdClearCycleLog:
         return cmd_clear_cycle_log();
     case ServerCommand::CmdSetProgramBounds:
-        return cmd_set_program_bounds();        
+        return cmd_set_program_bounds();
+    case ServerCommand::CmdCycleBatch:
+        return cmd_cycle_batch();
+    case ServerCommand::CmdUploadMemory:
+        return cmd_upload_memory();
+    case ServerCommand::CmdRunBatch:
+        return cmd_run_batch();
+    case ServerCommand::CmdGetCycleStatesC:
+        return cmd_get_cycle_states_c();
+    case ServerCommand::CmdSetSocketGen:
+        return cmd_set_socket_gen();
+    case ServerCommand::CmdSnapshotMemory:
+        return cmd_snapshot_memory();
+    case ServerCommand::CmdRestoreSnapshot:
+        return cmd_restore_snapshot();
+    case ServerCommand::CmdGetTraceMeta:
+        return cmd_get_trace_meta();
+    case ServerCommand::CmdSetWatchpoint:
+        return cmd_set_watchpoint();
+    case ServerCommand::CmdGetWatchHit:
+        return cmd_get_watch_hit();
+    case ServerCommand::CmdGetCycleStatesFrom:
+        return cmd_get_cycle_states_from();
+    case ServerCommand::CmdCrcMemory:
+        return cmd_crc_memory();
+    case ServerCommand::CmdGetBusOps:
+        return cmd_get_bus_ops();
+    case ServerCommand::CmdSetBusLogCapacity:
+        return cmd_set_bus_log_capacity();
+    case ServerCommand::CmdStreamMemory:
+        return cmd_stream_memory();
+    case ServerCommand::CmdSetWaitStates:
+        return cmd_set_wait_states();
+    case ServerCommand::CmdSetIntVector:
+        return cmd_set_int_vector();
+    case ServerCommand::CmdSetPortHandler:
+        return cmd_set_port_handler();
+    case ServerCommand::CmdGenProgram:
+        return cmd_gen_program();
+    case ServerCommand::CmdSetReadyTimer:
+        return cmd_set_ready_timer();
+    case ServerCommand::CmdSetProfile:
+        return cmd_set_profile();
+    case ServerCommand::CmdGetStateProfile:
+        return cmd_get_state_profile();
+    case ServerCommand::CmdSetPinInject:
+        return cmd_set_pin_inject();
+    case ServerCommand::CmdSetFpuStub:
+        return cmd_set_fpu_stub();
+    case ServerCommand::CmdSetRefresh:
+        return cmd_set_refresh();
+    case ServerCommand::CmdGetFullState:
+        return cmd_get_full_state();
+    case ServerCommand::CmdGetTestResult:
+        return cmd_get_test_result();
     case ServerCommand::CmdInvalid:
     default:
         return cmd_invalid();
@@ -387,7 +748,7 @@ bool CommandServer<BoardType, ShieldType>::cmd_version() {
 
   const char msg[] = "ardx86 ";
   proto_write((const uint8_t *)msg, sizeof(msg) - 1);
-  //INBAND_SERIAL.write((uint8_t *)VERSION_DAT, VERSION_DAT_LEN);
+  //proto_write((uint8_t *)VERSION_DAT, VERSION_DAT_LEN);
   proto_write(VERSION_NUM);
   proto_flush();
   delay(10);  // let USB complete the transaction
@@ -396,58 +757,15 @@ bool CommandServer<BoardType, ShieldType>::cmd_version() {
   return true;
 }
 
-/// @brief Get the number of input bytes expected from the client for a given command
-/// @tparam BoardType 
-/// @tparam ShieldType 
-/// @param cmd 
+/// @brief Get the number of input bytes expected from the client for a given command.
+/// The counts themselves live in protocol.h, shared with the M4 protocol front end.
+/// @tparam BoardType
+/// @tparam ShieldType
+/// @param cmd
 /// @return The number of input bytes expected for the command
 template<typename BoardType, typename ShieldType>
 uint8_t CommandServer<BoardType, ShieldType>::get_command_input_bytes(ServerCommand cmd) {
-    switch(cmd) {
-        case ServerCommand::CmdNone: return 0;
-        case ServerCommand::CmdVersion: return 0;
-        case ServerCommand::CmdResetCpu: return 0;
-        case ServerCommand::CmdLoad: return 1;  // Parameter: Type of register file to load
-        case ServerCommand::CmdCycle: return 1; // Parameter: Number of cycles to execute
-        case ServerCommand::CmdReadAddressLatch: return 0;
-        case ServerCommand::CmdReadStatus: return 0;
-        case ServerCommand::CmdRead8288Command: return 0;
-        case ServerCommand::CmdRead8288Control: return 0;
-        case ServerCommand::CmdReadDataBus: return 0;
-        case ServerCommand::CmdWriteDataBus: return 2; // Parameter: 16-bit value to write
-        case ServerCommand::CmdFinalize: return 0;
-        case ServerCommand::CmdBeginStore: return 0;
-        case ServerCommand::CmdStore: return 0;
-        case ServerCommand::CmdQueueLen: return 0;
-        case ServerCommand::CmdQueueBytes: return 0;
-        case ServerCommand::CmdWritePin: return 2; // Parameters: Pin to read, value to write
-        case ServerCommand::CmdReadPin: return 1;  // Parameter: Pin to read
-        case ServerCommand::CmdGetProgramState: return 0;
-        case ServerCommand::CmdLastError: return 0;
-        case ServerCommand::CmdGetCycleState: return 1; // Parameter: Flags. Bit 0 set to 1 will cycle CPU first
-        case ServerCommand::CmdAvailable00: return 0;  // Null
-        case ServerCommand::CmdPrefetchStore: return 0;
-        case ServerCommand::CmdReadAddress: return 0;
-        case ServerCommand::CmdCpuType: return 0;
-        case ServerCommand::CmdSetFlags: return 4; // Parameter: uint32_t flags to set
-        case ServerCommand::CmdPrefetch: return 0;
-        case ServerCommand::CmdInitScreen: return 0;
-        case ServerCommand::CmdStoreAll: return 0;
-        case ServerCommand::CmdSetRandomSeed: return 4; // Parameter: uint32_t seed for randomization
-        case ServerCommand::CmdRandomizeMem: return 4; // Parameter: uint32_t seed for randomization
-        case ServerCommand::CmdSetMemory: return 8; // Parameters: address (4 bytes) and size (4 bytes).
-        case ServerCommand::CmdGetCycleStates: return 0; 
-        case ServerCommand::CmdEnableDebug: return 1; // Parameter: 0 to disable debug, 1 to enable debug
-        case ServerCommand::CmdSetMemoryStrategy: return 9; // Parameters: Strategy (1 byte), start_addr (4 bytes), end_addr (4 bytes).
-        case ServerCommand::CmdGetFlags: return 0;
-        case ServerCommand::CmdReadMemory: return 8; // Parameters: address (4 bytes) and size (4 bytes).
-        case ServerCommand::CmdEraseMemory: return 0;
-        case ServerCommand::CmdServerStatus: return 0;
-        case ServerCommand::CmdClearCycleLog: return 0; // No parameters needed to clear cycle log
-        case ServerCommand::CmdSetProgramBounds: return 8; // Parameters: start_addr (4 bytes), end_addr (4 bytes).
-        case ServerCommand::CmdInvalid: return 0;
-        default: return 0;
-    }
+    return server_command_param_bytes(cmd);
 }
 
 template<typename BoardType, typename ShieldType>
@@ -628,7 +946,16 @@ void CommandServer<BoardType, ShieldType>::change_state(ServerState new_state) {
   // Report time we spent in the previous state.
   if (stateBeginTime_ != 0) {
     uint32_t elapsed = state_end_time - stateBeginTime_;
-    controller_.getBoard().debugPrintf(DebugType::STATE, false, 
+
+    // Dwell profiler: attribute the elapsed time to the state being left.
+    StateDwell& dwell = stateDwell_[static_cast<size_t>(state_)];
+    dwell.total_us += elapsed;
+    dwell.entries++;
+    if (elapsed > dwell.max_us) {
+      dwell.max_us = elapsed;
+    }
+
+    controller_.getBoard().debugPrintf(DebugType::STATE, false,
       "## Changing to state: %s. Spent %lu us in previous state. ##\n\r", 
       get_state_string(new_state), elapsed);
   }
@@ -656,6 +983,12 @@ bool CommandServer<BoardType, ShieldType>::cmd_reset_cpu() {
   
   result = controller_.resetCpu();
   CPU.reset(result, true);
+  // Cycle counts restart at zero, so any armed pin injections would re-fire
+  // at stale offsets; each run programs its own. A running FPU BUSY window
+  // is likewise abandoned (its configuration persists).
+  pin_inject_clear();
+  fpu_stub_reset();
+  refresh_gen_reset();
   if (result.success) {
     CPU.have_queue_status = result.queueStatus;
     change_state(ServerState::Execute);
@@ -707,7 +1040,6 @@ template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_load() {
 
   clear_error();
-  volatile uint8_t *read_p = nullptr;
   uint8_t reg_type = commandBuffer_[0];
   bool read_result = false;
   bool reset_cpu = true;
@@ -723,19 +1055,6 @@ bool CommandServer<BoardType, ShieldType>::cmd_load() {
         set_error("Failed to read parameter bytes");
         return false;
       }
-
-      // Write raw command bytes over register struct.
-      // All possible bit representations are valid.
-      read_p = reinterpret_cast<volatile uint8_t*>(&CPU.load_regs);
-      for (size_t i = 0; i < sizeof(registers1_t); i++) {
-        *read_p++ = commandBuffer_[i];
-      }
-
-      patch_load_pgm(&LOAD_PROGRAM, &CPU.load_regs);
-      patch_brkem_pgm(&EMU_ENTER_PROGRAM, &CPU.load_regs);
-
-      CPU.load_regs.flags &= CPU_FLAG_DEFAULT_CLEAR_8086;
-      CPU.load_regs.flags |= CPU_FLAG_DEFAULT_SET_8086;
       break;
 
     case 1:
@@ -746,15 +1065,6 @@ bool CommandServer<BoardType, ShieldType>::cmd_load() {
         set_error("Failed to read parameter bytes");
         return false;
       }
-
-      // Write raw command bytes over register struct.
-      read_p = reinterpret_cast<volatile uint8_t*>(&CPU.loadall_regs_286);
-      for (size_t i = 0; i < sizeof(Loadall286); i++) {
-        *read_p++ = commandBuffer_[i];
-      }
-
-      CPU.loadall_regs_286.flags &= CPU_FLAG_DEFAULT_CLEAR_286;
-      CPU.loadall_regs_286.flags |= CPU_FLAG_DEFAULT_SET_286;
       break;
 
     case 2:
@@ -765,15 +1075,6 @@ bool CommandServer<BoardType, ShieldType>::cmd_load() {
         set_error("Failed to read parameter bytes");
         return false;
       }
-
-      // Write raw command bytes over register struct.
-      read_p = reinterpret_cast<volatile uint8_t*>(&CPU.loadall_regs_386);
-      for (size_t i = 0; i < sizeof(Loadall386); i++) {
-        *read_p++ = commandBuffer_[i];
-      }
-
-      CPU.loadall_regs_386.eflags &= CPU_FLAG_DEFAULT_CLEAR_386;
-      CPU.loadall_regs_386.eflags |= CPU_FLAG_DEFAULT_SET_386;
       break;
 
     case 3:
@@ -803,18 +1104,129 @@ bool CommandServer<BoardType, ShieldType>::cmd_load() {
         // Write raw command bytes over register struct.
         memcpy((void *)smm_dump, (void*)commandBuffer_, sizeof(SmmDump386));
 
+        // Serialize the image into the SMRAM staging window once, so the
+        // per-cycle SMM read path is a plain indexed load.
+        ArduinoX86::Bus->smm_stage_load();
+
         // Unlike other register loads, we do not reset the CPU when leaving SMM.
         reset_cpu = false;
         ArduinoX86::Server.change_state(ServerState::LoadSmm);
       }
       break;
-      
+
+    case 4:
+      {
+        // Seeded register randomization for 8088-80186. Instead of a full
+        // registers1_t, the host ships a seed (4 bytes), a constraint mask
+        // (1 byte, REG_RAND_*) and a CS:IP pair (4 bytes, used when
+        // REG_RAND_FIXED_CSIP is set). The register file is synthesized from
+        // the same keyed murmur3 stream the on-device program generator
+        // uses, so one seed reproduces the same registers host-side.
+        Controller.getBoard().debugPrintln(DebugType::LOAD, "## cmd_load(): Synthesizing randomized register struct from seed");
+        read_result = readParameterBytes(commandBuffer_, sizeof(commandBuffer_), 9);
+        if (!read_result) {
+          Controller.getBoard().debugPrintln(DebugType::ERROR, "## cmd_load(): Timed out reading parameter bytes");
+          set_error("Failed to read parameter bytes");
+          return false;
+        }
+        uint32_t seed = commandBuffer_[0] |
+                        (static_cast<uint32_t>(commandBuffer_[1]) << 8) |
+                        (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
+                        (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+        uint8_t constraint = commandBuffer_[4];
+        uint16_t fixed_cs = commandBuffer_[5] | (static_cast<uint16_t>(commandBuffer_[6]) << 8);
+        uint16_t fixed_ip = commandBuffer_[7] | (static_cast<uint16_t>(commandBuffer_[8]) << 8);
+
+        // Synthesize the registers1_t image in place over commandBuffer_ so
+        // the standard install path below consumes it unchanged.
+        synth_load_regs(seed, constraint, fixed_cs, fixed_ip, commandBuffer_);
+        reg_type = 0;
+      }
+      break;
+
     default:
       set_error("Invalid register type");
       return false;
       break;
   }
 
+  if (reg_type <= 2 && !install_registers(reg_type)) {
+    return false;
+  }
+
+  return reset_and_load(reset_cpu);
+}
+
+/// @brief Install a register file from commandBuffer_ into the CPU's load
+/// structures. Shared by cmd_load() and the batch test executor; the caller
+/// has already read the raw struct bytes into commandBuffer_.
+/// @param reg_type Register struct type, as for CmdLoad (0-2; SMM loads are
+/// handled separately by cmd_load()).
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::install_registers(uint8_t reg_type) {
+
+  volatile uint8_t *read_p = nullptr;
+
+  switch (reg_type) {
+    case 0:
+      // Write raw command bytes over register struct.
+      // All possible bit representations are valid.
+      read_p = reinterpret_cast<volatile uint8_t*>(&CPU.load_regs);
+      for (size_t i = 0; i < sizeof(registers1_t); i++) {
+        *read_p++ = commandBuffer_[i];
+      }
+
+      patch_load_pgm(&LOAD_PROGRAM, &CPU.load_regs);
+      patch_brkem_pgm(&EMU_ENTER_PROGRAM, &CPU.load_regs);
+
+      CPU.load_regs.flags &= CPU_FLAG_DEFAULT_CLEAR_8086;
+      CPU.load_regs.flags |= CPU_FLAG_DEFAULT_SET_8086;
+      break;
+
+    case 1:
+      // Write raw command bytes over register struct.
+      read_p = reinterpret_cast<volatile uint8_t*>(&CPU.loadall_regs_286);
+      for (size_t i = 0; i < sizeof(Loadall286); i++) {
+        *read_p++ = commandBuffer_[i];
+      }
+
+      CPU.loadall_regs_286.flags &= CPU_FLAG_DEFAULT_CLEAR_286;
+      CPU.loadall_regs_286.flags |= CPU_FLAG_DEFAULT_SET_286;
+
+      // The register struct is already the flat Loadall memory image; stage
+      // it in the bus emulator once per register set so the Load handler can
+      // serve the 0x800 shadow reads through the normal backend read path.
+      ArduinoX86::Bus->set_memory(
+        LOADALL286_ADDRESS,
+        reinterpret_cast<uint8_t*>(const_cast<Loadall286*>(&CPU.loadall_regs_286)),
+        sizeof(Loadall286));
+      break;
+
+    case 2:
+      // Write raw command bytes over register struct.
+      read_p = reinterpret_cast<volatile uint8_t*>(&CPU.loadall_regs_386);
+      for (size_t i = 0; i < sizeof(Loadall386); i++) {
+        *read_p++ = commandBuffer_[i];
+      }
+
+      CPU.loadall_regs_386.eflags &= CPU_FLAG_DEFAULT_CLEAR_386;
+      CPU.loadall_regs_386.eflags |= CPU_FLAG_DEFAULT_SET_386;
+      break;
+
+    default:
+      set_error("Invalid register type");
+      return false;
+  }
+
+  return true;
+}
+
+/// @brief Reset the CPU (unless an SMM load is keeping it live) and cycle it
+/// through the load program until the Execute state is reached. Shared by
+/// cmd_load() and the batch test executor.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::reset_and_load(bool reset_cpu) {
+
   if (reset_cpu) {
     ArduinoX86::Server.change_state(ServerState::Reset);
     CpuResetResult result = Controller.resetCpu();
@@ -868,9 +1280,9 @@ bool CommandServer<BoardType, ShieldType>::cmd_load() {
 // Read back the contents of the address latch as a sequence of 3 bytes (little-endian)
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_read_address_latch() {
-  INBAND_SERIAL.write((uint8_t)(CPU.address_latch() & 0xFF));
-  INBAND_SERIAL.write((uint8_t)((CPU.address_latch() >> 8) & 0xFF));
-  INBAND_SERIAL.write((uint8_t)((CPU.address_latch() >> 16) & 0xFF));
+  proto_write((uint8_t)(CPU.address_latch() & 0xFF));
+  proto_write((uint8_t)((CPU.address_latch() >> 8) & 0xFF));
+  proto_write((uint8_t)((CPU.address_latch() >> 16) & 0xFF));
   return true;
 }
 
@@ -880,9 +1292,9 @@ template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_read_address() {
   //read_address_pins(true);
   CPU.address_bus = Controller.readAddressBus(true);
-  INBAND_SERIAL.write((uint8_t)(CPU.address_bus & 0xFF));
-  INBAND_SERIAL.write((uint8_t)((CPU.address_bus >> 8) & 0xFF));
-  INBAND_SERIAL.write((uint8_t)((CPU.address_bus >> 16) & 0xFF));
+  proto_write((uint8_t)(CPU.address_bus & 0xFF));
+  proto_write((uint8_t)((CPU.address_bus >> 8) & 0xFF));
+  proto_write((uint8_t)((CPU.address_bus >> 16) & 0xFF));
   return true;
 }
 
@@ -897,7 +1309,7 @@ bool CommandServer<BoardType, ShieldType>::cmd_invalid() {
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_read_status() {
   CPU.status0 = Controller.readCpuStatusLines();
-  INBAND_SERIAL.write(CPU.status0);
+  proto_write(CPU.status0);
   return true;
 }
 
@@ -906,7 +1318,7 @@ template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_read_8288_command() {
   CPU.command_bits = Controller.readBusControllerCommandLines();
   //read_8288_command_bits();
-  INBAND_SERIAL.write(CPU.command_bits);
+  proto_write(CPU.command_bits);
   return true;
 }
 
@@ -915,15 +1327,15 @@ template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_read_8288_control() {
   Controller.readBusControllerControlLines();
   //read_8288_control_bits();
-  INBAND_SERIAL.write(CPU.control_bits);
+  proto_write(CPU.control_bits);
   return true;
 }
 
 // Server command - ReadDataBus
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_read_data_bus() {
-  INBAND_SERIAL.write((uint8_t)CPU.data_bus);
-  INBAND_SERIAL.write((uint8_t)(CPU.data_bus >> 8));
+  proto_write((uint8_t)CPU.data_bus);
+  proto_write((uint8_t)(CPU.data_bus >> 8));
   return true;
 }
 
@@ -1056,6 +1468,76 @@ bool CommandServer<BoardType, ShieldType>::cmd_begin_store(void) {
   return true;
 }
 
+/// @brief Write the registers captured by an automatic-mode store to the
+/// protocol stream, preceded by a format byte. Shared by cmd_store() and the
+/// batch test executor. Only valid once the state machine has reached
+/// StoreDone/StoreDoneSmm with the registers sitting in the bus emulator.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::write_stored_registers(void) {
+
+  size_t write_len = 0;
+
+  switch (CPU.cpu_type) {
+    case CpuType::i80286:
+      {
+        // If we are in automatic mode, we can just return the stored registers
+        // without executing the Store program.
+        proto_write((uint8_t)0x01); // Send 0x01 to indicate V2 register format.
+        Loadall286 regs = ArduinoX86::Bus->loadall286_regs();
+        // Patch the registers with the call stack frame from NMI.
+        if (CPU.nmi_terminate) {
+          // If we terminated with NMI, we need to patch the registers with the NMI call stack frame.
+          controller_.getBoard().debugPrintln(DebugType::STORE, "## STORE: Patching registers with NMI call stack frame...");
+          regs.patch_stack_frame(CPU.nmi_stack_frame);
+        }
+        // Dump the raw byte representation of the registers to the serial port.
+        uint8_t *reg_p = (uint8_t *)&regs;
+        proto_write(reg_p, sizeof(Loadall286));
+      }
+      return true;
+      break;
+    case CpuType::i80386:
+      {
+        if (useSmm_) {
+          // Send 3 to indicate V3B register format.
+          proto_write((uint8_t)3);
+          // Write the registers in the V3B format.
+          SmmDump386 smm386 = ArduinoX86::Bus->smm_dump386_regs();
+          smm386.normalize_flags();
+          proto_write((uint8_t *)&smm386, sizeof(SmmDump386));
+          write_len = sizeof(SmmDump386);
+          controller_.getBoard().debugPrintf(
+            DebugType::STORE,
+            false,
+            "## STORE: Wrote %d bytes of registers in V3B format.\n\r",
+            write_len
+          );
+        }
+        else {
+          // Send 2 to indicate V3A register format.
+          proto_write((uint8_t)2);
+          // Write the registers in the V3A format.
+          Loadall386 regs368 = ArduinoX86::Bus->loadall386_regs();
+          proto_write((uint8_t *)&regs368, sizeof(Loadall386));
+          write_len = sizeof(Loadall386);
+          controller_.getBoard().debugPrintf(
+            DebugType::STORE,
+            false,
+            "## STORE: Wrote %d bytes of registers in V3A format.\n\r",
+            write_len
+          );
+        }
+
+      }
+      return true;
+      break;
+    default:
+      controller_.getBoard().debugPrintf(DebugType::ERROR, false, "## STORE: Unsupported CPU model for automatic mode");
+      return false;
+  }
+  return true;
+}
+
 // Server command - Store
 //
 // Returns values of registers in the following order, little-endian
@@ -1064,8 +1546,6 @@ bool CommandServer<BoardType, ShieldType>::cmd_begin_store(void) {
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_store(void) {
 
-  size_t write_len = 0;
-
   if (flags_ & FLAG_EXECUTE_AUTOMATIC) {
     // In automatic mode, Store command is only valid in StoreDone state.
     if ((state_ != ServerState::StoreDone) && (state_ != ServerState::StoreDoneSmm)) {
@@ -1074,63 +1554,7 @@ bool CommandServer<BoardType, ShieldType>::cmd_store(void) {
       return false;
     }
 
-    switch (CPU.cpu_type) {
-      case CpuType::i80286:
-        {
-          // If we are in automatic mode, we can just return the stored registers
-          // without executing the Store program.
-          INBAND_SERIAL.write((uint8_t)0x01); // Send 0x01 to indicate V2 register format.
-          Loadall286 regs = ArduinoX86::Bus->loadall286_regs();
-          // Patch the registers with the call stack frame from NMI.
-          if (CPU.nmi_terminate) {
-            // If we terminated with NMI, we need to patch the registers with the NMI call stack frame.
-            controller_.getBoard().debugPrintln(DebugType::STORE, "## STORE: Patching registers with NMI call stack frame...");
-            regs.patch_stack_frame(CPU.nmi_stack_frame);
-          }
-          // Dump the raw byte representation of the registers to the serial port.
-          uint8_t *reg_p = (uint8_t *)&regs;
-          INBAND_SERIAL.write(reg_p, sizeof(Loadall286));
-        }
-        return true;
-        break;
-      case CpuType::i80386:
-        {
-          if (useSmm_) {
-            // Send 3 to indicate V3B register format.
-            INBAND_SERIAL.write((uint8_t)3);
-            // Write the registers in the V3B format.
-            SmmDump386 smm386 = ArduinoX86::Bus->smm_dump386_regs();
-            smm386.normalize_flags();
-            write_len = INBAND_SERIAL.write((uint8_t *)&smm386, sizeof(SmmDump386));
-            controller_.getBoard().debugPrintf(
-              DebugType::STORE, 
-              false, 
-              "## STORE: Wrote %d bytes of registers in V3B format.\n\r", 
-              write_len
-            );
-          }
-          else {
-            // Send 2 to indicate V3A register format.
-            INBAND_SERIAL.write((uint8_t)2);
-            // Write the registers in the V3A format.
-            Loadall386 regs368 = ArduinoX86::Bus->loadall386_regs();
-            write_len = INBAND_SERIAL.write((uint8_t *)&regs368, sizeof(Loadall386));
-            controller_.getBoard().debugPrintf(
-              DebugType::STORE, 
-              false, 
-              "## STORE: Wrote %d bytes of registers in V3A format.\n\r", 
-              write_len
-            );
-          }
-
-        }
-        return true;
-        break;
-      default:
-        controller_.getBoard().debugPrintf(DebugType::ERROR, false, "## STORE: Unsupported CPU model for automatic mode");
-        return false;
-    }
-    return true;
+    return write_stored_registers();
   }
   else {
     // In non-automatic mode, Store Command is only valid in ExecuteDone state
@@ -1174,17 +1598,17 @@ bool CommandServer<BoardType, ShieldType>::cmd_store(void) {
     case CpuType::i80186:
     case CpuType::i80286:
       // Send 0 to indicate V1 register format.
-      INBAND_SERIAL.write((uint8_t)0);
+      proto_write((uint8_t)0);
       // Write the registers in the V1 format.
-      INBAND_SERIAL.write((uint8_t *)&CPU.post_regs, sizeof(registers1_t));
+      proto_write((uint8_t *)&CPU.post_regs, sizeof(registers1_t));
       break;
 
     case CpuType::i80386:
       // Send 2 to indicate V3 register format.
-      INBAND_SERIAL.write((uint8_t)2);
+      proto_write((uint8_t)2);
       // Write the registers in the V2 format.
       regs368 = ArduinoX86::Bus->loadall386_regs();
-      INBAND_SERIAL.write((uint8_t *)&regs368, sizeof(Loadall386));
+      proto_write((uint8_t *)&regs368, sizeof(Loadall386));
       controller_.getBoard().debugPrintf(DebugType::STORE, false, "## STORE: Wrote %d bytes of registers in V3 format.\n\r", sizeof(Loadall386));
       break;
 
@@ -1208,7 +1632,7 @@ bool CommandServer<BoardType, ShieldType>::cmd_store(void) {
 // Return the length of the instruction queue in bytes
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_queue_len(void) {
-  INBAND_SERIAL.write(static_cast<uint8_t>(CPU.queue.len()));
+  proto_write(static_cast<uint8_t>(CPU.queue.len()));
   return true;
 }
 
@@ -1217,7 +1641,7 @@ bool CommandServer<BoardType, ShieldType>::cmd_queue_len(void) {
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_queue_bytes(void) {
   for (size_t i = 0; i < CPU.queue.len(); i++) {
-    INBAND_SERIAL.write(static_cast<uint8_t>(CPU.queue.read_byte(i)));
+    proto_write(static_cast<uint8_t>(CPU.queue.read_byte(i)));
   }
   return true;
 }
@@ -1306,7 +1730,7 @@ bool CommandServer<BoardType, ShieldType>::cmd_read_pin(void) {
       state = false;
   }
 
-  INBAND_SERIAL.write((uint8_t)(value ? 1 : 0));
+  proto_write((uint8_t)(value ? 1 : 0));
   return state;
 }
 
@@ -1319,14 +1743,14 @@ bool CommandServer<BoardType, ShieldType>::cmd_get_program_state(void) {
     "## cmd_get_program_state(): State: %s Raw: %02X\n\r", 
     get_state_string(state_), 
     state_);
-  INBAND_SERIAL.write((uint8_t)state_);
+  proto_write((uint8_t)state_);
   return true;
 }
 
 // Server command - Get last error
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_get_last_error(void) {
-  INBAND_SERIAL.write(errorBuffer_);
+  proto_write((const uint8_t *)errorBuffer_, strlen(errorBuffer_));
   return true;
 }
 
@@ -1344,6 +1768,16 @@ bool CommandServer<BoardType, ShieldType>::cmd_get_cycle_state(void) {
     cycle();
   }
 
+  fill_cycle_state_buf(send_buf);
+  // Send the state bytes
+  proto_write(send_buf, sizeof(send_buf));
+  return true;
+}
+
+/// @brief Fill an 11-byte buffer with the per-cycle state info returned by
+/// CmdGetCycleState and CmdCycleBatch.
+template<typename BoardType, typename ShieldType>
+void CommandServer<BoardType, ShieldType>::fill_cycle_state_buf(uint8_t* buf) {
   //CPU.status0 = Controller.readCpuStatusLines();
   CPU.command_bits = Controller.readBusControllerCommandLines();
   CPU.control_bits = Controller.readBusControllerControlLines();
@@ -1355,20 +1789,100 @@ bool CommandServer<BoardType, ShieldType>::cmd_get_cycle_state(void) {
 
   cpu_state_byte |= ((uint8_t)(CPU.last_bus_cycle)) & 0x07; // Bits 0-2: Bus cycle
 
-  send_buf[0] = server_state; // Byte 0
-  send_buf[1] = cpu_state_byte; // Byte 1
-  send_buf[2] = CPU.status0; // Byte 2
-  send_buf[3] = CPU.control_bits; // Byte 3
-  send_buf[4] = CPU.command_bits; // Byte 4
-  send_buf[5] = (uint8_t)(CPU.address_bus & 0xFF); // Bytes 5-8
-  send_buf[6] = (uint8_t)((CPU.address_bus >> 8) & 0xFF);
-  send_buf[7] = (uint8_t)((CPU.address_bus >> 16) & 0xFF);
-  send_buf[8] = (uint8_t)((CPU.address_bus >> 24) & 0xFF);
-  send_buf[9] = (uint8_t)(CPU.data_bus & 0xFF); // Bytes 9-10
-  send_buf[10] = (uint8_t)(CPU.data_bus >> 8);
-  // Send the state bytes
-  INBAND_SERIAL.write(send_buf, sizeof(send_buf));
-  return true;
+  buf[0] = server_state; // Byte 0
+  buf[1] = cpu_state_byte; // Byte 1
+  buf[2] = CPU.status0; // Byte 2
+  buf[3] = CPU.control_bits; // Byte 3
+  buf[4] = CPU.command_bits; // Byte 4
+  buf[5] = (uint8_t)(CPU.address_bus & 0xFF); // Bytes 5-8
+  buf[6] = (uint8_t)((CPU.address_bus >> 8) & 0xFF);
+  buf[7] = (uint8_t)((CPU.address_bus >> 16) & 0xFF);
+  buf[8] = (uint8_t)((CPU.address_bus >> 24) & 0xFF);
+  buf[9] = (uint8_t)(CPU.data_bus & 0xFF); // Bytes 9-10
+  buf[10] = (uint8_t)(CPU.data_bus >> 8);
+}
+
+// Server command - GetFullState
+// Return the complete per-cycle machine state in one response, replacing the
+// ReadStatus + ReadAddressLatch + ReadDataBus + QueueLen (+ Read8288Command/
+// Control) polling sequence interactive stepping clients issue after every
+// cycle. Returns 39 bytes:
+//   0     server state
+//   1-4   address latch (little-endian)
+//   5-8   address bus (little-endian, freshly read)
+//   9-10  data bus (little-endian)
+//   11    status0 (freshly read)
+//   12    8288 command bits (freshly read)
+//   13    8288 control bits (freshly read)
+//   14    queue length
+//   15-30 queue contents (unused slots zero)
+//   31-38 cycle count (little-endian)
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_get_full_state(void) {
+  uint8_t send_buf[39] = { 0 };
+
+  CPU.status0 = Controller.readCpuStatusLines();
+  CPU.command_bits = Controller.readBusControllerCommandLines();
+  CPU.control_bits = Controller.readBusControllerControlLines();
+  CPU.address_bus = Controller.readAddressBus(true);
+
+  send_buf[0] = ((uint8_t)state_) & 0x3F;
+  uint32_t latch = CPU.address_latch();
+  send_buf[1] = (uint8_t)(latch & 0xFF);
+  send_buf[2] = (uint8_t)((latch >> 8) & 0xFF);
+  send_buf[3] = (uint8_t)((latch >> 16) & 0xFF);
+  send_buf[4] = (uint8_t)((latch >> 24) & 0xFF);
+  send_buf[5] = (uint8_t)(CPU.address_bus & 0xFF);
+  send_buf[6] = (uint8_t)((CPU.address_bus >> 8) & 0xFF);
+  send_buf[7] = (uint8_t)((CPU.address_bus >> 16) & 0xFF);
+  send_buf[8] = (uint8_t)((CPU.address_bus >> 24) & 0xFF);
+  send_buf[9] = (uint8_t)(CPU.data_bus & 0xFF);
+  send_buf[10] = (uint8_t)(CPU.data_bus >> 8);
+  send_buf[11] = CPU.status0;
+  send_buf[12] = CPU.command_bits;
+  send_buf[13] = CPU.control_bits;
+  send_buf[14] = (uint8_t)CPU.queue.len();
+  for (size_t i = 0; i < CPU.queue.len(); i++) {
+    send_buf[15 + i] = CPU.queue.read_byte(i);
+  }
+  uint64_t cycles = CPU.cycle_ct();
+  for (size_t i = 0; i < 8; i++) {
+    send_buf[31 + i] = (uint8_t)((cycles >> (i * 8)) & 0xFF);
+  }
+
+  proto_write(send_buf, sizeof(send_buf));
+  return true;
+}
+
+// Server command - CycleBatch
+// Execute the specified number of CPU cycles on-device, streaming back the
+// 11-byte cycle state for each one in a single response. The data bus is
+// resolved from the bus emulator each cycle as if FLAG_RESOLVE_BUS_STEP were
+// set, so the client does not need to intervene per-cycle.
+// Parameter: 16-bit cycle count (little-endian).
+// Returns: 2 bytes (count executed), followed by count * 11 bytes of state.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_cycle_batch(void) {
+  uint8_t send_buf[11] = { 0 };
+  uint16_t cycle_ct = commandBuffer_[0] | ((uint16_t)commandBuffer_[1] << 8);
+
+  // Apply bus resolution for the duration of the batch so each cycle's
+  // memory reads are satisfied from the bus emulator inline.
+  uint32_t saved_flags = flags_;
+  flags_ |= FLAG_RESOLVE_BUS_STEP;
+
+  proto_write((uint8_t)(cycle_ct & 0xFF));
+  proto_write((uint8_t)(cycle_ct >> 8));
+
+  for (uint16_t i = 0; i < cycle_ct; i++) {
+    cycle();
+    fill_cycle_state_buf(send_buf);
+    proto_write(send_buf, sizeof(send_buf));
+  }
+
+  flags_ = saved_flags;
+  proto_flush();
+  return true;
 }
 
 // Server command - Set flags
@@ -1404,12 +1918,12 @@ bool CommandServer<BoardType, ShieldType>::cmd_set_flags(void) {
   if ((new_flags & CommandServer::FLAG_USE_SDRAM_BACKEND) && !(flags_ & CommandServer::FLAG_USE_SDRAM_BACKEND)) {
     // SDRAM backend is requested, but not currently enabled. Replace backend.
     controller_.getBoard().debugPrintln(DebugType::CMD, "## cmd_set_flags(): Enabling SDRAM memory backend ##");
-    ArduinoX86::Bus->replace_backend(new SdramBackend(MEMORY_SIZE, ADDRESS_SPACE_MASK));
+    ArduinoX86::Bus->use_sdram_backend();
   }
   else if (!(new_flags & CommandServer::FLAG_USE_SDRAM_BACKEND) && (flags_ & CommandServer::FLAG_USE_SDRAM_BACKEND)) {
     // SDRAM backend is disabled, but currently enabled. Replace backend.
     controller_.getBoard().debugPrintln(DebugType::CMD, "## cmd_set_flags(): Enabling HashTable memory backend ##");
-    ArduinoX86::Bus->replace_backend(new HashBackend());
+    ArduinoX86::Bus->use_hash_backend();
   }
 
   if ((new_flags & CommandServer::FLAG_USE_SMM) && !(flags_ & CommandServer::FLAG_USE_SMM)) {
@@ -1459,6 +1973,24 @@ bool CommandServer<BoardType, ShieldType>::cmd_set_flags(void) {
     controller_.getBoard().debugPrintln(DebugType::CMD, "## cmd_set_flags(): Disabling bus resolution during step ##");
   }
 
+  if ((new_flags & CommandServer::FLAG_FRAMED_PROTOCOL) && !(flags_ & CommandServer::FLAG_FRAMED_PROTOCOL)) {
+#if USE_DUAL_CORE && defined(CORE_CM7)
+    // The M4 protocol front end frames commands its own way; framed v2
+    // parsing lives in the single-core protocol path only.
+    controller_.getBoard().debugPrintln(DebugType::ERROR, "## cmd_set_flags(): Framed protocol unsupported on dual-core builds ##");
+    return false;
+#else
+    // The acknowledgment for this command is still sent bare; every
+    // subsequent command must arrive as a v2 frame.
+    controller_.getBoard().debugPrintln(DebugType::CMD, "## cmd_set_flags(): Enabling framed protocol ##");
+    framedMode_ = true;
+#endif
+  }
+  else if (!(new_flags & CommandServer::FLAG_FRAMED_PROTOCOL) && (flags_ & CommandServer::FLAG_FRAMED_PROTOCOL)) {
+    controller_.getBoard().debugPrintln(DebugType::CMD, "## cmd_set_flags(): Disabling framed protocol ##");
+    framedMode_ = false;
+  }
+
   flags_ = new_flags;
   return true;
 }
@@ -1495,7 +2027,7 @@ bool CommandServer<BoardType, ShieldType>::cmd_init_screen() {
     byte0 = 1;
     screen_init_requested = true;
   #endif
-  INBAND_SERIAL.write(byte0);
+  proto_write(byte0);
   return true;
 }
 
@@ -1522,10 +2054,28 @@ bool CommandServer<BoardType, ShieldType>::cmd_set_random_seed() {
                   (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
                   (static_cast<uint32_t>(commandBuffer_[3]) << 24);
 
-  randomSeed(static_cast<unsigned long>(seed));  
+  randomSeed(static_cast<unsigned long>(seed));
+  profileSeed_ = seed;
   return true;
 }
 
+// Server command - SetSocketGen
+// Set the host's socket generation counter. A changed value invalidates the
+// persistent CPU identification cache and re-runs identification, forcing
+// re-detection after a chip swap without a cold boot.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_socket_gen() {
+  debug_cmd("In cmd_set_socket_gen()");
+  clear_error();
+
+  uint32_t generation = commandBuffer_[0] |
+                        (static_cast<uint32_t>(commandBuffer_[1]) << 8) |
+                        (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
+                        (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+
+  return cpu_id_set_generation(generation);
+}
+
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_randomize_mem() {
 
@@ -1594,9 +2144,448 @@ bool CommandServer<BoardType, ShieldType>::cmd_set_memory() {
   return true;
 }
 
+// Incremental CRC32 (IEEE 802.3, reflected). Start with 0xFFFFFFFF, feed data
+// in any number of chunks, and invert the result when done. Bitwise rather
+// than table-driven; the serial link is the bottleneck, not the CRC.
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++) {
+      crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320ul : 0);
+    }
+  }
+  return crc;
+}
+
+/// @brief Upload a length-prefixed payload directly into backend memory.
+/// Unlike cmd_set_memory(), which stages data through the command buffer, the
+/// payload streams straight into the backend's buffer when it is linear
+/// (get_ptr), and is followed by a little-endian CRC32 trailer that must match
+/// before we report success.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_upload_memory() {
+  uint8_t stage_buffer[MAX_BUFFER_LEN];
+  uint32_t address = commandBuffer_[0] |
+                    (static_cast<uint32_t>(commandBuffer_[1]) << 8) |
+                    (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
+                    (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+  uint32_t size = commandBuffer_[4] |
+                  (static_cast<uint32_t>(commandBuffer_[5]) << 8) |
+                  (static_cast<uint32_t>(commandBuffer_[6]) << 16) |
+                  (static_cast<uint32_t>(commandBuffer_[7]) << 24);
+
+  size_t mem_size = ArduinoX86::Bus->mem_size();
+  if (address >= mem_size || (address + size) > mem_size) {
+    controller_.getBoard().debugPrintf(
+      DebugType::ERROR,
+      false,
+      "cmd_upload_memory(): Invalid address range: %08lX - %08lX. Mem size: %08lX\n\r",
+      address, address + size,
+      mem_size
+    );
+    set_error("Invalid address range: %08lX - %08lX", address, address + size);
+    return false;
+  }
+
+  // When the backend exposes a linear buffer we stream straight into it.
+  // The hash backend has no linear buffer, so it stages through a bounce
+  // buffer and set_memory instead.
+  uint8_t *ptr = ArduinoX86::Bus->get_ptr(address);
+
+  controller_.getBoard().debugPrintf(
+    DebugType::CMD, false,
+    "cmd_upload_memory(): Uploading %lu bytes to address: %08lX (%s)\n\r",
+    size, address, ptr ? "zero-copy" : "staged"
+  );
+
+  // Large uploads arrive in many USB packets; the timeout applies to gaps in
+  // the stream rather than the whole transfer.
+  constexpr unsigned long READ_TIMEOUT = 1000;
+  uint32_t crc = 0xFFFFFFFFul;
+  size_t total_bytes_read = 0;
+  unsigned long timeout_time = millis() + READ_TIMEOUT;
+
+  while (total_bytes_read < size) {
+    size_t bytes_available = proto_available();
+    if (bytes_available) {
+      size_t bytes_to_read = min(bytes_available, (size_t)(size - total_bytes_read));
+      size_t bytes_read = 0;
+      if (ptr != nullptr) {
+        bytes_read = proto_read(ptr + total_bytes_read, bytes_to_read);
+        if (bytes_read) {
+          crc = crc32_update(crc, ptr + total_bytes_read, bytes_read);
+        }
+      }
+      else {
+        bytes_to_read = min(bytes_to_read, MAX_BUFFER_LEN);
+        bytes_read = proto_read(stage_buffer, bytes_to_read);
+        if (bytes_read) {
+          crc = crc32_update(crc, stage_buffer, bytes_read);
+          ArduinoX86::Bus->set_memory(address + total_bytes_read, stage_buffer, bytes_read);
+        }
+      }
+      if (bytes_read == 0) {
+        controller_.getBoard().debugPrintf(DebugType::ERROR, false, "cmd_upload_memory(): Failed to read available bytes\n\r");
+        set_error("cmd_upload_memory(): Failed to read available bytes");
+        return false;
+      }
+      total_bytes_read += bytes_read;
+      timeout_time = millis() + READ_TIMEOUT;
+    }
+    else {
+      if (millis() >= timeout_time) {
+        controller_.getBoard().debugPrintf(DebugType::ERROR, false, "cmd_upload_memory(): Timeout waiting for upload data\n\r");
+        set_error("cmd_upload_memory(): Timeout waiting for upload data");
+        return false;
+      }
+      delay(1);
+    }
+  }
+  crc = ~crc;
+
+  // Read the four-byte CRC32 trailer.
+  uint8_t trailer[4];
+  size_t trailer_read = 0;
+  timeout_time = millis() + READ_TIMEOUT;
+  while (trailer_read < sizeof(trailer)) {
+    if (proto_available()) {
+      trailer[trailer_read++] = (uint8_t)proto_read();
+    }
+    else if (millis() >= timeout_time) {
+      controller_.getBoard().debugPrintf(DebugType::ERROR, false, "cmd_upload_memory(): Timeout waiting for CRC32 trailer\n\r");
+      set_error("cmd_upload_memory(): Timeout waiting for CRC32 trailer");
+      return false;
+    }
+  }
+
+  uint32_t expected = trailer[0] |
+                      (static_cast<uint32_t>(trailer[1]) << 8) |
+                      (static_cast<uint32_t>(trailer[2]) << 16) |
+                      (static_cast<uint32_t>(trailer[3]) << 24);
+
+  if (crc != expected) {
+    controller_.getBoard().debugPrintf(
+      DebugType::ERROR, false,
+      "cmd_upload_memory(): CRC32 mismatch: computed %08lX, expected %08lX\n\r",
+      crc, expected
+    );
+    set_error("CRC32 mismatch: computed %08lX, expected %08lX", crc, expected);
+    return false;
+  }
+
+  controller_.getBoard().debugPrintf(DebugType::CMD, false, "cmd_upload_memory(): Uploaded %lu bytes, CRC32 %08lX OK\n\r", total_bytes_read, crc);
+  return true;
+}
+
+// Server command - RunBatch
+//
+// Run a batch of single-step tests back-to-back on-device, amortizing the
+// host round trips that otherwise dominate test generation throughput.
+// Takes a test count (2 bytes) and a register type (1 byte, as for CmdLoad,
+// types 0-2 and 4). For each test the client then streams one record:
+//
+//   [register struct][setup_addr (4 bytes)][prog_len (2 bytes)][prog bytes]
+//
+// The program bytes are written to the bus emulator at setup_addr, the
+// registers are loaded, and the test executes automatically to completion.
+// Each test answers with:
+//
+//   [status (1 byte)][format (1 byte)][registers][cycles (4 bytes)]
+//   [trace count (4 bytes)][trace size (4 bytes)][trace entries]
+//
+// in the same register and cycle-state formats as CmdStore and
+// CmdGetCycleStates. The trace is empty unless FLAG_LOG_CYCLES is set.
+// A status of 0 aborts the batch: no further test results follow, and the
+// final response byte is the failure byte.
+//
+// Requires FLAG_EXECUTE_AUTOMATIC and a CPU supported by the automatic
+// store path (286/386, or a NEC V20/V30 with FLAG_EMU_8080 armed - the
+// 8080-emulation enter/exit preambles are fixed-length server-fed programs,
+// so they run inside the batch without host interaction).
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_run_batch() {
+
+  clear_error();
+
+  uint16_t test_count = (uint16_t)commandBuffer_[0] | ((uint16_t)commandBuffer_[1] << 8);
+  uint8_t reg_type = commandBuffer_[2];
+
+  if (!(flags_ & FLAG_EXECUTE_AUTOMATIC)) {
+    set_error("cmd_run_batch(): requires FLAG_EXECUTE_AUTOMATIC");
+    return false;
+  }
+
+  size_t reg_size = 0;
+  switch (reg_type) {
+    case 0: reg_size = sizeof(registers1_t); break;
+    case 1: reg_size = sizeof(Loadall286); break;
+    case 2: reg_size = sizeof(Loadall386); break;
+    // Seeded register randomization, as for CmdLoad type 4: seed (4 bytes),
+    // constraint mask (1 byte), CS:IP (4 bytes) per test instead of a full
+    // register struct.
+    case 4: reg_size = 9; break;
+    default:
+      set_error("cmd_run_batch(): invalid register type: %d", reg_type);
+      return false;
+  }
+
+  // NEC V20/V30 8080-emulation suites may also batch: the BRKEM enter
+  // preamble executes inside reset_and_load() and the RETEM exit preamble
+  // inside the server-fed finalize chain (EmuExit), so mode switching needs
+  // no host round trips - only a wider cycle budget for the fixed preambles.
+  bool emu_batch = CPU.do_emulation &&
+                   ((CPU.cpu_type == CpuType::necV20) || (CPU.cpu_type == CpuType::necV30));
+
+  if ((CPU.cpu_type != CpuType::i80286) && (CPU.cpu_type != CpuType::i80386) && !emu_batch) {
+    set_error("cmd_run_batch(): unsupported CPU model for automatic mode");
+    return false;
+  }
+
+  if (emu_batch && (reg_type != 0) && (reg_type != 4)) {
+    set_error("cmd_run_batch(): emulation mode requires register type 0");
+    return false;
+  }
+
+  controller_.getBoard().debugPrintf(
+    DebugType::CMD,
+    false,
+    "cmd_run_batch(): Running %u tests with register type %d\n\r",
+    test_count,
+    reg_type
+  );
+
+  // Lead the result stream with a trace header so archived batch captures
+  // are self-describing (see TraceFormat.h). Result records are variable
+  // length (register file sized by reg_type, plus an embedded cycle dump),
+  // so the record size is 0.
+  {
+    TraceHeader header = make_trace_header(TraceKind::BatchResults, 0, 0);
+    proto_write(reinterpret_cast<uint8_t *>(&header), sizeof(header));
+  }
+
+  for (uint16_t test_n = 0; test_n < test_count; test_n++) {
+
+    // Read the register record for this test.
+    if (proto_read(commandBuffer_, reg_size) != reg_size) {
+      set_error("cmd_run_batch(): Timed out reading registers for test %u", test_n);
+      proto_write((uint8_t)0);
+      return false;
+    }
+
+    if (reg_type == 4) {
+      // Expand the seed record into a registers1_t image in place, so the
+      // standard install path consumes it as a type 0 load.
+      uint32_t seed = commandBuffer_[0] |
+                      (static_cast<uint32_t>(commandBuffer_[1]) << 8) |
+                      (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
+                      (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+      uint16_t fixed_cs = commandBuffer_[5] | (static_cast<uint16_t>(commandBuffer_[6]) << 8);
+      uint16_t fixed_ip = commandBuffer_[7] | (static_cast<uint16_t>(commandBuffer_[8]) << 8);
+      synth_load_regs(seed, commandBuffer_[4], fixed_cs, fixed_ip, commandBuffer_);
+    }
+
+    // Read the program setup header: flat address (4 bytes), length (2 bytes).
+    uint8_t setup_hdr[6];
+    if (proto_read(setup_hdr, sizeof(setup_hdr)) != sizeof(setup_hdr)) {
+      set_error("cmd_run_batch(): Timed out reading program header for test %u", test_n);
+      proto_write((uint8_t)0);
+      return false;
+    }
+    uint32_t setup_addr = (uint32_t)setup_hdr[0] |
+                          ((uint32_t)setup_hdr[1] << 8) |
+                          ((uint32_t)setup_hdr[2] << 16) |
+                          ((uint32_t)setup_hdr[3] << 24);
+    uint32_t prog_len = (uint32_t)setup_hdr[4] | ((uint32_t)setup_hdr[5] << 8);
+
+    if ((uint64_t)setup_addr + prog_len > ArduinoX86::Bus->mem_size()) {
+      set_error("cmd_run_batch(): Program out of range for test %u", test_n);
+      proto_write((uint8_t)0);
+      return false;
+    }
+
+    // Write the program bytes into the bus emulator at the setup address.
+    uint32_t prog_read = 0;
+    uint8_t stage_buffer[MAX_BUFFER_LEN];
+    while (prog_read < prog_len) {
+      uint32_t chunk = prog_len - prog_read;
+      if (chunk > MAX_BUFFER_LEN) {
+        chunk = MAX_BUFFER_LEN;
+      }
+      if (proto_read(stage_buffer, chunk) != chunk) {
+        set_error("cmd_run_batch(): Timed out reading program bytes for test %u", test_n);
+        proto_write((uint8_t)0);
+        return false;
+      }
+      ArduinoX86::Bus->set_memory(setup_addr + prog_read, stage_buffer, chunk);
+      prog_read += chunk;
+    }
+
+    // Each test gets its own cycle trace window.
+    ArduinoX86::CycleLogger->reset();
+
+    // Load the registers and run the load program.
+    if (!install_registers((reg_type == 4) ? 0 : reg_type) || !reset_and_load(true)) {
+      proto_write((uint8_t)0);
+      return false;
+    }
+
+    // Execute to completion. The per-state handlers inside cycle() service
+    // the bus from the emulator and walk the state machine through the
+    // automatic store once the program terminates.
+    CPU.execute_cycle_ct = 0;
+    uint32_t exec_cycles = 0;
+    // Emulation tests spend extra cycles in the fixed RETEM exit preamble,
+    // mirroring the allowance cmd_finalize() makes interactively.
+    uint32_t exec_budget = EXECUTE_TIMEOUT + (emu_batch ? FINALIZE_EMU_TIMEOUT : 0);
+    while ((state_ != ServerState::StoreDone) &&
+           (state_ != ServerState::StoreDoneSmm) &&
+           (state_ != ServerState::Error)) {
+      CPU.execute_cycle_ct++;
+      exec_cycles++;
+      cycle();
+
+      if (exec_cycles > exec_budget) {
+        set_error("cmd_run_batch(): Execute timeout in test %u", test_n);
+        proto_write((uint8_t)0);
+        return false;
+      }
+    }
+
+    if (state_ == ServerState::Error) {
+      set_error("cmd_run_batch(): Error state in test %u", test_n);
+      proto_write((uint8_t)0);
+      return false;
+    }
+
+    // Stream this test's results: status, registers, cycle count, trace.
+    proto_write((uint8_t)1);
+    if (!write_stored_registers()) {
+      return false;
+    }
+    uint8_t cycle_bytes[4] = {
+      (uint8_t)(exec_cycles & 0xFF),
+      (uint8_t)((exec_cycles >> 8) & 0xFF),
+      (uint8_t)((exec_cycles >> 16) & 0xFF),
+      (uint8_t)((exec_cycles >> 24) & 0xFF),
+    };
+    proto_write(cycle_bytes, sizeof(cycle_bytes));
+    // The dump writes to INBAND_SERIAL directly; drain the accumulator so
+    // the result bytes above precede it on the wire.
+    proto_flush();
+    // Writes a zero count/size header when cycle logging is disabled.
+    ArduinoX86::CycleLogger->dump_states();
+  }
+
+  controller_.getBoard().debugPrintf(DebugType::CMD, false, "cmd_run_batch(): Batch of %u tests complete\n\r", test_count);
+  return true;
+}
+
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_get_cycle_states() {
+  // Start a background dump; the buffer drains from the main loop so the
+  // server doesn't stall for the full transfer.
+  ArduinoX86::CycleLogger->start_dump_async();
+  return true;
+}
+
+// Server command - GetTestResult
+// Return the complete end-of-test result in one response, replacing the
+// CmdStore + CmdGetCycleStates + CmdReadMemory exchange that otherwise ends
+// every test. Takes one flags byte (bit 0: include dirtied memory words).
+// The bundle is, in order:
+//
+//   [register format (1 byte)][registers]  - as CmdStore
+//   [cycle trace]                          - as CmdGetCycleStates, dumped
+//                                            synchronously so the response
+//                                            stays contiguous
+//   [bus ops]                              - as CmdGetBusOps
+//   [dirty count (4 bytes)]
+//   [count x (address (4 bytes), word (2 bytes))]
+//
+// The dirtied words are the ones resident in the hash backend's table:
+// everything written since the last erase, including staged program bytes,
+// in slot order. The SDRAM backend has no write tracking and always reports
+// zero words.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_get_test_result(void) {
+  debug_cmd("In cmd_get_test_result()");
+  clear_error();
+
+  uint8_t result_flags = commandBuffer_[0];
+
+  // Registers first, exactly as CmdStore would return them (including
+  // walking the store program in non-automatic mode). A store failure aborts
+  // the bundle before any payload bytes are written.
+  if (!cmd_store()) {
+    return false;
+  }
+
+  // Cycle trace since the last clear.
   ArduinoX86::CycleLogger->dump_states();
+
+  // Bus operation log.
+  ArduinoX86::Bus->log_dump_ops();
+
+  uint32_t dirty_count = 0;
+  if (result_flags & 0x01) {
+    dirty_count = (uint32_t)ArduinoX86::Bus->dirty_word_count();
+  }
+  proto_write((uint8_t)(dirty_count & 0xFF));
+  proto_write((uint8_t)((dirty_count >> 8) & 0xFF));
+  proto_write((uint8_t)((dirty_count >> 16) & 0xFF));
+  proto_write((uint8_t)((dirty_count >> 24) & 0xFF));
+
+  if (dirty_count > 0) {
+    ArduinoX86::Bus->for_each_dirty_word([this](uint32_t address, uint16_t word) {
+      uint8_t rec[6];
+      rec[0] = (uint8_t)(address & 0xFF);
+      rec[1] = (uint8_t)((address >> 8) & 0xFF);
+      rec[2] = (uint8_t)((address >> 16) & 0xFF);
+      rec[3] = (uint8_t)((address >> 24) & 0xFF);
+      rec[4] = (uint8_t)(word & 0xFF);
+      rec[5] = (uint8_t)(word >> 8);
+      proto_write(rec, sizeof(rec));
+    });
+  }
+
+  return true;
+}
+
+// Server command - GetTraceMeta
+// Dump the per-cycle trace metadata recorded in binary trace mode
+// (FLAG_TRACE_BINARY). Entries pair one-to-one with the cycle states from
+// CmdGetCycleStates; a zero count means binary tracing never ran.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_get_trace_meta() {
+  ArduinoX86::CycleLogger->dump_trace_meta();
+  return true;
+}
+
+// Server command - GetCycleStatesC
+// Dump the cycle log delta-compressed (see dump_states_compressed() for the
+// wire format). The compressed trace is small enough that a synchronous dump
+// does not need the async drain machinery; the response byte follows the
+// dump data, the same ordering clients see from the async path.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_get_cycle_states_c() {
+  ArduinoX86::CycleLogger->dump_states_compressed();
+  return true;
+}
+
+// Server command - GetCycleStatesFrom
+// Dump only the cycle log entries logged after the supplied read cursor (see
+// dump_states_from() for the wire format). Polling clients pass the cursor
+// returned by the previous fetch and transfer only new entries instead of
+// re-downloading the whole buffer each time.
+// Parameters:
+// 4 bytes: Read cursor from the previous fetch, or 0 for the first (uint32_t)
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_get_cycle_states_from() {
+  uint32_t cursor = static_cast<uint32_t>(commandBuffer_[0])
+    | (static_cast<uint32_t>(commandBuffer_[1]) << 8)
+    | (static_cast<uint32_t>(commandBuffer_[2]) << 16)
+    | (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+  ArduinoX86::CycleLogger->dump_states_from(cursor);
   return true;
 }
 
@@ -1618,25 +2607,44 @@ bool CommandServer<BoardType, ShieldType>::cmd_enable_debug() {
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_set_memory_strategy() {
 
-  IBusBackend::DefaultStrategy strategy = static_cast<IBusBackend::DefaultStrategy>(commandBuffer_[0]);
-  uint32_t start_address = commandBuffer_[1] | 
+  // Bit 7 of the strategy byte appends a region to the backend's strategy
+  // map instead of replacing it, so a host can compose several lazy regions
+  // (zeroed RAM, 0xFF ROM holes, random fill) with repeated commands: the
+  // first sent without the bit, the rest with it.
+  bool append = (commandBuffer_[0] & 0x80) != 0;
+  IBusBackend::DefaultStrategy strategy = static_cast<IBusBackend::DefaultStrategy>(commandBuffer_[0] & 0x7F);
+  uint32_t start_address = commandBuffer_[1] |
                     (static_cast<uint32_t>(commandBuffer_[2]) << 8) |
                     (static_cast<uint32_t>(commandBuffer_[3]) << 16) |
                     (static_cast<uint32_t>(commandBuffer_[4]) << 24);
-  uint32_t end_address = commandBuffer_[5] | 
+  uint32_t end_address = commandBuffer_[5] |
                     (static_cast<uint32_t>(commandBuffer_[6]) << 8) |
                     (static_cast<uint32_t>(commandBuffer_[7]) << 16) |
                     (static_cast<uint32_t>(commandBuffer_[8]) << 24);
-  if (strategy < IBusBackend::DefaultStrategy::Invalid) {
-    ArduinoX86::Bus->set_memory_strategy(strategy, start_address, end_address);
-    controller_.getBoard().debugPrintf(DebugType::CMD, false, "## cmd_set_memory_strategy(): Set memory strategy to: %d: %06lX %06lX\n\r", strategy, start_address, end_address);
-    set_error("No error");
-    return true;
-  } else {
+  if (strategy >= IBusBackend::DefaultStrategy::Invalid) {
     controller_.getBoard().debugPrintf(DebugType::ERROR, false, "## cmd_set_memory_strategy(): Invalid memory strategy: %d\n\r", strategy);
     set_error("Invalid memory strategy: %d", strategy);
     return false;
   }
+  if (append) {
+    if (!ArduinoX86::Bus->add_memory_strategy(strategy, start_address, end_address)) {
+      controller_.getBoard().debugPrintf(DebugType::ERROR, false, "## cmd_set_memory_strategy(): Could not append strategy region: %06lX %06lX\n\r", start_address, end_address);
+      set_error("Strategy region rejected (table full or unsupported backend)");
+      return false;
+    }
+    controller_.getBoard().debugPrintf(DebugType::CMD, false, "## cmd_set_memory_strategy(): Appended memory strategy %d: %06lX %06lX\n\r", strategy, start_address, end_address);
+    if (profileRegionCount_ < CONFIG_PROFILE_MAX_REGIONS) {
+      profileRegions_[profileRegionCount_++] = { start_address, end_address, static_cast<uint8_t>(strategy), {} };
+    }
+  }
+  else {
+    ArduinoX86::Bus->set_memory_strategy(strategy, start_address, end_address);
+    controller_.getBoard().debugPrintf(DebugType::CMD, false, "## cmd_set_memory_strategy(): Set memory strategy to: %d: %06lX %06lX\n\r", strategy, start_address, end_address);
+    profileRegions_[0] = { start_address, end_address, static_cast<uint8_t>(strategy), {} };
+    profileRegionCount_ = 1;
+  }
+  set_error("No error");
+  return true;
 }
 
 template<typename BoardType, typename ShieldType>
@@ -1687,23 +2695,729 @@ bool CommandServer<BoardType, ShieldType>::cmd_read_memory() {
   return true;
 }
 
+// Server command - CrcMemory
+// Compute a CRC32 (IEEE 802.3, reflected) over a backend address range. Lets
+// the host verify an upload, or diff memory after a test, with a 4-byte
+// response instead of pulling the whole range back over serial.
+// Parameters:
+// 4 bytes: Start address (little-endian)
+// 4 bytes: Size in bytes (little-endian)
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_crc_memory() {
+  debug_cmd("In cmd_crc_memory()");
+  clear_error();
+  uint32_t address = commandBuffer_[0] |
+                    (static_cast<uint32_t>(commandBuffer_[1]) << 8) |
+                    (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
+                    (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+  uint32_t size = commandBuffer_[4] |
+                  (static_cast<uint32_t>(commandBuffer_[5]) << 8) |
+                  (static_cast<uint32_t>(commandBuffer_[6]) << 16) |
+                  (static_cast<uint32_t>(commandBuffer_[7]) << 24);
+
+  size_t mem_size = ArduinoX86::Bus->mem_size();
+  if (address >= mem_size || (address + size) > mem_size) {
+    controller_.getBoard().debugPrintf(
+      DebugType::ERROR,
+      false,
+      "## cmd_crc_memory(): Invalid address range: %08lX - %08lX. Mem size: %08lX\n\r",
+      address, address + size,
+      mem_size
+    );
+    set_error("Invalid address range: %08lX - %08lX", address, address + size);
+    return false;
+  }
+
+  uint32_t crc = 0xFFFFFFFFul;
+  uint8_t *ptr = ArduinoX86::Bus->get_ptr(address);
+  if (ptr != nullptr) {
+    // Linear backend: feed the buffer directly.
+    crc = crc32_update(crc, ptr, size);
+  }
+  else {
+    // No linear buffer (hash backend): walk the range through the bus
+    // interface, staging small chunks for the CRC.
+    uint8_t chunk[64];
+    uint32_t cursor = address;
+    uint32_t remaining = size;
+    while (remaining > 0) {
+      size_t n = min((size_t)sizeof(chunk), (size_t)remaining);
+      for (size_t i = 0; i < n; i++) {
+        chunk[i] = ArduinoX86::Bus->mem_read_u8(cursor + i, false);
+      }
+      crc = crc32_update(crc, chunk, n);
+      cursor += n;
+      remaining -= n;
+    }
+  }
+  crc = ~crc;
+
+  proto_write((uint8_t)(crc & 0xFF));
+  proto_write((uint8_t)((crc >> 8) & 0xFF));
+  proto_write((uint8_t)((crc >> 16) & 0xFF));
+  proto_write((uint8_t)((crc >> 24) & 0xFF));
+  return true;
+}
+
+// Server command - SetWaitStates
+// Program the per-region wait-state map: the cycle engine holds READY low
+// for the registered count on bus cycles whose latched address falls in a
+// programmed range, so one hardware pass can reproduce the timing of
+// machines with distinct RAM/ROM/I/O wait profiles. A count of zero clears
+// a range. Granularity is the 1KB page of the bus emulator's attribute
+// tables.
+// Parameters:
+// 1 byte: Address space (0 = memory, 1 = I/O; I/O ignores the range)
+// 4 bytes: Range start (little-endian)
+// 4 bytes: Range end, exclusive (little-endian)
+// 1 byte: Wait states for matching transfers
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_wait_states() {
+  debug_cmd("In cmd_set_wait_states()");
+  clear_error();
+  uint8_t space = commandBuffer_[0];
+  uint32_t start = commandBuffer_[1] |
+                  (static_cast<uint32_t>(commandBuffer_[2]) << 8) |
+                  (static_cast<uint32_t>(commandBuffer_[3]) << 16) |
+                  (static_cast<uint32_t>(commandBuffer_[4]) << 24);
+  uint32_t end = commandBuffer_[5] |
+                (static_cast<uint32_t>(commandBuffer_[6]) << 8) |
+                (static_cast<uint32_t>(commandBuffer_[7]) << 16) |
+                (static_cast<uint32_t>(commandBuffer_[8]) << 24);
+  uint8_t count = commandBuffer_[9];
+
+  switch (space) {
+    case 0:
+      if (end <= start) {
+        set_error("Bad wait-state range: %08lX - %08lX", start, end);
+        return false;
+      }
+      ArduinoX86::Bus->set_wait_states(start, end, count);
+      controller_.getBoard().debugPrintf(
+        DebugType::CMD,
+        false,
+        "## cmd_set_wait_states(): %u wait states for %08lX - %08lX\n\r",
+        count, start, end
+      );
+      return true;
+    case 1:
+      ArduinoX86::Bus->set_io_wait_states(count);
+      controller_.getBoard().debugPrintf(DebugType::CMD, false, "## cmd_set_wait_states(): %u wait states for I/O\n\r", count);
+      return true;
+    default:
+      set_error("Bad wait-state address space: %d", space);
+      return false;
+  }
+}
+
+// Server command - SetReadyTimer
+// Program the hardware READY deassert window used for wait-state injection
+// in free-run turbo mode (see ReadyTimer.h). While a window is set, the ALE
+// interrupt starts a one-shot timer at the READY deassert and the release is
+// timed in hardware, so the cycle sees an exact number of wait states
+// regardless of firmware service latency.
+// Parameters:
+// 4 bytes: Deassert window in timer ticks (uint32_t); 0 disables
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_ready_timer() {
+  debug_cmd("In cmd_set_ready_timer()");
+  clear_error();
+  uint32_t ticks = commandBuffer_[0] |
+                  (static_cast<uint32_t>(commandBuffer_[1]) << 8) |
+                  (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
+                  (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+  if (!ready_timer_program(ticks)) {
+    set_error("Ready timer not supported on this board");
+    return false;
+  }
+  controller_.getBoard().debugPrintf(
+    DebugType::CMD,
+    false,
+    "## cmd_set_ready_timer(): window %lu ticks @ %lu Hz\n\r",
+    ready_timer_ticks(), ready_timer_hz()
+  );
+  return true;
+}
+
+// Server command - SetIntVector
+// Arm or disarm the emulated interrupt controller. While armed, the cycle
+// engine answers both INTA bus cycles with the registered vector during
+// automatic execution and drops INTR on the second acknowledge, like an
+// 8259 in automatic-EOI mode, so interrupt tests run at full automatic
+// speed instead of single-stepping the acknowledge through the host. The
+// IVT fetch that follows is served from emulated memory like any other
+// read. Disarmed, INTA cycles are left for the host to serve as before.
+// Parameters:
+// 1 byte: Mode (0 = disarm, 1 = arm)
+// 1 byte: Vector to place on the bus during INTA (ignored when disarming)
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_int_vector() {
+  debug_cmd("In cmd_set_int_vector()");
+  clear_error();
+  uint8_t mode = commandBuffer_[0];
+  uint8_t vector = commandBuffer_[1];
+
+  switch (mode) {
+    case 0:
+      ArduinoX86::Bus->clear_intr_vector();
+      controller_.getBoard().debugPrintln(DebugType::CMD, "## cmd_set_int_vector(): Interrupt controller disarmed");
+      return true;
+    case 1:
+      ArduinoX86::Bus->set_intr_vector(vector);
+      controller_.getBoard().debugPrintf(DebugType::CMD, false, "## cmd_set_int_vector(): Armed with vector %02X\n\r", vector);
+      return true;
+    default:
+      set_error("Bad interrupt vector mode: %d", mode);
+      return false;
+  }
+}
+
+// Server command - SetPortHandler
+// Bind a handler slot to a port range so IN/OUT instructions are served
+// on-device instead of reading stubbed 0xFF or dropping to host mediation.
+// Kinds: 0 unbinds the slot, 1 reads a constant, 2 is a latch that echoes
+// the last write, 3 is a counter that increments per read, 4 serves a
+// scripted byte sequence (wrapping; a write rewinds it). Handler-served
+// transfers still appear in the bus operation log and trip I/O
+// watchpoints.
+// Parameters:
+// 1 byte: Handler slot index
+// 1 byte: Kind (see above)
+// 2 bytes: First port covered (little-endian)
+// 2 bytes: Last port covered, inclusive (little-endian)
+// 1 byte: Value (constant, latch initial value, or counter start)
+// 1 byte: Script length (script kind only)
+// 16 bytes: Script bytes
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_port_handler() {
+  debug_cmd("In cmd_set_port_handler()");
+  clear_error();
+  uint8_t index = commandBuffer_[0];
+  uint8_t kind = commandBuffer_[1];
+  uint16_t start = commandBuffer_[2] | (static_cast<uint16_t>(commandBuffer_[3]) << 8);
+  uint16_t end = commandBuffer_[4] | (static_cast<uint16_t>(commandBuffer_[5]) << 8);
+  uint8_t value = commandBuffer_[6];
+  uint8_t script_len = commandBuffer_[7];
+
+  if (kind > static_cast<uint8_t>(PortHandlerKind::Script)) {
+    set_error("Bad port handler kind: %d", kind);
+    return false;
+  }
+  if (end < start) {
+    set_error("Bad port range: %04X - %04X", start, end);
+    return false;
+  }
+  if (script_len > PORT_HANDLER_SCRIPT_BYTES) {
+    set_error("Bad script length: %d", script_len);
+    return false;
+  }
+  if (!ArduinoX86::Bus->set_port_handler(index, static_cast<PortHandlerKind>(kind), start, end, value, &commandBuffer_[8], script_len)) {
+    set_error("Bad port handler index: %d", index);
+    return false;
+  }
+
+  controller_.getBoard().debugPrintf(
+    DebugType::CMD,
+    false,
+    "## cmd_set_port_handler(): Slot %u kind %u for ports %04X - %04X\n\r",
+    index, kind, start, end
+  );
+  return true;
+}
+
+// Keyed byte stream for the on-device program generator. The same
+// murmur3 finalizer HashBackend uses for randomized memory, driven by an
+// incrementing counter so one 32-bit seed reproduces the whole stream.
+struct GenRand {
+  uint32_t seed;
+  uint32_t counter = 0;
+
+  uint8_t next_u8() {
+    uint32_t h = counter++ ^ seed;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return static_cast<uint8_t>(h >> 16);
+  }
+};
+
+/// @brief Synthesize a randomized registers1_t image into `out` from the
+/// keyed byte stream, then apply the REG_RAND_* constraints. The stream is
+/// consumed in struct order, so host-side reproduction is a fixed 28-byte
+/// read of the same generator.
+static void synth_load_regs(uint32_t seed, uint8_t constraint, uint16_t fixed_cs,
+                            uint16_t fixed_ip, uint8_t *out) {
+  GenRand rand{seed};
+  registers1_t regs;
+  uint8_t *raw = reinterpret_cast<uint8_t *>(&regs);
+  for (size_t i = 0; i < sizeof(registers1_t); i++) {
+    raw[i] = rand.next_u8();
+  }
+
+  if (constraint & REG_RAND_ALIGN_SP) {
+    regs.sp &= ~1;
+  }
+  if (constraint & REG_RAND_CLEAR_TF) {
+    regs.flags &= ~CPU_FLAG_TRAP;
+  }
+  if (constraint & REG_RAND_CLEAR_IF) {
+    regs.flags &= ~CPU_FLAG_INT_ENABLE;
+  }
+  if (constraint & REG_RAND_CLEAR_DF) {
+    regs.flags &= ~CPU_FLAG_DIRECTION;
+  }
+  if (constraint & REG_RAND_FIXED_CSIP) {
+    regs.cs = fixed_cs;
+    regs.ip = fixed_ip;
+  }
+
+  memcpy(out, &regs, sizeof(registers1_t));
+}
+
+// Maximum bytes one generated instruction can occupy:
+// prefix + opcode + modrm + disp16 + imm16.
+static const size_t GEN_MAX_INSTR_BYTES = 7;
+
+/// @brief Synthesize one instruction into `out` from the random stream,
+/// restricted to the requested GEN_CLASS_* mask. Opcode candidates come
+/// straight from the stream and are filtered against OPCODE_GEN, so the
+/// byte distribution within the allowed classes matches what the host
+/// generator produced. Group opcodes get their reg field forced to
+/// well-defined selections and rel8 displacements are forced forward so
+/// the sequence cannot loop back on itself. Returns the instruction
+/// length; falls back to NOP if the mask is too sparse to satisfy.
+static size_t gen_instruction(GenRand& rand, uint8_t class_mask, uint8_t* out) {
+  size_t len = 0;
+  uint16_t meta = 0;
+  uint8_t opcode = OPCODE_NOP;
+  bool have_prefix = false;
+
+  for (int attempt = 0; attempt < 64; attempt++) {
+    uint8_t candidate = rand.next_u8();
+    uint16_t m = OPCODE_GEN.v[candidate];
+    if (m & GEN_UNSAFE) {
+      continue;
+    }
+    if ((m & class_mask & 0x00FF) == 0) {
+      continue;
+    }
+    if (m & GEN_CLASS_PREFIX) {
+      // At most one prefix, and always followed by a real instruction.
+      if (!have_prefix) {
+        out[len++] = candidate;
+        have_prefix = true;
+      }
+      continue;
+    }
+    opcode = candidate;
+    meta = m;
+    break;
+  }
+  if (meta == 0) {
+    // Retries exhausted (or only the prefix class was requested).
+    opcode = OPCODE_NOP;
+    meta = OPCODE_GEN.v[OPCODE_NOP];
+  }
+
+  out[len++] = opcode;
+
+  if (meta & GEN_MODRM) {
+    uint8_t modrm = rand.next_u8();
+    // Force group reg fields to selections that stay well-defined and
+    // terminatable: GRP3 NOT/NEG (no immediate, no divide), GRP4 INC/DEC,
+    // GRP5 INC/DEC/PUSH (no indirect flow).
+    if ((opcode == 0xF6) || (opcode == 0xF7)) {
+      modrm = (modrm & 0xC7) | (((rand.next_u8() & 1) ? 0x02 : 0x03) << 3);
+    }
+    else if (opcode == 0xFE) {
+      modrm = (modrm & 0xC7) | ((rand.next_u8() & 1) << 3);
+    }
+    else if (opcode == 0xFF) {
+      static const uint8_t grp5_reg[3] = { 0x00, 0x01, 0x06 };
+      modrm = (modrm & 0xC7) | (grp5_reg[rand.next_u8() % 3] << 3);
+    }
+    out[len++] = modrm;
+
+    uint8_t mod = modrm >> 6;
+    uint8_t rm = modrm & 0x07;
+    if (mod == 0b01) {
+      out[len++] = rand.next_u8();
+    }
+    else if ((mod == 0b10) || ((mod == 0b00) && (rm == 0b110))) {
+      out[len++] = rand.next_u8();
+      out[len++] = rand.next_u8();
+    }
+  }
+
+  if (meta & GEN_REL8) {
+    // Forward displacements only: a taken branch always makes progress
+    // toward the end of the program.
+    out[len++] = rand.next_u8() & 0x7F;
+  }
+  if (meta & GEN_IMM8) {
+    out[len++] = rand.next_u8();
+  }
+  if (meta & GEN_IMM16) {
+    out[len++] = rand.next_u8();
+    out[len++] = rand.next_u8();
+  }
+  return len;
+}
+
+// Server command - GenProgram
+// Synthesize a randomized instruction sequence directly into the backend,
+// so test generation only ever ships a seed instead of uploading the
+// sequence it derived from that seed. Opcodes are drawn from the seeded
+// stream and filtered through the OPCODE_GEN metadata table (src/opcodes.h)
+// against the requested class mask; unsafe opcodes are never emitted and
+// branch displacements are forced forward, so the sequence always runs off
+// its end (or into a terminating fetch) under automatic execution. The
+// tail is padded with NOPs where a full instruction no longer fits.
+// Parameters:
+// 4 bytes: Generator seed (little-endian)
+// 4 bytes: Program address (little-endian)
+// 2 bytes: Program length in bytes (little-endian)
+// 1 byte: GEN_CLASS_* opcode class mask
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_gen_program() {
+  debug_cmd("In cmd_gen_program()");
+  clear_error();
+  uint32_t seed = commandBuffer_[0] |
+                 (static_cast<uint32_t>(commandBuffer_[1]) << 8) |
+                 (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
+                 (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+  uint32_t address = commandBuffer_[4] |
+                    (static_cast<uint32_t>(commandBuffer_[5]) << 8) |
+                    (static_cast<uint32_t>(commandBuffer_[6]) << 16) |
+                    (static_cast<uint32_t>(commandBuffer_[7]) << 24);
+  uint16_t length = commandBuffer_[8] | (static_cast<uint16_t>(commandBuffer_[9]) << 8);
+  uint8_t class_mask = commandBuffer_[10];
+
+  if (length == 0) {
+    set_error("Bad program length: 0");
+    return false;
+  }
+  if ((class_mask & ~GEN_CLASS_PREFIX) == 0) {
+    set_error("Empty opcode class mask");
+    return false;
+  }
+
+  GenRand rand{seed};
+  uint8_t instr[GEN_MAX_INSTR_BYTES];
+  uint32_t cursor = address;
+  uint32_t remaining = length;
+
+  while (remaining >= GEN_MAX_INSTR_BYTES) {
+    size_t instr_len = gen_instruction(rand, class_mask, instr);
+    ArduinoX86::Bus->set_memory(cursor, instr, instr_len);
+    cursor += instr_len;
+    remaining -= instr_len;
+  }
+  while (remaining > 0) {
+    // Pad out the tail where a worst-case instruction no longer fits.
+    instr[0] = OPCODE_NOP;
+    ArduinoX86::Bus->set_memory(cursor, instr, 1);
+    cursor++;
+    remaining--;
+  }
+
+  controller_.getBoard().debugPrintf(
+    DebugType::CMD,
+    false,
+    "## cmd_gen_program(): Generated %u bytes at %08lX from seed %08lX, class mask %02X\n\r",
+    length, address, seed, class_mask
+  );
+  return true;
+}
+
+// Server command - StreamMemory
+// Stream a backend address range to the client in one transaction. Unlike
+// CmdReadMemory this works on any backend: ranges without a linear buffer
+// (hash backend) are staged through a pair of packet-sized chunk buffers,
+// alternating banks so the next chunk is generated while the USB CDC endpoint
+// is still draining the previous one. The staging loop reads whole words,
+// which halves the per-word table lookup cost of a hash backend sweep.
+// Parameters:
+// 4 bytes: Start address (little-endian)
+// 4 bytes: Size in bytes (little-endian)
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_stream_memory() {
+  debug_cmd("In cmd_stream_memory()");
+  clear_error();
+  uint32_t address = commandBuffer_[0] |
+                    (static_cast<uint32_t>(commandBuffer_[1]) << 8) |
+                    (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
+                    (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+  uint32_t size = commandBuffer_[4] |
+                  (static_cast<uint32_t>(commandBuffer_[5]) << 8) |
+                  (static_cast<uint32_t>(commandBuffer_[6]) << 16) |
+                  (static_cast<uint32_t>(commandBuffer_[7]) << 24);
+
+  size_t mem_size = ArduinoX86::Bus->mem_size();
+  if (address >= mem_size || (address + size) > mem_size) {
+    controller_.getBoard().debugPrintf(
+      DebugType::ERROR,
+      false,
+      "## cmd_stream_memory(): Invalid address range: %08lX - %08lX. Mem size: %08lX\n\r",
+      address, address + size,
+      mem_size
+    );
+    set_error("Invalid address range: %08lX - %08lX", address, address + size);
+    return false;
+  }
+
+  controller_.getBoard().debugPrintf(DebugType::CMD, false, "## cmd_stream_memory(): Streaming %lu bytes from address: %08lX to client...\n\r", size, address);
+
+  // Send an initial success byte, so that the client knows we are sending data.
+  // Otherwise it doesn't know if the command failed and will have to time out.
+  proto_write((uint8_t *)"\x01", 1);
+
+  uint8_t *ptr = ArduinoX86::Bus->get_ptr(address);
+  if (ptr != nullptr) {
+    // Linear backend: the whole range is contiguous, so hand it straight to
+    // the serial driver and let the endpoint drain it.
+    proto_write(ptr, size);
+    return true;
+  }
+
+  // No linear buffer (hash backend): stage packet-multiple chunks. Two banks
+  // so the bank being filled is never the one the CDC driver may still be
+  // transmitting from.
+  static uint8_t stage[2][PACKET_SIZE * 4];
+  uint8_t bank = 0;
+  uint32_t cursor = address;
+  uint32_t remaining = size;
+  while (remaining > 0) {
+    uint8_t *chunk = stage[bank];
+    size_t n = min((size_t)sizeof(stage[0]), (size_t)remaining);
+    size_t i = 0;
+    // Align to a word boundary, then sweep whole words.
+    if ((cursor & 1) && (i < n)) {
+      chunk[i++] = ArduinoX86::Bus->mem_read_u8(cursor, false);
+    }
+    while ((i + 1) < n) {
+      uint16_t word = ArduinoX86::Bus->mem_read_u16(cursor + i, false);
+      chunk[i]     = (uint8_t)(word & 0xFF);
+      chunk[i + 1] = (uint8_t)(word >> 8);
+      i += 2;
+    }
+    if (i < n) {
+      chunk[i] = ArduinoX86::Bus->mem_read_u8(cursor + i, false);
+    }
+    proto_write(chunk, n);
+    cursor += n;
+    remaining -= n;
+    bank ^= 1;
+  }
+  return true;
+}
+
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_erase_memory() {
   ArduinoX86::Bus->erase_memory();
   return true;
 }
 
+// Server command - SnapshotMemory
+// Capture the current backend memory contents. Taken after program upload,
+// a snapshot lets CmdRestoreSnapshot roll memory back between tests instead
+// of erasing and re-transferring the program each time.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_snapshot_memory() {
+  debug_cmd("In cmd_snapshot_memory()");
+  clear_error();
+  if (!ArduinoX86::Bus->snapshot_memory()) {
+    set_error("Memory snapshot failed!");
+    return false;
+  }
+  return true;
+}
+
+// Server command - RestoreSnapshot
+// Roll backend memory back to the last snapshot taken by CmdSnapshotMemory.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_restore_snapshot() {
+  debug_cmd("In cmd_restore_snapshot()");
+  clear_error();
+  if (!ArduinoX86::Bus->restore_memory()) {
+    set_error("No memory snapshot to restore!");
+    return false;
+  }
+  return true;
+}
+
+// Server command - GetBusOps
+// Stream the bus-operation log to the host, straight out of the ring buffer.
+// Format: count (4 bytes), size in bytes (4 bytes), then raw BusOperation
+// records oldest-first. Each record carries the shared trace sequence number
+// so the host can correlate it with cycle states.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_get_bus_ops() {
+  debug_cmd("In cmd_get_bus_ops()");
+  ArduinoX86::Bus->log_dump_ops();
+  return true;
+}
+
+// Server command - SetBusLogCapacity
+// Resize the bus-operation ring, discarding its contents.
+// Parameters:
+// 4 bytes: Ring capacity in entries (little-endian)
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_bus_log_capacity() {
+  debug_cmd("In cmd_set_bus_log_capacity()");
+  clear_error();
+  uint32_t capacity = commandBuffer_[0] |
+                     (static_cast<uint32_t>(commandBuffer_[1]) << 8) |
+                     (static_cast<uint32_t>(commandBuffer_[2]) << 16) |
+                     (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+  if (!ArduinoX86::Bus->log_set_capacity(capacity)) {
+    set_error("Bad bus log capacity: %lu", capacity);
+    return false;
+  }
+  return true;
+}
+
+// Server command - SetWatchpoint
+// Install or disable a bus watchpoint.
+// Parameters:
+// 1 byte: Watchpoint slot index
+// 1 byte: Operation class mask (WATCH_* bits); 0 disables the slot
+// 4 bytes: First address/port covered, inclusive (uint32_t)
+// 4 bytes: Last address/port covered, inclusive (uint32_t)
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_watchpoint() {
+  debug_cmd("In cmd_set_watchpoint()");
+  clear_error();
+  uint8_t index = commandBuffer_[0];
+  uint8_t op_mask = commandBuffer_[1];
+  uint32_t start = static_cast<uint32_t>(commandBuffer_[2])
+    | (static_cast<uint32_t>(commandBuffer_[3]) << 8)
+    | (static_cast<uint32_t>(commandBuffer_[4]) << 16)
+    | (static_cast<uint32_t>(commandBuffer_[5]) << 24);
+  uint32_t end = static_cast<uint32_t>(commandBuffer_[6])
+    | (static_cast<uint32_t>(commandBuffer_[7]) << 8)
+    | (static_cast<uint32_t>(commandBuffer_[8]) << 16)
+    | (static_cast<uint32_t>(commandBuffer_[9]) << 24);
+
+  if (!ArduinoX86::Bus->set_watchpoint(index, start, end, op_mask)) {
+    set_error("Bad watchpoint index!");
+    return false;
+  }
+  return true;
+}
+
+// Server command - GetWatchHit
+// Report the latched watchpoint hit, if any, and clear the latch. Clearing
+// unfreezes the bus log and lets automatic execution resume.
+// Returns:
+// 1 byte: 1 if a watchpoint was hit, 0 otherwise
+// 1 byte: Index of the watchpoint that hit
+// 4 bytes: Address/port of the triggering access (uint32_t)
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_get_watch_hit() {
+  debug_cmd("In cmd_get_watch_hit()");
+  proto_write((uint8_t)(ArduinoX86::Bus->watch_hit() ? 1 : 0));
+  proto_write(ArduinoX86::Bus->watch_hit_index());
+  uint32_t addr = ArduinoX86::Bus->watch_hit_addr();
+  proto_write((uint8_t)(addr & 0xFF));
+  proto_write((uint8_t)((addr >> 8) & 0xFF));
+  proto_write((uint8_t)((addr >> 16) & 0xFF));
+  proto_write((uint8_t)((addr >> 24) & 0xFF));
+  ArduinoX86::Bus->clear_watch_hit();
+  return true;
+}
+
+// Free-heap estimates for the status telemetry block. On the Giga the mbed
+// allocator exposes heap statistics (nonzero only when the build enables
+// MBED_HEAP_STATS_ENABLED); elsewhere we measure the gap between the newlib
+// break and the stack, and no low-water mark is available.
+#if defined(ARDUINO_GIGA)
+static void get_heap_stats(uint32_t& free_bytes, uint32_t& min_free_bytes) {
+  mbed_stats_heap_t heap;
+  mbed_stats_heap_get(&heap);
+  free_bytes = (heap.reserved_size >= heap.current_size) ? (heap.reserved_size - heap.current_size) : 0;
+  min_free_bytes = (heap.reserved_size >= heap.max_size) ? (heap.reserved_size - heap.max_size) : 0;
+}
+#else
+extern "C" char* sbrk(int incr);
+static void get_heap_stats(uint32_t& free_bytes, uint32_t& min_free_bytes) {
+  char top;
+  free_bytes = static_cast<uint32_t>(&top - reinterpret_cast<char*>(sbrk(0)));
+  min_free_bytes = 0; // No low-water tracking without allocator support.
+}
+#endif
+
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_server_status() {
   // Returns the current server status as:
   // 1 byte: Server state (ServerState enum)
   // 8 bytes: Current cycle count (uint64_t)
   // 4 bytes: Current address latch (uint32_t)
-  INBAND_SERIAL.write((uint8_t)state_);
+  // followed by a packed memory telemetry block, so farm rigs can spot
+  // creeping exhaustion (tables filling, allocation churn) and schedule
+  // preventive resets between batches:
+  // 4 bytes: Free heap (uint32_t)
+  // 4 bytes: Minimum free heap (uint32_t; 0 where unavailable)
+  // 4 bytes: Backing buffer bytes in use (uint32_t; see MemTelemetry.h)
+  // 4 bytes: Backing buffer high-water mark (uint32_t)
+  // 4 bytes: Backing buffer allocation failures (uint32_t)
+  // 4 bytes: Hash table entries (uint32_t; 0 on linear backends)
+  // 4 bytes: Hash table capacity (uint32_t)
+  // 1 byte: Hash table max probe length
+  // 4 bytes: Cycle log occupancy in entries (uint32_t)
+  // 4 bytes: Cycle log bank capacity in entries (uint32_t)
+  // and the per-command dispatch statistics table, so farm slowdowns can be
+  // attributed to specific commands from production traffic:
+  // 1 byte: Command count (SERVER_COMMAND_COUNT)
+  // 1 byte: Record size in bytes
+  // Per command, in ServerCommand order:
+  //   4 bytes: Invocation count (uint32_t)
+  //   8 bytes: Cumulative execution time in microseconds (uint64_t)
+  //   4 bytes: Max single execution time in microseconds (uint32_t)
+  //   8 bytes: Protocol bytes read (uint64_t)
+  //   8 bytes: Protocol bytes written (uint64_t)
+  proto_write((uint8_t)state_);
   uint64_t cycle_count = CPU.cycle_ct();
-  INBAND_SERIAL.write((uint8_t *)&cycle_count, sizeof(cycle_count));
+  proto_write((uint8_t *)&cycle_count, sizeof(cycle_count));
   uint32_t address_latch = CPU.address_latch();
-  INBAND_SERIAL.write((uint8_t *)&address_latch, sizeof(address_latch));
+  proto_write((uint8_t *)&address_latch, sizeof(address_latch));
+
+  uint32_t heap_free = 0;
+  uint32_t heap_min_free = 0;
+  get_heap_stats(heap_free, heap_min_free);
+  proto_write((uint8_t *)&heap_free, sizeof(heap_free));
+  proto_write((uint8_t *)&heap_min_free, sizeof(heap_min_free));
+
+  uint32_t buf_in_use = ArduinoX86::MemTelemetry::BufBytesInUse;
+  uint32_t buf_peak = ArduinoX86::MemTelemetry::BufBytesPeak;
+  uint32_t buf_fails = ArduinoX86::MemTelemetry::BufAllocFails;
+  proto_write((uint8_t *)&buf_in_use, sizeof(buf_in_use));
+  proto_write((uint8_t *)&buf_peak, sizeof(buf_peak));
+  proto_write((uint8_t *)&buf_fails, sizeof(buf_fails));
+
+  uint32_t table_size = static_cast<uint32_t>(ArduinoX86::Bus->table_size());
+  uint32_t table_capacity = static_cast<uint32_t>(ArduinoX86::Bus->table_capacity());
+  proto_write((uint8_t *)&table_size, sizeof(table_size));
+  proto_write((uint8_t *)&table_capacity, sizeof(table_capacity));
+  proto_write(ArduinoX86::Bus->table_max_probe());
+
+  uint32_t cycle_log_count = ArduinoX86::CycleLogger->len();
+  uint32_t cycle_log_capacity = MAX_CYCLE_STATES;
+  proto_write((uint8_t *)&cycle_log_count, sizeof(cycle_log_count));
+  proto_write((uint8_t *)&cycle_log_capacity, sizeof(cycle_log_capacity));
+
+  proto_write((uint8_t)SERVER_COMMAND_COUNT);
+  proto_write((uint8_t)32); // Record size: 4 + 8 + 4 + 8 + 8
+  for (size_t i = 0; i < SERVER_COMMAND_COUNT; i++) {
+    const CommandStats& stats = commandStats_[i];
+    proto_write((uint8_t *)&stats.count, sizeof(stats.count));
+    proto_write((uint8_t *)&stats.total_us, sizeof(stats.total_us));
+    proto_write((uint8_t *)&stats.max_us, sizeof(stats.max_us));
+    proto_write((uint8_t *)&stats.bytes_read, sizeof(stats.bytes_read));
+    proto_write((uint8_t *)&stats.bytes_written, sizeof(stats.bytes_written));
+  }
   return true;
 }
 
@@ -1729,9 +3443,260 @@ bool CommandServer<BoardType, ShieldType>::cmd_set_program_bounds() {
   controller_.getBoard().debugPrintf(DebugType::CMD, false, "cmd_set_program_bounds(): Setting bounds from start: %08lX to end: %08lX\n\r", start, end);
 
   CPU.set_program_bounds(start, end);
+  profileBoundsStart_ = start;
+  profileBoundsEnd_ = end;
+  return true;
+}
+
+template<typename BoardType, typename ShieldType>
+void CommandServer<BoardType, ShieldType>::capture_profile(ConfigProfileData& profile) {
+  memset(&profile, 0, sizeof(ConfigProfileData));
+  profile.server_flags = flags_;
+  profile.random_seed = profileSeed_;
+  profile.program_start = profileBoundsStart_;
+  profile.program_end = profileBoundsEnd_;
+  profile.debug_enabled = controller_.getBoard().isDebugEnabled() ? 1 : 0;
+  profile.region_count = profileRegionCount_;
+  for (uint8_t i = 0; i < profileRegionCount_; i++) {
+    profile.regions[i] = profileRegions_[i];
+  }
+}
+
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::apply_profile(const ConfigProfileData& profile) {
+  // Replay the stored configuration through the same command handlers a host
+  // would have driven, so their side effects (backend switching, emulation
+  // arming, debug plumbing) match a hand-configured session exactly. Any
+  // handler refusing its stored value (say, an emulation flag saved against
+  // a since-swapped CPU) fails the apply but leaves the rest installed.
+  bool ok = true;
+
+  commandBuffer_[0] = static_cast<uint8_t>(profile.server_flags & 0xFF);
+  commandBuffer_[1] = static_cast<uint8_t>((profile.server_flags >> 8) & 0xFF);
+  commandBuffer_[2] = static_cast<uint8_t>((profile.server_flags >> 16) & 0xFF);
+  commandBuffer_[3] = static_cast<uint8_t>((profile.server_flags >> 24) & 0xFF);
+  ok &= cmd_set_flags();
+
+  commandBuffer_[0] = static_cast<uint8_t>(profile.random_seed & 0xFF);
+  commandBuffer_[1] = static_cast<uint8_t>((profile.random_seed >> 8) & 0xFF);
+  commandBuffer_[2] = static_cast<uint8_t>((profile.random_seed >> 16) & 0xFF);
+  commandBuffer_[3] = static_cast<uint8_t>((profile.random_seed >> 24) & 0xFF);
+  ok &= cmd_set_random_seed();
+
+  commandBuffer_[0] = static_cast<uint8_t>(profile.program_start & 0xFF);
+  commandBuffer_[1] = static_cast<uint8_t>((profile.program_start >> 8) & 0xFF);
+  commandBuffer_[2] = static_cast<uint8_t>((profile.program_start >> 16) & 0xFF);
+  commandBuffer_[3] = static_cast<uint8_t>((profile.program_start >> 24) & 0xFF);
+  commandBuffer_[4] = static_cast<uint8_t>(profile.program_end & 0xFF);
+  commandBuffer_[5] = static_cast<uint8_t>((profile.program_end >> 8) & 0xFF);
+  commandBuffer_[6] = static_cast<uint8_t>((profile.program_end >> 16) & 0xFF);
+  commandBuffer_[7] = static_cast<uint8_t>((profile.program_end >> 24) & 0xFF);
+  ok &= cmd_set_program_bounds();
+
+  uint8_t region_count = profile.region_count;
+  if (region_count > CONFIG_PROFILE_MAX_REGIONS) {
+    region_count = CONFIG_PROFILE_MAX_REGIONS;
+  }
+  for (uint8_t i = 0; i < region_count; i++) {
+    // The first region replaces the backend's map; the rest append,
+    // exactly as the host composed them (see cmd_set_memory_strategy).
+    commandBuffer_[0] = static_cast<uint8_t>(profile.regions[i].strategy | ((i > 0) ? 0x80 : 0x00));
+    commandBuffer_[1] = static_cast<uint8_t>(profile.regions[i].start & 0xFF);
+    commandBuffer_[2] = static_cast<uint8_t>((profile.regions[i].start >> 8) & 0xFF);
+    commandBuffer_[3] = static_cast<uint8_t>((profile.regions[i].start >> 16) & 0xFF);
+    commandBuffer_[4] = static_cast<uint8_t>((profile.regions[i].start >> 24) & 0xFF);
+    commandBuffer_[5] = static_cast<uint8_t>(profile.regions[i].end & 0xFF);
+    commandBuffer_[6] = static_cast<uint8_t>((profile.regions[i].end >> 8) & 0xFF);
+    commandBuffer_[7] = static_cast<uint8_t>((profile.regions[i].end >> 16) & 0xFF);
+    commandBuffer_[8] = static_cast<uint8_t>((profile.regions[i].end >> 24) & 0xFF);
+    ok &= cmd_set_memory_strategy();
+  }
+
+  commandBuffer_[0] = profile.debug_enabled;
+  ok &= cmd_enable_debug();
+
+  return ok;
+}
+
+// Server command - GetStateProfile
+// Export (and optionally reset) the per-state dwell-time profiler. Takes an
+// op byte: 0 = read, 1 = read then reset, 2 = reset only. Reads answer with
+// a state count byte followed by one 16-byte record per ServerState, in enum
+// order: cumulative microseconds (8 bytes), max single dwell in microseconds
+// (4 bytes), completed dwell count (4 bytes), all little-endian.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_get_state_profile() {
+  debug_cmd("In cmd_get_state_profile()");
+  clear_error();
+
+  uint8_t op = commandBuffer_[0];
+  if (op > 2) {
+    set_error("Invalid state profile op: %d", op);
+    return false;
+  }
+
+  if (op <= 1) {
+    proto_write(static_cast<uint8_t>(STATE_COUNT));
+    for (size_t i = 0; i < STATE_COUNT; i++) {
+      const StateDwell& dwell = stateDwell_[i];
+      uint8_t record[16];
+      for (size_t b = 0; b < 8; b++) {
+        record[b] = static_cast<uint8_t>((dwell.total_us >> (b * 8)) & 0xFF);
+      }
+      for (size_t b = 0; b < 4; b++) {
+        record[8 + b] = static_cast<uint8_t>((dwell.max_us >> (b * 8)) & 0xFF);
+        record[12 + b] = static_cast<uint8_t>((dwell.entries >> (b * 8)) & 0xFF);
+      }
+      proto_write(record, sizeof(record));
+    }
+  }
+
+  if (op >= 1) {
+    memset(stateDwell_, 0, sizeof(stateDwell_));
+    // Start the next measurement window at the reset, not at the last
+    // state change before it.
+    stateBeginTime_ = micros();
+  }
+
+  return true;
+}
+
+// Server command - SetPinInject
+// Program a cycle-scheduled pin injection slot (see PinInjector.h). Takes a
+// slot byte (0xFF disarms all slots; the remaining parameter bytes are then
+// ignored), a pin byte indexing the CmdWritePin pin set, and assert/deassert
+// cycle counts (4 bytes each, little-endian, relative to the last CPU reset;
+// a deassert of 0 asserts only).
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_pin_inject() {
+  debug_cmd("In cmd_set_pin_inject()");
+  clear_error();
+
+  uint8_t slot = commandBuffer_[0];
+  if (slot == 0xFF) {
+    pin_inject_clear();
+    return true;
+  }
+
+  uint8_t pin = commandBuffer_[1];
+  uint32_t assert_cycle = static_cast<uint32_t>(commandBuffer_[2])
+    | (static_cast<uint32_t>(commandBuffer_[3]) << 8)
+    | (static_cast<uint32_t>(commandBuffer_[4]) << 16)
+    | (static_cast<uint32_t>(commandBuffer_[5]) << 24);
+  uint32_t deassert_cycle = static_cast<uint32_t>(commandBuffer_[6])
+    | (static_cast<uint32_t>(commandBuffer_[7]) << 8)
+    | (static_cast<uint32_t>(commandBuffer_[8]) << 16)
+    | (static_cast<uint32_t>(commandBuffer_[9]) << 24);
+
+  if (!pin_inject_program(slot, pin, assert_cycle, deassert_cycle)) {
+    set_error("Invalid pin injection: slot %d, pin %d", slot, pin);
+    return false;
+  }
   return true;
 }
 
+// Server command - SetFpuStub
+// Configure the on-device 8087 BUSY handshake stub (see FpuStub.h). Takes a
+// mode byte (0 = off, 1 = busy-high, 2 = busy-low) and the BUSY window
+// length in cycles (4 bytes, little-endian) that an ESC fetch starts on the
+// TEST pin.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_fpu_stub() {
+  debug_cmd("In cmd_set_fpu_stub()");
+  clear_error();
+
+  uint8_t mode = commandBuffer_[0];
+  uint32_t cycles = static_cast<uint32_t>(commandBuffer_[1])
+    | (static_cast<uint32_t>(commandBuffer_[2]) << 8)
+    | (static_cast<uint32_t>(commandBuffer_[3]) << 16)
+    | (static_cast<uint32_t>(commandBuffer_[4]) << 24);
+
+  if (!fpu_stub_config(mode, cycles)) {
+    set_error("Invalid FPU stub config: mode %d, cycles %lu", mode, (unsigned long)cycles);
+    return false;
+  }
+  return true;
+}
+
+// Server command - SetRefresh
+// Program the DRAM-refresh HOLD generator (see RefreshGenerator.h). Takes a
+// period and a HOLD duration in cycles (4 bytes each, little-endian); the
+// generator asserts HOLD for `duration` cycles every `period` cycles,
+// measured assert-to-assert. A period of 0 disables it.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_refresh() {
+  debug_cmd("In cmd_set_refresh()");
+  clear_error();
+
+  uint32_t period = static_cast<uint32_t>(commandBuffer_[0])
+    | (static_cast<uint32_t>(commandBuffer_[1]) << 8)
+    | (static_cast<uint32_t>(commandBuffer_[2]) << 16)
+    | (static_cast<uint32_t>(commandBuffer_[3]) << 24);
+  uint32_t duration = static_cast<uint32_t>(commandBuffer_[4])
+    | (static_cast<uint32_t>(commandBuffer_[5]) << 8)
+    | (static_cast<uint32_t>(commandBuffer_[6]) << 16)
+    | (static_cast<uint32_t>(commandBuffer_[7]) << 24);
+
+  if (!refresh_gen_program(period, duration)) {
+    set_error("Invalid refresh cadence: period %lu, duration %lu",
+      (unsigned long)period, (unsigned long)duration);
+    return false;
+  }
+  return true;
+}
+
+// Server command - SetProfile
+// Manage flash-persisted configuration profiles. Takes an op byte (0 = save
+// the current flags/strategy/seed/bounds/debug configuration, 1 = erase,
+// 2 = apply) and a slot byte (0 to CONFIG_PROFILE_SLOTS - 1; op 1 accepts
+// 0xFF to erase every slot). Slot 0 is the default profile, applied
+// automatically during setup(), so a farm rig comes back from a reconnect
+// or watchdog reset already configured with no setup round trips.
+template<typename BoardType, typename ShieldType>
+bool CommandServer<BoardType, ShieldType>::cmd_set_profile() {
+  debug_cmd("In cmd_set_profile()");
+  clear_error();
+
+  uint8_t op = commandBuffer_[0];
+  uint8_t slot = commandBuffer_[1];
+
+  switch (op) {
+    case 0: {
+      ConfigProfileData profile;
+      capture_profile(profile);
+      if (!config_profile_save(slot, profile)) {
+        set_error("Profile save failed (bad slot or unsupported board)");
+        return false;
+      }
+      controller_.getBoard().debugPrintf(DebugType::CMD, false, "## cmd_set_profile(): Saved profile to slot %d\n\r", slot);
+      return true;
+    }
+    case 1:
+      if (!config_profile_erase(slot)) {
+        set_error("Profile erase failed (bad slot or unsupported board)");
+        return false;
+      }
+      controller_.getBoard().debugPrintf(DebugType::CMD, false, "## cmd_set_profile(): Erased profile slot %d\n\r", slot);
+      return true;
+    case 2: {
+      ConfigProfileData profile;
+      if (!config_profile_load(slot, profile)) {
+        set_error("No valid profile in slot %d", slot);
+        return false;
+      }
+      if (!apply_profile(profile)) {
+        set_error("Profile in slot %d did not apply cleanly", slot);
+        return false;
+      }
+      controller_.getBoard().debugPrintf(DebugType::CMD, false, "## cmd_set_profile(): Applied profile from slot %d\n\r", slot);
+      return true;
+    }
+    default:
+      set_error("Invalid profile op: %d", op);
+      return false;
+  }
+}
+
 template<typename BoardType, typename ShieldType>
 bool CommandServer<BoardType, ShieldType>::cmd_null() {
   return true;
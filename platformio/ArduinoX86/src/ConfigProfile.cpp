@@ -0,0 +1,145 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include <arduinox86.h>
+#include <config.h>
+#include <ConfigProfile.h>
+
+#if defined(ARDUINO_GIGA)
+
+#include <drivers/FlashIAP.h>
+
+// Profiles live in the last 128K sector of flash bank 2, far above the M4
+// front-end image at the start of the bank. Erasing a bank 2 sector stalls
+// reads on that bank for the duration, so an M4-resident front end pauses
+// briefly during a save - saves are rare host operations, not hot-path work.
+static constexpr uint32_t PROFILE_FLASH_BASE = 0x081E0000ul;
+
+/// @brief Rewrite the profile sector with one slot replaced (or erased).
+/// Flash only clears bits on program, so any slot change means reading all
+/// slots to RAM, erasing the sector, and writing the survivors back.
+/// @param slot Slot to replace or erase, or 0xFF to erase every slot.
+/// @param replacement New contents for the slot, or nullptr to erase it.
+/// @return True if the sector was rewritten successfully.
+static bool profile_rewrite(uint8_t slot, const ConfigProfileData* replacement) {
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) {
+    return false;
+  }
+
+  static ConfigProfileData slots[CONFIG_PROFILE_SLOTS];
+  if (flash.read(slots, PROFILE_FLASH_BASE, sizeof(slots)) != 0) {
+    flash.deinit();
+    return false;
+  }
+
+  if (slot == 0xFF) {
+    memset(slots, 0xFF, sizeof(slots));
+  }
+  else if (replacement != nullptr) {
+    slots[slot] = *replacement;
+  }
+  else {
+    memset(&slots[slot], 0xFF, sizeof(ConfigProfileData));
+  }
+
+  const uint32_t sector_size = flash.get_sector_size(PROFILE_FLASH_BASE);
+  if (flash.erase(PROFILE_FLASH_BASE, sector_size) != 0) {
+    flash.deinit();
+    return false;
+  }
+
+  const bool ok = (flash.program(slots, PROFILE_FLASH_BASE, sizeof(slots)) == 0);
+  flash.deinit();
+  return ok;
+}
+
+bool config_profile_load(uint8_t slot, ConfigProfileData& out) {
+  if (slot >= CONFIG_PROFILE_SLOTS) {
+    return false;
+  }
+
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) {
+    return false;
+  }
+  const int result = flash.read(
+    &out,
+    PROFILE_FLASH_BASE + static_cast<uint32_t>(slot) * sizeof(ConfigProfileData),
+    sizeof(ConfigProfileData)
+  );
+  flash.deinit();
+
+  return (result == 0) && config_profile_valid(out);
+}
+
+bool config_profile_save(uint8_t slot, ConfigProfileData& profile) {
+  if (slot >= CONFIG_PROFILE_SLOTS) {
+    return false;
+  }
+
+  profile.magic = CONFIG_PROFILE_MAGIC;
+  profile.version = CONFIG_PROFILE_VERSION;
+  profile.reserved = 0;
+  profile.checksum = config_profile_sum(profile);
+
+  if (!profile_rewrite(slot, &profile)) {
+    return false;
+  }
+
+  // Read back through flash to verify the slot took.
+  ConfigProfileData verify;
+  return config_profile_load(slot, verify) && (verify.checksum == profile.checksum);
+}
+
+bool config_profile_erase(uint8_t slot) {
+  if ((slot != 0xFF) && (slot >= CONFIG_PROFILE_SLOTS)) {
+    return false;
+  }
+  return profile_rewrite(slot, nullptr);
+}
+
+#else // !defined(ARDUINO_GIGA)
+
+// No flash driver wired for this board; report no stored profiles and
+// refuse saves, so hosts fall back to the explicit setup commands.
+bool config_profile_load(uint8_t slot, ConfigProfileData& out) {
+  (void)slot;
+  (void)out;
+  return false;
+}
+
+bool config_profile_save(uint8_t slot, ConfigProfileData& profile) {
+  (void)slot;
+  (void)profile;
+  return false;
+}
+
+bool config_profile_erase(uint8_t slot) {
+  (void)slot;
+  return false;
+}
+
+#endif // defined(ARDUINO_GIGA)
@@ -31,6 +31,10 @@ void Cpu::reset(CpuResetResult reset_result, bool preserve_bus_state, bool reset
   if (reset_result.busWidth == BusWidth::Eight) {
     width = CpuBusWidth::Eight;
     queue = InstructionQueue(4, BusWidth::Eight);
+  } else if (cpu_type == CpuType::i80386) {
+    // The 386 has a 16-byte prefetch queue.
+    width = CpuBusWidth::Sixteen;
+    queue = InstructionQueue(16, BusWidth::Sixteen);
   } else {
     width = CpuBusWidth::Sixteen;
     queue = InstructionQueue(6, BusWidth::Sixteen);
@@ -101,6 +105,7 @@ void Cpu::reset(CpuResetResult reset_result, bool preserve_bus_state, bool reset
   execute_cycle_ct = 0;
   wait_states = 0;
   wait_state_ct = 0;
+  wait_states_active = 0;
   exception_armed = false;
   predicted_fetch = 0;
 }
\ No newline at end of file
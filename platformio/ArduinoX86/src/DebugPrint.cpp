@@ -21,11 +21,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 #include <Arduino.h>
+#include <serial_config.h>
 #include <DebugPrint.h>
 #include <cstdarg>
 
 template<typename SerialPort>
-void DebugPrintMixin<SerialPort>::debugPrintf(DebugType stage, bool defer, const char* fmt, ...) {
+void DebugPrintMixin<SerialPort>::debugPrintfImpl(DebugType stage, bool defer, const char* fmt, ...) {
   if (!serial || !filter.isEnabled(stage) || !enabled_) return;
 
   va_list args;
@@ -61,8 +62,4 @@ void DebugPrintMixin<SerialPort>::debugPrintf(DebugType stage, bool defer, const
   }
 }
 
-#if defined(ARDUINO_GIGA)
-  template class DebugPrintMixin<decltype(Serial2)>;
-#else 
-  template class DebugPrintMixin<decltype(Serial1)>;
-#endif
\ No newline at end of file
+template class DebugPrintMixin<decltype(DebugRing)>;
\ No newline at end of file
@@ -0,0 +1,87 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <arduinox86.h>
+#include <config.h>
+#include <globals.h>
+#include <Shield.h>
+#include <shields/Pins.h>
+#include <FpuStub.h>
+
+uint8_t fpu_stub_enabled = 0;
+
+static bool busy_high = true;      // Level driven during the BUSY window
+static uint32_t busy_cycles = 0;   // Window length an ESC fetch starts
+static uint32_t busy_remaining = 0;
+
+static void drive_busy(bool busy) {
+  Controller.writePin(OutputPin::Test, busy ? busy_high : !busy_high);
+}
+
+bool fpu_stub_config(uint8_t mode, uint32_t cycles) {
+  switch (mode) {
+    case 0:
+      fpu_stub_enabled = 0;
+      busy_remaining = 0;
+      return true;
+    case 1:
+      busy_high = true;
+      break;
+    case 2:
+      busy_high = false;
+      break;
+    default:
+      return false;
+  }
+  if (cycles == 0) {
+    return false;
+  }
+  busy_cycles = cycles;
+  busy_remaining = 0;
+  fpu_stub_enabled = 1;
+  // Present idle immediately so a WAIT with no preceding ESC completes.
+  drive_busy(false);
+  return true;
+}
+
+void fpu_stub_on_esc() {
+  // A back-to-back ESC restarts the window, as a real 8087 accepting a new
+  // instruction would hold BUSY through it.
+  if (busy_remaining == 0) {
+    drive_busy(true);
+  }
+  busy_remaining = busy_cycles;
+}
+
+void fpu_stub_service() {
+  if (busy_remaining == 0) return;
+  if (--busy_remaining == 0) {
+    drive_busy(false);
+  }
+}
+
+void fpu_stub_reset() {
+  if (!fpu_stub_enabled) return;
+  busy_remaining = 0;
+  drive_busy(false);
+}
@@ -0,0 +1,112 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <arduinox86.h>
+#include <config.h>
+#include <globals.h>
+#include <Shield.h>
+#include <shields/Pins.h>
+#include <PinInjector.h>
+
+// One scheduled pin window. A pin of OutputPin::Invalid marks the slot free.
+struct PinInjection {
+  OutputPin pin;
+  uint32_t assert_cycle;
+  uint32_t deassert_cycle; // 0: assert only
+  bool asserted;           // Assert edge has fired
+};
+
+static PinInjection slots[PIN_INJECT_SLOTS];
+static bool slots_init = false;
+
+uint8_t pin_inject_armed = 0;
+
+// The CmdWritePin pin index set, in order.
+static const OutputPin INJECT_PINS[4] = {
+  OutputPin::Ready, OutputPin::Test, OutputPin::Intr, OutputPin::Nmi
+};
+
+static void init_slots() {
+  for (size_t i = 0; i < PIN_INJECT_SLOTS; i++) {
+    slots[i].pin = OutputPin::Invalid;
+    slots[i].asserted = false;
+  }
+  slots_init = true;
+}
+
+bool pin_inject_program(uint8_t slot, uint8_t pin, uint32_t assert_cycle, uint32_t deassert_cycle) {
+  if (!slots_init) init_slots();
+  if (slot >= PIN_INJECT_SLOTS) return false;
+  if (pin >= 4) return false;
+  if ((deassert_cycle != 0) && (deassert_cycle <= assert_cycle)) return false;
+
+  PinInjection& inj = slots[slot];
+  if (inj.pin == OutputPin::Invalid) {
+    pin_inject_armed++;
+  }
+  inj.pin = INJECT_PINS[pin];
+  inj.assert_cycle = assert_cycle;
+  inj.deassert_cycle = deassert_cycle;
+  inj.asserted = false;
+  return true;
+}
+
+void pin_inject_clear() {
+  if (!slots_init) {
+    init_slots();
+    return;
+  }
+  for (size_t i = 0; i < PIN_INJECT_SLOTS; i++) {
+    PinInjection& inj = slots[i];
+    if (inj.pin != OutputPin::Invalid && inj.asserted) {
+      // Don't leave a half-fired injection driving the pin.
+      Controller.writePin(inj.pin, false);
+    }
+    inj.pin = OutputPin::Invalid;
+    inj.asserted = false;
+  }
+  pin_inject_armed = 0;
+}
+
+void pin_inject_service(uint64_t cycle) {
+  for (size_t i = 0; i < PIN_INJECT_SLOTS; i++) {
+    PinInjection& inj = slots[i];
+    if (inj.pin == OutputPin::Invalid) continue;
+
+    if (!inj.asserted && cycle >= inj.assert_cycle) {
+      Controller.writePin(inj.pin, true);
+      inj.asserted = true;
+      if (inj.deassert_cycle == 0) {
+        // Assert-only window; the slot's work is done.
+        inj.pin = OutputPin::Invalid;
+        pin_inject_armed--;
+      }
+    }
+    else if (inj.asserted && cycle >= inj.deassert_cycle) {
+      Controller.writePin(inj.pin, false);
+      inj.pin = OutputPin::Invalid;
+      inj.asserted = false;
+      pin_inject_armed--;
+    }
+  }
+}
@@ -0,0 +1,146 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <arduinox86.h>
+#include <config.h>
+#include <globals.h>
+#include <Shield.h>
+#include <ReadyTimer.h>
+
+#if defined(ARDUINO_GIGA)
+
+// TIM16 is free on the Giga mbed core (the us-ticker uses TIM5, PwmOut uses
+// the timer belonging to its pin), 16-bit, and clocked from the APB2 timer
+// kernel clock.
+
+static uint32_t window_ticks = 0;
+static bool timer_ready = false;
+
+// Handshake between the ALE interrupt, the timer interrupt and the main
+// loop. window_elapsed/release_armed are only touched with the timer
+// interrupt masked or from within it.
+static volatile bool window_running = false;
+static volatile bool window_elapsed = false;
+static volatile bool release_armed = false;
+
+static void ready_timer_isr() {
+  TIM16->SR = 0;
+  window_running = false;
+  window_elapsed = true;
+  if (release_armed) {
+    // The frozen cycle was already serviced; this edge is the programmed
+    // deadline, so the release is exact in ticks from the ALE edge.
+    release_armed = false;
+    window_elapsed = false;
+    WRITE_READY_PIN(READY_ASSERT);
+  }
+}
+
+static bool ready_timer_init() {
+  RCC->APB2ENR |= RCC_APB2ENR_TIM16EN;
+  (void)RCC->APB2ENR; // Read back to order the enable before register access.
+
+  TIM16->CR1 = TIM_CR1_OPM; // One-pulse: CEN self-clears at update.
+  TIM16->PSC = 0;
+  TIM16->EGR = TIM_EGR_UG;  // Latch the prescaler.
+  TIM16->SR = 0;            // UG set UIF; clear it before unmasking.
+  TIM16->DIER = TIM_DIER_UIE;
+
+  NVIC_SetVector(TIM16_IRQn, (uint32_t)&ready_timer_isr);
+  NVIC_SetPriority(TIM16_IRQn, 1);
+  NVIC_EnableIRQ(TIM16_IRQn);
+  return true;
+}
+
+bool ready_timer_program(uint32_t ticks) {
+  if (ticks == 0) {
+    window_ticks = 0;
+    return true;
+  }
+  if (!timer_ready) {
+    timer_ready = ready_timer_init();
+    if (!timer_ready) {
+      return false;
+    }
+  }
+  // 16-bit timer: at 240 MHz the ceiling is a ~273us window, far beyond any
+  // useful wait-state count.
+  if (ticks > 0x10000) {
+    ticks = 0x10000;
+  }
+  window_ticks = ticks;
+  TIM16->ARR = ticks - 1; // Update fires after ARR+1 counts.
+  return true;
+}
+
+uint32_t ready_timer_ticks() {
+  return window_ticks;
+}
+
+uint32_t ready_timer_hz() {
+  // APB2 timer kernel clock on the stock mbed clock tree: HCLK/2 prescaler
+  // into APB2, doubled back for timers (TIMPRE=0), i.e. SystemCoreClock/2.
+  return SystemCoreClock / 2;
+}
+
+void ready_timer_start() {
+  if (window_ticks == 0) {
+    return;
+  }
+  release_armed = false;
+  window_elapsed = false;
+  window_running = true;
+  TIM16->CNT = 0;
+  TIM16->SR = 0;
+  TIM16->CR1 = TIM_CR1_OPM | TIM_CR1_CEN;
+}
+
+bool ready_timer_release() {
+  if (window_ticks == 0 || (!window_running && !window_elapsed)) {
+    return false;
+  }
+  __disable_irq();
+  if (window_elapsed) {
+    // Servicing overran the window; release now, clamping at the minimum.
+    window_elapsed = false;
+    WRITE_READY_PIN(READY_ASSERT);
+  }
+  else {
+    release_armed = true;
+  }
+  __enable_irq();
+  return true;
+}
+
+#else
+
+// No hardware timer wired up on this platform; the free-run path keeps its
+// software READY release. Disabling always succeeds so hosts can issue an
+// unconditional CmdSetReadyTimer(0).
+bool ready_timer_program(uint32_t ticks) { return ticks == 0; }
+uint32_t ready_timer_ticks() { return 0; }
+uint32_t ready_timer_hz() { return 0; }
+void ready_timer_start() {}
+bool ready_timer_release() { return false; }
+
+#endif
@@ -0,0 +1,103 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <arduinox86.h>
+#include <config.h>
+#include <globals.h>
+#include <Shield.h>
+#include <shields/Pins.h>
+#include <RefreshGenerator.h>
+
+uint8_t refresh_gen_state = 0;
+
+static uint32_t gen_period = 0;   // Cycles between HOLD assertions
+static uint32_t gen_duration = 0; // Cycles HOLD stays asserted
+static uint32_t countdown = 0;    // Cycles to the next state change
+static uint32_t hold_count = 0;
+static uint32_t granted_cycles = 0;
+
+bool refresh_gen_program(uint32_t period, uint32_t duration) {
+  if (period == 0) {
+    if (refresh_gen_state & REFRESH_GEN_HOLDING) {
+      Controller.writePin(OutputPin::Hold, false);
+    }
+    refresh_gen_state = 0;
+    gen_period = 0;
+    return true;
+  }
+  // The CPU must get the bus back between refreshes.
+  if ((duration == 0) || (duration >= period)) {
+    return false;
+  }
+  if (refresh_gen_state & REFRESH_GEN_HOLDING) {
+    Controller.writePin(OutputPin::Hold, false);
+  }
+  gen_period = period;
+  gen_duration = duration;
+  countdown = period;
+  hold_count = 0;
+  granted_cycles = 0;
+  refresh_gen_state = REFRESH_GEN_ENABLED;
+  return true;
+}
+
+void refresh_gen_service() {
+  if (refresh_gen_state & REFRESH_GEN_HOLDING) {
+    // The CPU acknowledges by floating the bus; passive cycles under HOLD
+    // are the granted (stolen) ones.
+    if (CPU.bus_state == PASV) {
+      granted_cycles++;
+    }
+    if (--countdown == 0) {
+      Controller.writePin(OutputPin::Hold, false);
+      refresh_gen_state = REFRESH_GEN_ENABLED;
+      // The period is measured assert-to-assert, like the 8237's cadence.
+      countdown = gen_period - gen_duration;
+    }
+  }
+  else {
+    if (--countdown == 0) {
+      Controller.writePin(OutputPin::Hold, true);
+      refresh_gen_state = REFRESH_GEN_ENABLED | REFRESH_GEN_HOLDING;
+      countdown = gen_duration;
+      hold_count++;
+    }
+  }
+}
+
+void refresh_gen_reset() {
+  if (!refresh_gen_state) return;
+  if (refresh_gen_state & REFRESH_GEN_HOLDING) {
+    Controller.writePin(OutputPin::Hold, false);
+  }
+  refresh_gen_state = REFRESH_GEN_ENABLED;
+  countdown = gen_period;
+}
+
+uint32_t refresh_gen_count() {
+  return hold_count;
+}
+
+uint32_t refresh_gen_granted_cycles() {
+  return granted_cycles;
+}
@@ -0,0 +1,255 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// On-target microbenchmark firmware (env:giga_r1_m7_bench / env:dueUSB_bench).
+//
+// Runs a fixed suite over the primitives that bound server throughput -
+// data bus GPIO read/write, setBusDirection switching, HashBackend
+// read_bus, in-band serial transmit, and SDRAM copy - and reports raw DWT
+// cycle counts in machine-readable lines:
+//
+//   BENCH-BEGIN version=1 f_cpu=480000000
+//   BENCH name=gpio_read iters=10000 cycles=1234567
+//   ...
+//   BENCH-END
+//
+// The suite runs once after the serial port opens and again whenever a byte
+// is received, so before/after comparisons can be scripted from the host.
+// Flash this to a rig WITHOUT a CPU installed: the GPIO benchmarks drive the
+// data bus pins with nothing expected on the other end.
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <serial_config.h>
+#include <BusTypes.h>
+#include <Shield.h>
+#include <bus_emulator/HashBackend.h>
+
+#if defined(ARDUINO_GIGA)
+#include <SdramInit.h>
+#endif
+
+// The shield is exercised directly; no Board or BoardController is needed
+// since the suite never touches a live CPU.
+static ShieldType BenchShield;
+
+// Sink for benchmarked loads so the compiler cannot elide them.
+static volatile uint16_t bench_sink;
+
+// ---------------------------------------------------------------------------
+// Timing
+// ---------------------------------------------------------------------------
+
+// Start the free-running DWT cycle counter (same sequence CycleStateLogger
+// uses for trace timestamps). Present on both the Giga's Cortex-M7 and the
+// Due's Cortex-M3.
+static void bench_timer_init() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t bench_cycles() {
+  return DWT->CYCCNT;
+}
+
+// Emit one result line. Cycle counts are raw; the host divides by f_cpu
+// from the BENCH-BEGIN line.
+static void report(const char *name, uint32_t iters, uint32_t cycles) {
+  char buf[96];
+  snprintf(buf, sizeof(buf), "BENCH name=%s iters=%lu cycles=%lu",
+    name, (unsigned long)iters, (unsigned long)cycles);
+  INBAND_SERIAL.println(buf);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+// Empty loop, reported so the host can subtract harness overhead from the
+// per-iteration numbers.
+static void bench_loop_overhead() {
+  const uint32_t ITERS = 10000;
+  uint32_t start = bench_cycles();
+  for (uint32_t i = 0; i < ITERS; i++) {
+    __NOP();
+  }
+  report("loop_overhead", ITERS, bench_cycles() - start);
+}
+
+// Full 16-bit data bus gather, peek mode (no direction switch), as done on
+// every read bus cycle.
+static void bench_gpio_read() {
+  const uint32_t ITERS = 10000;
+  BenchShield.setBusDirection(BusDirection::Input, ActiveBusWidth::Sixteen);
+  uint32_t start = bench_cycles();
+  for (uint32_t i = 0; i < ITERS; i++) {
+    bench_sink = BenchShield.readDataBus(ActiveBusWidth::Sixteen, true);
+  }
+  report("gpio_read", ITERS, bench_cycles() - start);
+}
+
+// Full 16-bit data bus scatter, as done on every write bus cycle. Includes
+// the redundant direction set that writeDataBus performs internally.
+static void bench_gpio_write() {
+  const uint32_t ITERS = 10000;
+  uint32_t start = bench_cycles();
+  for (uint32_t i = 0; i < ITERS; i++) {
+    BenchShield.writeDataBus((uint16_t)i, ActiveBusWidth::Sixteen);
+  }
+  report("gpio_write", ITERS, bench_cycles() - start);
+  BenchShield.setBusDirection(BusDirection::Input, ActiveBusWidth::Sixteen);
+}
+
+// Alternating Input/Output direction switches; each iteration is one full
+// round trip, matching the read-then-write pattern of a store program.
+static void bench_bus_direction() {
+  const uint32_t ITERS = 5000;
+  uint32_t start = bench_cycles();
+  for (uint32_t i = 0; i < ITERS; i++) {
+    BenchShield.setBusDirection(BusDirection::Output, ActiveBusWidth::Sixteen);
+    BenchShield.setBusDirection(BusDirection::Input, ActiveBusWidth::Sixteen);
+  }
+  report("bus_direction_pair", ITERS, bench_cycles() - start);
+}
+
+// HashBackend word reads at the load the cycle engine presents: sequential
+// fetch runs (hot-entry cache hits) and scattered accesses (full hash+probe)
+// against a table seeded to a realistic occupancy.
+static void bench_hash_read() {
+  static HashBackend *backend = nullptr;
+  if (backend == nullptr) {
+    backend = new HashBackend(65536);
+    // ~8K resident words spread over a 128KB window, comparable to a loaded
+    // test program plus its data.
+    for (uint32_t i = 0; i < 8192; i++) {
+      backend->write_u16((i * 16) & 0x1FFFF, (uint16_t)i);
+    }
+  }
+
+  const uint32_t ITERS = 10000;
+  uint32_t start = bench_cycles();
+  for (uint32_t i = 0; i < ITERS; i++) {
+    // 16-word window, sequential: the prefetch-run shape the cache targets.
+    bench_sink = backend->read_bus((i & 0xF) << 1, true);
+  }
+  report("hash_read_seq", ITERS, bench_cycles() - start);
+
+  start = bench_cycles();
+  uint32_t addr = 0;
+  for (uint32_t i = 0; i < ITERS; i++) {
+    // Large odd stride defeats the direct-mapped cache, so every access
+    // pays for a full probe.
+    addr = (addr + 4994) & 0x1FFFF;
+    bench_sink = backend->read_bus(addr, true);
+  }
+  report("hash_read_scatter", ITERS, bench_cycles() - start);
+}
+
+// Sustained in-band serial transmit. The host must drain the port or the
+// USB stack's flow control dominates the measurement - which is itself a
+// useful number when comparing hosts.
+static void bench_serial_tx() {
+  static uint8_t chunk[1024];
+  for (size_t i = 0; i < sizeof(chunk); i++) {
+    chunk[i] = (uint8_t)i;
+  }
+  const uint32_t CHUNKS = 32;
+  uint32_t start = bench_cycles();
+  for (uint32_t i = 0; i < CHUNKS; i++) {
+    INBAND_SERIAL.write(chunk, sizeof(chunk));
+  }
+  INBAND_SERIAL.flush();
+  uint32_t cycles = bench_cycles() - start;
+  INBAND_SERIAL.println();
+  report("serial_tx_32k", CHUNKS * sizeof(chunk), cycles);
+}
+
+#if defined(ARDUINO_GIGA)
+// Bulk SDRAM-to-SDRAM copy, the bottom layer under snapshot/restore.
+static void bench_sdram_copy() {
+  static uint8_t *src = nullptr;
+  static uint8_t *dst = nullptr;
+  const size_t BYTES = 65536;
+  if (src == nullptr) {
+    ensure_sdram();
+    src = (uint8_t *)SDRAM.malloc(BYTES);
+    dst = (uint8_t *)SDRAM.malloc(BYTES);
+  }
+  if ((src == nullptr) || (dst == nullptr)) {
+    INBAND_SERIAL.println("BENCH name=sdram_copy_64k error=alloc_failed");
+    return;
+  }
+  const uint32_t ITERS = 16;
+  uint32_t start = bench_cycles();
+  for (uint32_t i = 0; i < ITERS; i++) {
+    memcpy(dst, src, BYTES);
+  }
+  report("sdram_copy_64k", ITERS, bench_cycles() - start);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Suite driver
+// ---------------------------------------------------------------------------
+
+static void run_suite() {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "BENCH-BEGIN version=1 f_cpu=%lu",
+    (unsigned long)F_CPU);
+  INBAND_SERIAL.println(buf);
+
+  bench_loop_overhead();
+  bench_gpio_read();
+  bench_gpio_write();
+  bench_bus_direction();
+  bench_hash_read();
+  bench_serial_tx();
+#if defined(ARDUINO_GIGA)
+  bench_sdram_copy();
+#endif
+
+  INBAND_SERIAL.println("BENCH-END");
+}
+
+void setup() {
+  INBAND_SERIAL.begin(BAUD_RATE);
+  while (!INBAND_SERIAL)
+    ;
+
+  ShieldType::initPins();
+  bench_timer_init();
+
+  run_suite();
+}
+
+void loop() {
+  // Any received byte reruns the suite.
+  if (INBAND_SERIAL.available()) {
+    while (INBAND_SERIAL.available()) {
+      INBAND_SERIAL.read();
+    }
+    run_suite();
+  }
+}
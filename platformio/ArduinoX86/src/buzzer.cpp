@@ -15,7 +15,7 @@
     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER   
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
     DEALINGS IN THE SOFTWARE.
@@ -23,20 +23,96 @@
 
 #include <Arduino.h>
 
-// Buzzer control routines
+#include <config.h>
 
+#if FAST_BOOT
+
+// Fast-boot builds compile the buzzer out entirely; the farm rigs are
+// headless and every byte of boot-path code counts there.
+void beep(uint32_t time) { (void)time; }
+void error_beep() {}
+void buzzer_service() {}
+
+#else
+
+// Buzzer control routines.
+//
+// Beep patterns used to play synchronously with delay(), putting hundreds of
+// milliseconds of dead time on the critical path of every board reset — and
+// the farm resets boards constantly. Patterns are now a small state machine:
+// callers enqueue {on, duration} steps and return immediately, and
+// buzzer_service(), polled from loop(), advances the pattern against millis()
+// deadlines. A hardware timer would do the same job, but the Due and Giga
+// cores expose different timer APIs and a once-per-loop poll is more than
+// adequate for audio feedback.
+
+struct BuzzerStep {
+  bool on;            // Drive the buzzer during this step?
+  uint16_t duration_ms;
+};
+
+static const size_t BUZZER_MAX_STEPS = 8;
+static BuzzerStep buzzer_steps[BUZZER_MAX_STEPS];
+static size_t buzzer_step_count = 0;
+static size_t buzzer_step_idx = 0;
+static unsigned long buzzer_deadline = 0;
+static bool buzzer_active = false;
+
+static void buzzer_write(bool on) {
+  // Buzzer output is currently disabled.
+  // pinMode(BUZZER_PIN, OUTPUT);
+  // digitalWrite(BUZZER_PIN, on ? HIGH : LOW);
+  (void)on;
+}
+
+// Begin a pattern, replacing any pattern still in progress.
+static void buzzer_start(const BuzzerStep *steps, size_t count) {
+  if (count > BUZZER_MAX_STEPS) {
+    count = BUZZER_MAX_STEPS;
+  }
+  for (size_t i = 0; i < count; i++) {
+    buzzer_steps[i] = steps[i];
+  }
+  buzzer_step_count = count;
+  buzzer_step_idx = 0;
+  buzzer_active = (count > 0);
+  if (buzzer_active) {
+    buzzer_write(buzzer_steps[0].on);
+    buzzer_deadline = millis() + buzzer_steps[0].duration_ms;
+  }
+}
+
+// Advance the active pattern. Called once per main loop; does nothing when
+// idle.
+void buzzer_service() {
+  if (!buzzer_active) {
+    return;
+  }
+  if ((long)(millis() - buzzer_deadline) < 0) {
+    return;
+  }
+  buzzer_step_idx++;
+  if (buzzer_step_idx >= buzzer_step_count) {
+    buzzer_write(false);
+    buzzer_active = false;
+    return;
+  }
+  buzzer_write(buzzer_steps[buzzer_step_idx].on);
+  buzzer_deadline += buzzer_steps[buzzer_step_idx].duration_ms;
+}
 
 void beep(uint32_t time) {
-//   pinMode(BUZZER_PIN, OUTPUT);
-//   digitalWrite(BUZZER_PIN, HIGH);
-//   delay(time);
-//   digitalWrite(BUZZER_PIN, LOW);
+  BuzzerStep step = { true, (uint16_t)time };
+  buzzer_start(&step, 1);
 }
 
 void error_beep() {
-  beep(100);
-  delay(100);
-  beep(100);
-  delay(100);
-  beep(100);
+  static const BuzzerStep pattern[] = {
+    { true, 100 }, { false, 100 },
+    { true, 100 }, { false, 100 },
+    { true, 100 },
+  };
+  buzzer_start(pattern, sizeof(pattern) / sizeof(pattern[0]));
 }
+
+#endif // FAST_BOOT
@@ -25,8 +25,25 @@
 #include <config.h>
 #include <serial_config.h>
 
+// TraceSeq and the MemTelemetry counters are defined in the ArduinoX86Core
+// library (CoreGlobals.cpp) so standalone sketch consumers link them too.
+
 extern uint8_t PACKET_BUFFER[PACKET_SIZE]; // Packet buffer for serial communication
 
+// Dedicated trace channel: a second CDC interface on the composite USB
+// device (see serial_config.h). Constructed non-blocking; the host side may
+// never open it.
+#if TRACE_SERIAL_DEDICATED
+arduino::USBSerial SerialTrace(false);
+#endif
+
+// Debug output staging ring; DEBUG_SERIAL resolves to this (serial_config.h).
+#if defined(__SAM3X8E__)
+DebugRingSerial<decltype(Serial1)> DebugRing(Serial1);
+#elif defined(ARDUINO_GIGA) && !defined(CORE_CM4)
+DebugRingSerial<decltype(Serial2)> DebugRing(Serial2);
+#endif
+
 #if defined(SHIELD_8088_V1)
 #include <shields/Shield8088.h>
 
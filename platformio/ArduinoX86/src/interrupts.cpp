@@ -26,6 +26,7 @@
 #include <config.h>
 #include <globals.h>
 #include <Shield.h>
+#include <ReadyTimer.h>
 
 /// @brief Handle assertion of ALE/ADS by deasserting READY pin.
 void ale_interrupt_handler() {
@@ -43,4 +44,20 @@ void readyo_interrupt_handler() {
 
 void cycle_edge_interrupt_handler() {
   DEBUG_SERIAL.println("@");
+}
+
+volatile bool free_run_cycle_pending = false;
+
+/// @brief Freeze the bus cycle that just started while the CPU clock free-runs.
+/// Deasserts READY to hold the CPU in wait states, then latches the port
+/// snapshot while the address and status lines are still valid at T1. The main
+/// loop services the frozen cycle and re-asserts READY to release the CPU.
+void free_run_ale_handler() {
+  WRITE_READY_PIN(READY_DEASSERT);
+  // Start the hardware wait-state window immediately after the deassert so
+  // the programmed duration is measured from (near) the ALE edge, not from
+  // whenever servicing finishes. No-op unless a window is programmed.
+  ready_timer_start();
+  Controller.captureSnapshot();
+  free_run_cycle_pending = true;
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Protocol front end running on the Giga's Cortex-M4 (env:giga_r1_m4).
+//
+// The M7 pumps raw USB bytes into the usb_rx ring; this core frames them into
+// [cmd][len][params] frames on cmd_ring, mirroring the byte-at-a-time state
+// machine that CommandServer::run() uses in single-core builds, and passes
+// streamed payload bytes through raw on payload_ring. See DualCore.h for the
+// shared-memory layout. This image is only useful when the M7 image was built
+// with USE_DUAL_CORE=1; flash it to the second flash bank.
+
+#include <Arduino.h>
+#include <config.h>
+#include <protocol.h>
+#include <DualCore.h>
+
+#if defined(CORE_CM4)
+
+enum class FramerState : uint8_t {
+  WaitingForCommand,
+  ReadingParams,
+  Passthrough,
+};
+
+static FramerState framerState = FramerState::WaitingForCommand;
+static uint8_t frameCmd = 0;
+static uint8_t frameLen = 0;
+static uint8_t frameN = 0;
+static uint8_t frameBuf[255];
+static unsigned long frameStartTime = 0;
+static uint32_t passthroughSeq = 0;
+
+/// @brief Push the assembled frame to the M7, blocking on ring space (the M7
+/// drains the ring every loop). Streaming commands then switch the framer to
+/// raw passthrough until the M7 reports the command complete.
+static void emit_frame() {
+  DualCoreShm *shm = dual_core_shm();
+
+  // frameN rather than frameLen: timeout frames carry no parameter bytes.
+  while (shm->cmd_ring.free_space() < (uint32_t)(2 + frameN)) {
+    // Wait for the M7 to drain the command ring.
+  }
+  shm->cmd_ring.write(frameCmd);
+  shm->cmd_ring.write(frameLen);
+  shm->cmd_ring.write(frameBuf, frameN);
+
+  if (frameLen != DC_FRAME_TIMEOUT &&
+      server_command_streams_payload(static_cast<ServerCommand>(frameCmd))) {
+    passthroughSeq = shm->cmd_done_seq;
+    framerState = FramerState::Passthrough;
+  } else {
+    framerState = FramerState::WaitingForCommand;
+  }
+}
+
+void setup() {
+  DualCoreShm *shm = dual_core_shm();
+
+  // The M7 initializes the shared block before releasing us from reset, but
+  // don't touch the rings until the magic confirms it.
+  while (shm->magic != DC_SHM_MAGIC) {
+  }
+  shm->m4_ready = 1;
+}
+
+void loop() {
+  DualCoreShm *shm = dual_core_shm();
+  shm->m4_heartbeat = shm->m4_heartbeat + 1;
+
+  switch (framerState) {
+
+    case FramerState::WaitingForCommand: {
+      int b = shm->usb_rx.read();
+      if (b < 0) {
+        break;
+      }
+      frameCmd = (uint8_t)b;
+      frameN = 0;
+
+      if (frameCmd >= static_cast<uint8_t>(ServerCommand::CmdInvalid)) {
+        // Forward invalid opcodes as empty frames; the M7 stays authoritative
+        // and answers with the failure byte.
+        frameLen = 0;
+        emit_frame();
+        break;
+      }
+
+      frameLen = server_command_param_bytes(static_cast<ServerCommand>(frameCmd));
+      if (frameLen == 0) {
+        emit_frame();
+      } else {
+        frameStartTime = millis();
+        framerState = FramerState::ReadingParams;
+      }
+      break;
+    }
+
+    case FramerState::ReadingParams: {
+      int b = shm->usb_rx.read();
+      if (b >= 0) {
+        frameBuf[frameN++] = (uint8_t)b;
+        if (frameN == frameLen) {
+          emit_frame();
+        }
+      } else if (millis() - frameStartTime >= CMD_TIMEOUT) {
+        // Timed out collecting parameter bytes. Tell the M7 so it can send
+        // the failure byte, then revert to listening for a command.
+        frameLen = DC_FRAME_TIMEOUT;
+        frameN = 0;
+        emit_frame();
+      }
+      break;
+    }
+
+    case FramerState::Passthrough: {
+      if (shm->cmd_done_seq != passthroughSeq) {
+        // The M7 finished the streaming command; whatever follows is the next
+        // command byte.
+        framerState = FramerState::WaitingForCommand;
+        break;
+      }
+      int b;
+      while (shm->payload_ring.free_space() > 0 && (b = shm->usb_rx.read()) >= 0) {
+        shm->payload_ring.write((uint8_t)b);
+      }
+      break;
+    }
+  }
+}
+
+#endif // CORE_CM4
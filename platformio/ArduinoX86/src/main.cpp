@@ -28,6 +28,7 @@
 
 
 #include <Arduino.h>
+#include <cstddef>
 #include <cstdint>
 
 #include "arduinoX86.h"
@@ -40,11 +41,21 @@
 #include <bus_emulator/BusEmulator.h>
 #include <CommandServer.h>
 #include <CycleStateLogger.h>
+#include <ConfigProfile.h>
+#include <CpuIdCache.h>
+#include <ReadyTimer.h>
+#include <PinInjector.h>
+#include <FpuStub.h>
+#include <RefreshGenerator.h>
 
 #ifdef GIGA_DISPLAY_SHIELD
 #include "Arduino_GigaDisplay_GFX.h"
 #include "GigaDisplay.h"
-#endif 
+#endif
+
+#if defined(ARDUINO_GIGA) && USE_WATCHDOG
+#include <drivers/Watchdog.h>
+#endif
 
 #include <programs.h>
 
@@ -110,6 +121,11 @@ uint8_t NMI_STACK_BUFFER[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
+// Persistent CPU identification cache. .noinit keeps the contents across warm
+// resets; on cores whose linker script drops or zeroes the section the
+// magic/checksum test fails and we simply re-detect every boot, as before.
+static CpuIdCache CPU_ID_CACHE __attribute__((section(".noinit")));
+
 // Specialize BoardType for the chosen ShieldType
 using BoardType = BoardTypeBase<ShieldType>;
 
@@ -129,6 +145,10 @@ namespace ArduinoX86 {
 bool screen_initialized = false;
 bool screen_init_requested = false;
 
+// Set while the free-run turbo clock is engaged: a hardware timer drives CLK
+// and bus cycles are frozen with wait states by the ALE interrupt.
+bool free_run_engaged = false;
+
 //GigaDisplay_GFX display;
 //GigaDisplay screen_impl(display);
 
@@ -141,6 +161,12 @@ void setup() {
   while (!INBAND_SERIAL)
     ;
 
+#if TRACE_SERIAL_DEDICATED
+  // Bring up the dedicated trace channel. No wait: the host only opens this
+  // port when it wants to stream traces.
+  TRACE_SERIAL.begin(BAUD_RATE);
+#endif
+
   // Board initialization sets up the debug serial port.
   Board.init();
 
@@ -151,7 +177,7 @@ void setup() {
 
   // Initialize the bus emulator
   if (ArduinoX86::Bus == nullptr) {
-    ArduinoX86::Bus = new BusEmulator(new HashBackend());
+    ArduinoX86::Bus = create_bus_emulator();
     if (ArduinoX86::Bus == nullptr) {
       Board.debugPrintln(DebugType::SETUP, "Failed to create bus emulator!");
       set_error("Failed to create bus emulator!");
@@ -179,6 +205,16 @@ void setup() {
   Board.debugPrintln(DebugType::SETUP, "Running on Arduino Giga...");
 #endif
 
+#if USE_DUAL_CORE && defined(CORE_CM7)
+  // Boot the M4 protocol front end and bring up the shared-memory rings.
+  if (dual_core_init()) {
+    Board.debugPrintln(DebugType::SETUP, "M4 protocol front end is up.");
+  }
+  else {
+    Board.debugPrintln(DebugType::SETUP, "M4 protocol front end did not respond! Is the M4 image flashed?");
+  }
+#endif
+
   //i8288_status();
 
 #if HAT_8087_V1
@@ -219,6 +255,30 @@ void setup() {
 
   //screen->init();
   //beep(100);
+
+#if defined(ARDUINO_GIGA) && USE_WATCHDOG
+  // Last-resort recovery for headless rigs: if the main loop ever wedges,
+  // the IWDG resets the MCU. Session-preserving recovery from a wedged
+  // target CPU is handled by the Execute cycle budget in loop().
+  mbed::Watchdog::get_instance().start(WATCHDOG_TIMEOUT_MS);
+  Board.debugPrintln(DebugType::SETUP, "Hardware watchdog started.");
+#endif
+
+  // Apply the default configuration profile, if one is stored: the rig is
+  // then fully configured before the first command arrives, and comes back
+  // from watchdog resets the same way (see ConfigProfile.h).
+  {
+    ConfigProfileData profile;
+    if (config_profile_load(0, profile)) {
+      if (ArduinoX86::Server.apply_profile(profile)) {
+        Board.debugPrintln(DebugType::SETUP, "Applied default configuration profile.");
+      }
+      else {
+        Board.debugPrintln(DebugType::SETUP, "Default configuration profile did not apply cleanly!");
+      }
+    }
+  }
+
   Board.debugPrintln(DebugType::SETUP, "Arduino8088 Server Initialized! Waiting for commands...");
 }
 
@@ -263,6 +323,21 @@ bool cpu_id() {
 #endif
   
 
+  // Warm-reset fast path: reuse identification results cached by a previous
+  // boot. The ID program costs hundreds of bit-banged clock cycles, and the
+  // chip in the socket does not change between the thousands of resets of a
+  // test run. A chip swap is signalled by bumping the socket generation
+  // counter, which invalidates the cache.
+  if (cpu_id_cache_valid(CPU_ID_CACHE)) {
+    CPU.cpu_type = static_cast<CpuType>(CPU_ID_CACHE.cpu_type);
+    CPU.fpu_type = static_cast<FpuType>(CPU_ID_CACHE.fpu_type);
+    CPU.width    = static_cast<CpuBusWidth>(CPU_ID_CACHE.width);
+    Board.debugPrint(DebugType::ID, "cpu_id(): Using cached CPU: ");
+    Board.debugPrintln(DebugType::ID, CPU_TYPE_STRINGS[static_cast<size_t>(CPU.cpu_type)]);
+    ArduinoX86::Bus->set_cpu_type(CPU.cpu_type);
+    return true;
+  }
+
   ArduinoX86::Server.change_state(ServerState::CpuId);
   uint32_t timeout = 0;
   while (ArduinoX86::Server.state() != ServerState::Load) {
@@ -283,11 +358,32 @@ bool cpu_id() {
     Board.debugPrintln(DebugType::ID, "Bad CPU type!");
     return false;
   }
-  
+
   ArduinoX86::Bus->set_cpu_type(CPU.cpu_type);
+
+  // Cache the results for the next warm reset. The generation field carries
+  // whatever the host last set (or noinit garbage on first cold boot, which
+  // is fine: the host compares by setting its own value, not by reading).
+  CPU_ID_CACHE.magic    = CPU_ID_CACHE_MAGIC;
+  CPU_ID_CACHE.cpu_type = static_cast<uint8_t>(CPU.cpu_type);
+  CPU_ID_CACHE.fpu_type = static_cast<uint8_t>(CPU.fpu_type);
+  CPU_ID_CACHE.width    = static_cast<uint8_t>(CPU.width);
+  CPU_ID_CACHE.checksum = cpu_id_cache_sum(CPU_ID_CACHE);
   return true;
 }
 
+// Set the host's socket generation counter. A changed value invalidates the
+// CPU identification cache and re-runs identification immediately, forcing
+// re-detection after a chip swap without waiting for a cold boot.
+bool cpu_id_set_generation(uint32_t generation) {
+  if (cpu_id_cache_valid(CPU_ID_CACHE) && (CPU_ID_CACHE.generation == generation)) {
+    return true; // Same socket generation; the cache stays valid.
+  }
+  cpu_id_cache_invalidate(CPU_ID_CACHE);
+  CPU_ID_CACHE.generation = generation;
+  return cpu_id();
+}
+
 uint32_t calc_flat_address(uint16_t seg, uint16_t offset) {
   return ((uint32_t)seg << 4) + offset;
 }
@@ -333,24 +429,67 @@ void patch_vector_pgm(uint8_t *pgm, uint16_t seg, size_t offset) {
   *((uint16_t *)&pgm[offset]) = seg;
 }
 
+// Patch table for the register load program: each entry pairs a fixed program
+// offset with the matching field offset in registers1_t. The offsets never
+// change, so they are validated against the program length once and every
+// subsequent Load is just a handful of halfword stores into the resident
+// program buffer. Load runs thousands of times per farm-hour; per-field
+// bounds-checked calls were pure overhead.
+struct LoadPatchEntry {
+  uint8_t pgm_offset; // Offset of the immediate in the load program
+  uint8_t reg_offset; // Offset of the field in registers1_t
+};
+
+static const LoadPatchEntry LOAD_PATCH_TABLE[] = {
+  { 0,       offsetof(registers1_t, flags) },
+  { LOAD_BX, offsetof(registers1_t, bx) },
+  { LOAD_CX, offsetof(registers1_t, cx) },
+  { LOAD_DX, offsetof(registers1_t, dx) },
+  { LOAD_SS, offsetof(registers1_t, ss) },
+  { LOAD_DS, offsetof(registers1_t, ds) },
+  { LOAD_ES, offsetof(registers1_t, es) },
+  { LOAD_SP, offsetof(registers1_t, sp) },
+  { LOAD_BP, offsetof(registers1_t, bp) },
+  { LOAD_SI, offsetof(registers1_t, si) },
+  { LOAD_DI, offsetof(registers1_t, di) },
+  { LOAD_AX, offsetof(registers1_t, ax) },
+  { LOAD_IP, offsetof(registers1_t, ip) },
+  { LOAD_CS, offsetof(registers1_t, cs) },
+};
+
 void patch_load_pgm(InlineProgram *pgm, volatile registers1_t *reg) {
-  pgm->write_u16_at(0, reg->flags);
-  pgm->write_u16_at(LOAD_BX, reg->bx);
-  pgm->write_u16_at(LOAD_CX, reg->cx);
-  pgm->write_u16_at(LOAD_DX, reg->dx);
-  pgm->write_u16_at(LOAD_SS, reg->ss);
-  pgm->write_u16_at(LOAD_DS, reg->ds);
-  pgm->write_u16_at(LOAD_ES, reg->es);
-  pgm->write_u16_at(LOAD_SP, reg->sp);
-  pgm->write_u16_at(LOAD_BP, reg->bp);
-  pgm->write_u16_at(LOAD_SI, reg->si);
-  pgm->write_u16_at(LOAD_DI, reg->di);
-  pgm->write_u16_at(LOAD_AX, reg->ax);
-  pgm->write_u16_at(LOAD_IP, reg->ip);
-  pgm->write_u16_at(LOAD_CS, reg->cs);
+  static bool offsets_checked = false;
+  if (!offsets_checked) {
+    for (const LoadPatchEntry &e : LOAD_PATCH_TABLE) {
+      if ((size_t)e.pgm_offset + 1 >= pgm->len()) {
+        Board.debugPrintln(DebugType::ERROR, "## patch_load_pgm(): patch offset out of bounds! ##");
+        return;
+      }
+    }
+    offsets_checked = true;
+  }
+
+  uint8_t *buf = pgm->data();
+  const volatile uint8_t *reg_bytes = reinterpret_cast<const volatile uint8_t *>(reg);
+  for (const LoadPatchEntry &e : LOAD_PATCH_TABLE) {
+    // registers1_t is packed; assemble the halfword from bytes.
+    uint16_t value = (uint16_t)reg_bytes[e.reg_offset]
+                   | ((uint16_t)reg_bytes[e.reg_offset + 1] << 8);
+    buf[e.pgm_offset] = (uint8_t)value;
+    buf[e.pgm_offset + 1] = (uint8_t)(value >> 8);
+  }
 }
 
 void patch_brkem_pgm(InlineProgram *pgm, volatile registers1_t *regs) {
+  // The BRKEM vector image depends only on CS:IP, and emulation suites reuse
+  // the same code segment shape across thousands of loads. Cache the last
+  // patched pair so repeat loads cost a compare instead of buffer writes.
+  static uint16_t patched_ip = 0;
+  static uint16_t patched_cs = 0;
+  static bool patched_once = false;
+  if (patched_once && (regs->ip == patched_ip) && (regs->cs == patched_cs)) {
+    return;
+  }
 #if DEBUG_EMU
   static char buf[20];
   DEBUG_SERIAL.println("## Patching BRKEM program ##");
@@ -362,6 +501,9 @@ void patch_brkem_pgm(InlineProgram *pgm, volatile registers1_t *regs) {
 #endif
   pgm->write_u16_at(0, regs->ip);
   pgm->write_u16_at(2, regs->cs);
+  patched_ip = regs->ip;
+  patched_cs = regs->cs;
+  patched_once = true;
 }
 
 // Fix up the old-style inline regs by swapping fields.
@@ -425,6 +567,51 @@ void print_registers(registers1_t *regs) {
   DEBUG_SERIAL.println(flag_buf);
 }
 
+void print_cpu_state();
+
+// Emit the per-cycle trace. With FLAG_TRACE_BINARY set, the formatted text
+// path is skipped in favor of one binary record per cycle: the cycle state
+// the logger already captures plus queue/opcode metadata, fetched after the
+// run with CmdGetTraceMeta and formatted host-side. On-device formatting
+// made traced runs roughly 10x slower than untraced, distorting
+// timing-sensitive investigations.
+void trace_cpu_state() {
+  if (ArduinoX86::Server.get_flags() & CommandServer<BoardType, ShieldType>::FLAG_TRACE_BINARY) {
+    CycleTraceMeta meta;
+    meta.server_state = static_cast<uint8_t>(ArduinoX86::Server.state());
+    meta.queue_len = CPU.queue.len();
+    meta.queue_byte = CPU.qb;
+    meta.opcode = CPU.opcode;
+
+    CycleState state;
+    state.address_bus = CPU.address_bus;
+    state.data_bus = CPU.data_bus;
+    state.cpu_state = static_cast<uint8_t>(CPU.bus_cycle);
+    state.cpu_status0 = CPU.status0;
+    state.bus_control_bits = Controller.readBusControllerControlLines();
+    state.bus_command_bits = CPU.command_bits;
+    state.pins = 0;
+    if (Controller.readALEPin()) {
+      state.pins |= CycleState::ALE;
+    }
+    if (Controller.readBHEPin()) {
+      state.pins |= CycleState::BHE;
+    }
+    if (Controller.readLockPin()) {
+      state.pins |= CycleState::LOCK;
+    }
+    if (Controller.readReadyPin()) {
+      state.pins |= CycleState::READY;
+    }
+    if (refresh_gen_state & REFRESH_GEN_HOLDING) {
+      state.pins |= CycleState::HOLD;
+    }
+    ArduinoX86::CycleLogger->log_trace(state, meta);
+    return;
+  }
+  print_cpu_state();
+}
+
 void print_cpu_state() {
   const size_t buf_len = 90;
   static char buf[buf_len];
@@ -725,8 +912,364 @@ void set_data_bus_width() {
   }
 }
 
+/// @brief Return true if the current server state can run with a free-running
+/// hardware clock. These are phases where we only need to service whole bus
+/// cycles and never inspect individual clock cycles.
+bool free_run_state_ok() {
+  switch (ArduinoX86::Server.state()) {
+    case ServerState::JumpVector:
+    case ServerState::Load:
+    case ServerState::LoadSmm:
+      return true;
+    case ServerState::Store:
+    case ServerState::StoreAll:
+      // Store-program PC fixups on queue flush need per-clock queue status,
+      // so only free-run the store phases when the queue isn't being tracked.
+      return !CPU.have_queue_status;
+    default:
+      return false;
+  }
+}
+
+/// @brief Engage or disengage the free-run turbo clock to match the server
+/// state. While engaged, CLK is generated by a hardware timer and the ALE
+/// interrupt freezes each bus cycle with wait states until service_free_run()
+/// has handled it. Register load/store runs at FREE_RUN_CLOCK_HZ this way
+/// instead of the (much slower) bit-banged clock.
+void update_free_run_clock() {
+  bool want = (ArduinoX86::Server.get_flags() & CommandServer<BoardType, ShieldType>::FLAG_FREE_RUN_CLOCK) &&
+              free_run_state_ok();
+
+  if (want && !free_run_engaged) {
+    free_run_cycle_pending = false;
+    attachInterrupt(digitalPinToInterrupt(ALE_PIN), free_run_ale_handler, ALE_TRIGGER);
+    if (Controller.startFreeRunClock(FREE_RUN_CLOCK_HZ)) {
+      Controller.getBoard().debugPrintln(DebugType::STATE, "## FREERUN: Hardware clock engaged");
+      free_run_engaged = true;
+    }
+    else {
+      // No hardware timer on this platform; keep bit-banging.
+      detachInterrupt(digitalPinToInterrupt(ALE_PIN));
+    }
+  }
+  else if (!want && free_run_engaged) {
+    // Service any bus cycle frozen by the ALE interrupt before handing the
+    // clock back to tickCpu().
+    service_free_run();
+    Controller.stopFreeRunClock();
+    detachInterrupt(digitalPinToInterrupt(ALE_PIN));
+    WRITE_READY_PIN(READY_ASSERT);
+    free_run_engaged = false;
+    Controller.getBoard().debugPrintln(DebugType::STATE, "## FREERUN: Hardware clock disengaged");
+  }
+}
+
+/// @brief Dispatch the state handler for a frozen free-run bus cycle.
+/// Only states that are serviceable per bus cycle appear here;
+/// update_free_run_clock() never engages free-run outside of them.
+void dispatch_free_run_state() {
+  switch (ArduinoX86::Server.state()) {
+    case ServerState::JumpVector:
+      handle_jump_vector_state(QUEUE_IDLE);
+      break;
+    case ServerState::Load:
+      if (ShieldTraits<ShieldType>::kSupportsLoadall286 && (CPU.cpu_type == CpuType::i80286)) {
+        handle_loadall_286();
+      }
+      else if (ShieldTraits<ShieldType>::kSupportsSmm386 && (CPU.cpu_type == CpuType::i80386)) {
+        handle_loadall_386();
+      }
+      else {
+        handle_load_state(QUEUE_IDLE);
+      }
+      break;
+    case ServerState::LoadSmm:
+      if (ShieldTraits<ShieldType>::kSupportsSmm386) {
+        handle_smm_load_386();
+      }
+      break;
+    case ServerState::Store:
+      handle_store_state();
+      break;
+    case ServerState::StoreAll:
+      if (ShieldTraits<ShieldType>::kSupportsLoadall286 && (CPU.cpu_type == CpuType::i80286)) {
+        handle_storeall_286();
+      }
+      else if (ShieldTraits<ShieldType>::kSupportsSmm386 && (CPU.cpu_type == CpuType::i80386)) {
+        handle_smm_store_386();
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/// @brief Service one bus cycle frozen by free_run_ale_handler().
+/// The interrupt latched the port snapshot at T1, so address and status
+/// decode from it as usual. We rebuild the same per-bus-cycle context the
+/// state handlers see from cycle(), let them feed or capture the data bus,
+/// then re-assert READY to release the CPU.
+void service_free_run() {
+  if (!free_run_cycle_pending) {
+    return;
+  }
+
+  // Decode the T1 snapshot captured by the interrupt handler.
+  CPU.status0 = Controller.readCpuStatusLines();
+  CPU.bus_state = Controller.decodeBusStatus(CPU.status0);
+  CPU.last_address_bus = CPU.address_bus;
+  CPU.address_bus = Controller.readAddressBus(true);
+  CPU.bus_cycle = T1;
+  CPU.latch_address(CPU.address_bus);
+  set_data_bus_width();
+  CPU.bus_state_latched = CPU.bus_state;
+  CPU.data_bus_resolved = false;
+
+  // First pass against the T1 snapshot so ALE-based transition checks fire.
+  dispatch_free_run_state();
+
+  // The CPU is held in wait states now, so the command lines are active.
+  // Recapture pin state and let the handler feed or capture the data bus.
+  // data_bus_resolved keeps the handlers from feeding the same cycle twice.
+  Controller.captureSnapshot();
+  CPU.bus_cycle = WRITE_CYCLE;
+  dispatch_free_run_state();
+
+  // Release the CPU to finish the bus cycle. With a wait-state window
+  // programmed (CmdSetReadyTimer), the release is produced by the hardware
+  // timer armed at the ALE edge, so the cycle sees an exact number of
+  // wait states no matter how long servicing took.
+  free_run_cycle_pending = false;
+  if (!ready_timer_release()) {
+    WRITE_READY_PIN(READY_ASSERT);
+  }
+}
+
+// Common per-cycle queue pre-work, shared by every server state. Forced
+// inline so factoring it out of cycle() costs nothing per tick.
+static inline void cycle_queue_prologue(uint8_t q) __attribute__((always_inline));
+static inline void cycle_queue_prologue(uint8_t q) {
+  if (CPU.have_queue_status) {
+    // One indexed load decodes the QS0/QS1 pair into packed action bits; see
+    // QUEUE_ACTIONS in arduinoX86.h.
+    const uint8_t qa = QUEUE_ACTIONS[q & 0x03];
+    if (qa & QA_POP) {
+      // We fetched a byte from queue last cycle
+      if (CPU.queue.len() > 0) {
+        CPU.queue.pop(&CPU.qb, &CPU.qt);
+        if (qa & QA_FIRST) {
+          // Set flag for first instruction byte fetched
+          CPU.q_ff = true;
+          CPU.q_fn = 0;  // First byte of instruction
+          CPU.opcode = CPU.qb;
+          // An ESC opcode starts the FPU stub's BUSY window on the TEST pin.
+          if (fpu_stub_enabled && IS_ESC_OP(CPU.opcode)) {
+            fpu_stub_on_esc();
+          }
+          // Mnemonic resolution is string-table work the cycle path doesn't
+          // need; builds that strip INSTR output compile it away entirely
+          // and classification stays a single attribute-table load.
+          if (debug_type_compiled(DebugType::INSTR)) {
+            CPU.mnemonic = get_opcode_str(CPU.opcode, 0, false);
+
+            if (!IS_GRP_OP(CPU.opcode)) {
+              Controller.getBoard().debugPrintf(DebugType::INSTR, false, "## INST: %s ##\n\r", CPU.mnemonic);
+            } else {
+              Controller.getBoard().debugPrintln(DebugType::INSTR, "## INST: Decoding GRP... ##");
+            }
+          }
+
+        }
+        else {
+          if (IS_GRP_OP(CPU.opcode) && (CPU.q_fn == 1) && debug_type_compiled(DebugType::INSTR)) {
+            CPU.mnemonic = get_opcode_str(CPU.opcode, CPU.qb, true);
+            Controller.getBoard().debugPrintf(DebugType::INSTR, false, "## INST: %s ##\n\r", CPU.mnemonic);
+          }
+          // Subsequent byte of instruction fetched
+          CPU.q_fn++;
+        }
+      } 
+      else {
+        // Queue read while queue empty? Bad condition.
+        if (ArduinoX86::Server.state() != ServerState::Reset) {
+          // Sometimes we get a spurious queue read signal in Reset.
+          // We can safely ignore any queue reads during the Reset state.
+          Controller.getBoard().debugPrintln(DebugType::ERROR, "## Error: Invalid Queue Length-- ##");
+        }
+      }
+    }
+    else if (qa & QA_FLUSH) {
+      // Queue was flushed last cycle.
+
+      // Warn if queue is flushed during CODE cycle.
+      if (CPU.bus_state_latched == CODE) {
+        const char *t_cycle_str = Controller.getTCycleString(CPU.bus_cycle);
+        Controller.getBoard().debugPrintf(DebugType::ERROR, "## FLUSH during CODE fetch! t-state: %s ##\n\r", t_cycle_str);
+      }
+
+      // The queue is flushed once during store program, so we need to adjust s_pc
+      // by the length of the queue when it was flushed or else we'll skip bytes
+      // of the store program.
+      if (CPU.s_pc > 0) {
+
+        if (CPU.s_pc < 4) {
+          Controller.getBoard().debugPrintln(DebugType::STORE, "## FLUSHed STORE bytes (early): Reset s_pc ##");
+          CPU.s_pc = 0;
+        } else if (CPU.s_pc >= CPU.queue.len()) {
+          uint16_t pc_adjust = (uint16_t)CPU.queue.len();
+
+          if ((pc_adjust & 1) && (CPU.width == CpuBusWidth::Sixteen)) {
+            // If we have an odd queue length and 16-bit fetches, account for one more byte
+            //pc_adjust++;
+          }
+          CPU.s_pc -= pc_adjust;
+          Controller.getBoard().debugPrintf(DebugType::STORE, false, "## FLUSHed STORE bytes: Adjusted s_pc by: %d new s_pc: %d ##\n\r", pc_adjust, CPU.s_pc);
+        } else {
+          Controller.getBoard().debugPrintln(DebugType::STORE, "## FLUSHed STORE bytes: Reset s_pc on flush");
+        }
+      }
+
+      CPU.queue.flush();
+      Controller.getBoard().debugPrintf(DebugType::QUEUE, false, "## Queue Flushed, new PC: %04X ##\n\r", CPU.v_pc);
+    }
+  }
+}
+
+// Per-state dispatch for the cycle() state machine. The handlers below adapt
+// the existing handle_*_state functions to a single signature so cycle() can
+// reach the current state's handler with one indirect call instead of
+// re-evaluating a 20-way switch every clock tick. The table is indexed by the
+// ServerState enum value, so the entries must stay in enum order.
+typedef void (*StateHandler)(uint8_t q);
+
+// States with no per-cycle work: Reset, Prefetch, StoreDone, Done, etc.
+static void state_idle(uint8_t) {}
+
+static void state_cpuid(uint8_t q) { handle_cpuid_state(q); }
+static void state_cpu_setup(uint8_t) { handle_cpu_setup_state(); }
+static void state_jump_vector(uint8_t q) { handle_jump_vector_state(q); }
+
+// The ShieldTraits capability constants are compile-time false for CPU
+// families the selected shield cannot carry, so those branches (and the
+// handlers behind them) drop out of per-CPU builds entirely.
+static void state_load(uint8_t q) {
+  if (ShieldTraits<ShieldType>::kSupportsLoadall286 && (CPU.cpu_type == CpuType::i80286)) {
+    // 286 just uses LOADALL instead of a load program.
+    handle_loadall_286();
+  }
+  else if (ShieldTraits<ShieldType>::kSupportsSmm386 && (CPU.cpu_type == CpuType::i80386)) {
+    handle_loadall_386();
+  }
+  else {
+    handle_load_state(q);
+  }
+}
+
+static void state_load_smm(uint8_t) {
+  if (ShieldTraits<ShieldType>::kSupportsSmm386) {
+    handle_smm_load_386();
+  }
+}
+
+// LoadDone is triggered by the queue flush following the jump in Load.
+// We wait for the next ALE and begin Execute.
+static void state_load_done(uint8_t) { handle_load_done_state(); }
+
+// We are executing the BRKEM routine (NEC V20/V30 only).
+static void state_emu_enter(uint8_t q) {
+  if (ShieldTraits<ShieldType>::kSupportsEmulation) {
+    handle_emu_enter_state(q);
+  }
+}
+
+// Unlike in run_program, the Execute state in cpu_server is entirely interactive based on
+// commands from the client.
+// This is to support interception of memory reads & writes as instructions execute and to allow
+// the client to query CPU state as it wishes per cpu cycle.
+// When done in the Execute state, a cpu client can end execution by:
+//  - Executing an ExecuteFinalize command.
+//    This is typically done when a CODE fetch occurs past the end of the provided program, although
+//    other end conditions are possible.
+//  - Executing a HALT
+//  - Asserting NMI before the end of the instruction
+static void state_execute(uint8_t) {
+  if (ArduinoX86::Server.get_flags() & CommandServer<BoardType, ShieldType>::FLAG_EXECUTE_AUTOMATIC) {
+    handle_execute_automatic();
+  }
+  else {
+    handle_execute_state();
+  }
+}
+
+// Since Execute is an interactive state where the client controls the cpu_server, we need to be able
+// to transition safely from Execute to Store.
+// ExecuteFinalize state feeds the CPU STORE program bytes flagged with DATA_PROGRAM_END and
+// transitions to Store when one of those bytes is fetched as the first byte of an instruction.
+//
+// If NMI is high during ExecuteFinalize, reading the NMI vector completely will reset the store program
+// PC and also transition to ExecuteDone. This is the newer method of ending program execution that
+// supports the 80186 without queue status lines.
+static void state_execute_finalize(uint8_t) { handle_execute_finalize_state(); }
+
+static void state_execute_done(uint8_t) { handle_execute_done_state(); }
+static void state_emu_exit(uint8_t) {
+  if (ShieldTraits<ShieldType>::kSupportsEmulation) {
+    handle_emu_exit_state();
+  }
+}
+static void state_store(uint8_t) { handle_store_state(); }
+
+static void state_storeall(uint8_t) {
+  if (ShieldTraits<ShieldType>::kSupportsLoadall286 && (CPU.cpu_type == CpuType::i80286)) {
+    handle_storeall_286();
+  } else if (ShieldTraits<ShieldType>::kSupportsSmm386 && (CPU.cpu_type == CpuType::i80386)) {
+    handle_smm_store_386();
+  } else {
+    ArduinoX86::Server.change_state(ServerState::Error);
+    set_error("StoreAll not implemented for this CPU type!");
+  }
+}
+
+static void state_error(uint8_t) {
+  if (CPU.error_cycle_ct < MAX_ERROR_CYCLES) {
+    CPU.error_cycle_ct++;
+  }
+}
+
+static const StateHandler STATE_HANDLERS[] = {
+  state_idle,             // Reset
+  state_cpuid,            // CpuId
+  state_cpu_setup,        // CpuSetup
+  state_jump_vector,      // JumpVector
+  state_load,             // Load
+  state_load_smm,         // LoadSmm
+  state_load_done,        // LoadDone
+  state_emu_enter,        // EmuEnter
+  state_idle,             // Prefetch (placeholder)
+  state_execute,          // Execute
+  state_execute_finalize, // ExecuteFinalize
+  state_execute_done,     // ExecuteDone
+  state_emu_exit,         // EmuExit
+  state_store,            // Store
+  state_idle,             // StoreDone
+  state_idle,             // StoreDoneSmm
+  state_idle,             // Done
+  state_storeall,         // StoreAll
+  state_error,            // Shutdown
+  state_error,            // Error
+};
+
 void cycle() {
 
+  // In free-run turbo mode a hardware timer drives CLK and we only service
+  // whole bus cycles frozen by the ALE interrupt, so there is no per-clock
+  // work to do here.
+  update_free_run_clock();
+  if (free_run_engaged) {
+    service_free_run();
+    return;
+  }
+
   // Resolve data bus from last cycle.
   if (!CPU.data_bus_resolved && (!Controller.readMRDCPin() || !Controller.readIORCPin())) {
     //Controller.getBoard().debugPrintln(DebugType::BUS, "## Resolving data bus ##");
@@ -737,6 +1280,26 @@ void cycle() {
   Controller.tickCpu();
   CPU.tick();
 
+  // Fire any cycle-scheduled pin injections before this cycle's pin state is
+  // sampled, so an assert at cycle N is what the CPU sees at clock N.
+  if (pin_inject_armed) {
+    pin_inject_service(CPU.cycle_ct());
+  }
+
+  // Count down the FPU stub's BUSY window, releasing the TEST pin at expiry.
+  if (fpu_stub_enabled) {
+    fpu_stub_service();
+  }
+
+  // Advance the DRAM-refresh HOLD cadence.
+  if (refresh_gen_state) {
+    refresh_gen_service();
+  }
+
+  // Sample all GPIO input ports once at the clock edge. The decode calls
+  // below extract their fields from this snapshot.
+  Controller.captureSnapshot();
+
   CPU.cpuid_counter++;
 
   // Read the CPU status pins
@@ -768,6 +1331,14 @@ void cycle() {
     //Controller.getBoard().debugPrintln(DebugType::BUS, "## Wait state cleared ##");
   }
 
+  if (CPU.wait_states_active > 0) {
+    // A region wait profile is holding READY low; release it once the
+    // programmed number of wait states has elapsed.
+    if (--CPU.wait_states_active == 0) {
+      WRITE_READY_PIN(READY_ASSERT);
+    }
+  }
+
   // Check for CPU shutdown.
   if ((CPU.bus_state == HALT) && (CPU.address_bus == 0x000000) && (!CPU.is_shutdown())) {
     CPU.set_shutdown();
@@ -791,6 +1362,17 @@ void cycle() {
     CPU.bus_state_latched = CPU.bus_state;
     CPU.data_bus_resolved = false;
 
+    // For automatic-execution memory reads, launch the backend lookup now:
+    // the address and BHE are known at ALE, but the data bus isn't driven
+    // until two T-states later, so the hash-probe latency hides inside the
+    // T1-T3 window. handle_execute_automatic() consumes the speculated word
+    // in mem_read_bus(); an intervening write discards it.
+    if ((ArduinoX86::Server.get_state() == ServerState::Execute) &&
+        ArduinoX86::Server.is_execute_automatic() &&
+        ((CPU.bus_state_latched == CODE) || (CPU.bus_state_latched == MEMR))) {
+      ArduinoX86::Bus->mem_speculate(CPU.address_latch(), !Controller.readBHEPin());
+    }
+
 #if defined(CPU_286)
     // Test for a missed bus cycle (occasionally happens on 286)
     // This is the case if the last bus cycle was Ti, and had the previous address on the bus,
@@ -832,78 +1414,7 @@ void cycle() {
   cycle_state.cpu_state = static_cast<uint8_t>(CPU.bus_cycle);
 
   // Handle queue activity
-  if (CPU.have_queue_status) {
-    if ((q == QUEUE_FIRST) || (q == QUEUE_SUBSEQUENT)) {
-      // We fetched a byte from queue last cycle
-      if (CPU.queue.len() > 0) {
-        CPU.queue.pop(&CPU.qb, &CPU.qt);
-        if (q == QUEUE_FIRST) {
-          // Set flag for first instruction byte fetched
-          CPU.q_ff = true;
-          CPU.q_fn = 0;  // First byte of instruction
-          CPU.opcode = CPU.qb;
-          CPU.mnemonic = get_opcode_str(CPU.opcode, 0, false);
- 
-          if (!IS_GRP_OP(CPU.opcode)) {
-            Controller.getBoard().debugPrintf(DebugType::INSTR, false, "## INST: %s ##\n\r", CPU.mnemonic);
-          } else {
-            Controller.getBoard().debugPrintln(DebugType::INSTR, "## INST: Decoding GRP... ##");
-          }
-
-        } 
-        else {
-          if (IS_GRP_OP(CPU.opcode) && CPU.q_fn == 1) {
-            CPU.mnemonic = get_opcode_str(CPU.opcode, CPU.qb, true);
-            Controller.getBoard().debugPrintf(DebugType::INSTR, false, "## INST: %s ##\n\r", CPU.mnemonic);
-          }
-          // Subsequent byte of instruction fetched
-          CPU.q_fn++;
-        }
-      } 
-      else {
-        // Queue read while queue empty? Bad condition.
-        if (ArduinoX86::Server.state() != ServerState::Reset) {
-          // Sometimes we get a spurious queue read signal in Reset.
-          // We can safely ignore any queue reads during the Reset state.
-          Controller.getBoard().debugPrintln(DebugType::ERROR, "## Error: Invalid Queue Length-- ##");
-        }
-      }
-    } 
-    else if (q == QUEUE_FLUSHED) {
-      // Queue was flushed last cycle.
-
-      // Warn if queue is flushed during CODE cycle.
-      if (CPU.bus_state_latched == CODE) {
-        const char *t_cycle_str = Controller.getTCycleString(CPU.bus_cycle);
-        Controller.getBoard().debugPrintf(DebugType::ERROR, "## FLUSH during CODE fetch! t-state: %s ##\n\r", t_cycle_str);
-      }
-
-      // The queue is flushed once during store program, so we need to adjust s_pc
-      // by the length of the queue when it was flushed or else we'll skip bytes
-      // of the store program.
-      if (CPU.s_pc > 0) {
-
-        if (CPU.s_pc < 4) {
-          Controller.getBoard().debugPrintln(DebugType::STORE, "## FLUSHed STORE bytes (early): Reset s_pc ##");
-          CPU.s_pc = 0;
-        } else if (CPU.s_pc >= CPU.queue.len()) {
-          uint16_t pc_adjust = (uint16_t)CPU.queue.len();
-
-          if ((pc_adjust & 1) && (CPU.width == CpuBusWidth::Sixteen)) {
-            // If we have an odd queue length and 16-bit fetches, account for one more byte
-            //pc_adjust++;
-          }
-          CPU.s_pc -= pc_adjust;
-          Controller.getBoard().debugPrintf(DebugType::STORE, false, "## FLUSHed STORE bytes: Adjusted s_pc by: %d new s_pc: %d ##\n\r", pc_adjust, CPU.s_pc);
-        } else {
-          Controller.getBoard().debugPrintln(DebugType::STORE, "## FLUSHed STORE bytes: Reset s_pc on flush");
-        }
-      }
-
-      CPU.queue.flush();
-      Controller.getBoard().debugPrintf(DebugType::QUEUE, false, "## Queue Flushed, new PC: %04X ##\n\r", CPU.v_pc);
-    }
-  }
+  cycle_queue_prologue(q);
 
   uint32_t run_address = 0;
 
@@ -912,315 +1423,66 @@ void cycle() {
     CPU.data_bus = Controller.readDataBus(CPU.data_width);
   }
 
-  // Handle state machine
-  switch (ArduinoX86::Server.state()) {
-
-    case ServerState::Reset:
-      // We are executing the CPU reset routine.
-      // Nothing to do here.
-      break;
-    case ServerState::CpuId:
-      // We are executing the CPU ID routine.
-      handle_cpuid_state(q);
-      break;
-
-    case ServerState::CpuSetup:
-      handle_cpu_setup_state();
-      break;
-
-    case ServerState::JumpVector:
-      // We are executing the initial jump from the reset vector FFFF:0000.
-      // This is to avoid wrapping effective address during load procedure.
-      handle_jump_vector_state(q);
-      break;
-
-    case ServerState::Load:
-      // We are executing the register load routine.
-      if (CPU.cpu_type == CpuType::i80286) {
-        // 286 just uses LOADALL instead of a load program. 
-        handle_loadall_286();
-      } 
-      else if (CPU.cpu_type == CpuType::i80386) {
-        handle_loadall_386();
-      }
-      else {
-        handle_load_state(q);
-      }
-      break;
-
-    case ServerState::LoadSmm:
-
-      handle_smm_load_386();
-      break;
-
-    case ServerState::LoadDone:
-      // LoadDone is triggered by the queue flush following the jump in Load.
-      // We wait for the next ALE and begin Execute.
-      handle_load_done_state();
-      break;
-
-    case ServerState::Prefetch:
-      // We are executing the prefetch routine.
-      // Currently placeholder.
-      break;
-
-    case ServerState::EmuEnter:
-      // We are executing the BRKEM routine.
-      handle_emu_enter_state(q);
-      break;
-
-    // Unlike in run_program, the Execute state in cpu_server is entirely interactive based on
-    // commands from the client.
-    // This is to support interception of memory reads & writes as instructions execute and to allow
-    // the client to query CPU state as it wishes per cpu cycle.
-    // When done in the Execute state, a cpu client can end execution by:
-    //  - Executing an ExecuteFinalize command.
-    //    This is typically done when a CODE fetch occurs past the end of the provided program, although
-    //    other end conditions are possible.
-    //  - Executing a HALT
-    //  - Asserting NMI before the end of the instruction
-    case ServerState::Execute:
-      if (ArduinoX86::Server.get_flags() & CommandServer<BoardType, ShieldType>::FLAG_EXECUTE_AUTOMATIC) {
-        handle_execute_automatic();
-      }
-      else {
-        handle_execute_state();
-      }
-      break;
-
-    // Since Execute is an interactive state where the client controls the cpu_server, we need to be able
-    // to transition safely from Execute to Store.
-    // ExecuteFinalize state feeds the CPU STORE program bytes flagged with DATA_PROGRAM_END and
-    // transitions to Store when one of those bytes is fetched as the first byte of an instruction.
-    //
-    // If NMI is high during ExecuteFinalize, reading the NMI vector completely will reset the store program
-    // PC and also transition to ExecuteDone. This is the newer method of ending program execution that
-    // supports the 80186 without queue status lines.
-    case ServerState::ExecuteFinalize:
-
-      handle_execute_finalize_state();
-      break;
-
-    case ServerState::EmuExit:
-      if (!Controller.readMRDCPin()) {
-        // CPU is reading (MRDC active-low)
-        if ((CPU.bus_state_latched == CODE) && (CPU.bus_state == PASV)) {
-          // CPU is doing code fetch
-          if (CPU.s_pc < sizeof EMU_EXIT_PROGRAM) {
-            // Read code byte from EmuExit program
-            CPU.data_bus = EMU_EXIT_PROGRAM.read(CPU.address_latch(), CPU.data_width);
-            Controller.getBoard().debugPrint(DebugType::EMU, "## EMUEXIT: fetching byte: ");
-            Controller.getBoard().debugPrint(DebugType::EMU, CPU.data_bus, 16);
-            Controller.getBoard().debugPrint(DebugType::EMU, " new s_pc: ");
-            Controller.getBoard().debugPrintln(DebugType::EMU, CPU.s_pc);
-            CPU.data_type = QueueDataType::Program;
-          } else {
-            CPU.data_bus = OPCODE_DOUBLENOP;
-            CPU.data_type = QueueDataType::ProgramEnd;
-          }
-          Controller.writeDataBus(CPU.data_bus, CPU.data_width);
-        }
-
-        if ((CPU.bus_state_latched == MEMR) && (CPU.bus_state == PASV)) {
-          // CPU is doing memory read
-          // This will occur when RETEM pops IP, CS and Flags from the stack.
-
-          if (CPU.width == CpuBusWidth::Eight) {
-            // Stack values will be read in two operations
-            if (CPU.stack_r_op_ct == 0) {
-              // Skip
-            } 
-            else if (CPU.stack_r_op_ct == 1) {
-              // Skip
-            } 
-            else if (CPU.stack_r_op_ct == 2) {
-              Controller.getBoard().debugPrint(DebugType::EMU, "## Reading RETEM CS pop (1/2): ");
-              Controller.getBoard().debugPrintln(DebugType::EMU, CPU.load_regs.cs, 16);
-              // Write the low byte of CS to the data bus
-              data_bus_set_byte((uint8_t)(CPU.load_regs.cs));
-            } 
-            else if (CPU.stack_r_op_ct == 3) {
-              Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM CS pop (2/2)! ##");
-              Controller.getBoard().debugPrintln(DebugType::EMU, CPU.load_regs.cs, 16);
-              // Write the high byte of CS to the data bus
-              data_bus_set_byte((uint8_t)(CPU.load_regs.cs >> 8));
-            } 
-            else if (CPU.stack_r_op_ct == 4) {
-              Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM flag pop (1/2)! ##");
-              // Write the low byte of flags to the data bus
-              data_bus_set_byte((uint8_t)(CPU.pre_emu_flags));
-            } 
-            else if (CPU.stack_r_op_ct == 5) {
-              Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM flag pop (2/2)! ##");
-              // Write the high byte of flags to the data bus
-              data_bus_set_byte((uint8_t)(CPU.pre_emu_flags >> 8));
-              // Exit emulation mode
-              CPU.in_emulation = false;
-              ArduinoX86::Server.change_state(ServerState::ExecuteFinalize);
-            } else {
-              // Not flags, just write 0's so we jump back to CS:IP 0000:0000
-              CPU.data_bus = 0;
-            }
-            CPU.stack_r_op_ct++;
-          } else {
-            // Sixteen-bit data bus
-            if (CPU.stack_r_op_ct == 0) {
-              // IP is read in one operation
-              Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM IP pop! ##");
-              CPU.data_bus = 0;
-            } else if (CPU.stack_r_op_ct == 1) {
-              // CS is read in one operation
-              Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM CS pop! ##");
-              Controller.getBoard().debugPrintln(DebugType::EMU, CPU.load_regs.cs);
-              // We can restore CS from the loaded registers since CS cannot be modified in 8080 emulation mode
-              CPU.data_bus = CPU.load_regs.cs;
-            } else if (CPU.stack_r_op_ct == 2) {
-              // Flags will be read in one operation
-              Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM Flag pop! ##");
-              // CPU is writing to the data bus, latch value
-              CPU.data_bus = CPU.pre_emu_flags;
-              // Exit emulation mode
-              CPU.in_emulation = false;
-              ArduinoX86::Server.change_state(ServerState::ExecuteFinalize);
-            }
-            CPU.stack_r_op_ct++;
-          }
-          Controller.writeDataBus(CPU.data_bus, CPU.data_width);
-        }
-      }
-
-      if (!Controller.readMWTCPin() && (CPU.bus_state_latched == MEMW) && (CPU.bus_state == PASV)) {
-        // CPU is writing. This should only happen during EmuExit when we PUSH PSW
-        // to save the 8080 flags.
-        if (CPU.width == CpuBusWidth::Eight) {
-          // 8-bit data bus
-          if (CPU.stack_w_op_ct == 0) {
-            // Flags will be in first byte written (second byte will be AL)
-            Controller.getBoard().debugPrint(DebugType::EMU, "## Capturing PUSH PSW stack write! ##");
-            CPU.emu_flags = (uint8_t)CPU.data_bus;
-          }
-          CPU.stack_w_op_ct++;
-        } else {
-          // 16-bit data bus
-          if (CPU.stack_w_op_ct == 0) {
-            // Flags were pushed in one operation.
-            Controller.getBoard().debugPrintln(DebugType::EMU, "## Capturing PUSH PSW stack write! ##");
-            CPU.emu_flags = (uint8_t)CPU.data_bus;
-          }
-          CPU.stack_w_op_ct++;
-        }
-      }
-
-      break;
-
-    case ServerState::ExecuteDone:
-      // We sit in ExecuteDone state until the client requests a Store operation.
-      // The client should not cycle the CPU in this state.
-      if (!Controller.readMRDCPin() && CPU.bus_state == PASV) {
-        // CPU is reading (MRDC active-low)
-        Controller.writeDataBus(CPU.data_bus, CPU.data_width);
-
-        if ((CPU.bus_state_latched == CODE) && (CPU.prefetching_store)) {
-          // Since client does not cycle the CPU in this state, we have to fetch from
-          // STORE program ourselves
-          CPU.data_bus = CPU.program->read(CPU.address_latch(), CPU.data_width);
-          //CPU.data_bus = STORE_PROGRAM[CPU.s_pc++];
-          CPU.data_type = QueueDataType::ProgramEnd;
-          Controller.writeDataBus(CPU.data_bus, CPU.data_width);
-          CPU.program->debug_print(Controller.getBoard(), DebugType::STORE, "## STORE", CPU.data_bus);
-        } 
-        else {
-          Controller.getBoard().debugPrintln(DebugType::ERROR, "## Invalid condition: ExecuteDone without loading STORE");
-          Controller.writeDataBus(CPU.data_bus, CPU.data_width);
-        }
-      }
-      break;
-
-    case ServerState::Store:
-      handle_store_state();
-      break;
-
-    case ServerState::StoreAll:
-      if (CPU.cpu_type == CpuType::i80286) {
-        handle_storeall_286();
-      } else if (CPU.cpu_type == CpuType::i80386) {
-        handle_smm_store_386();
-      } else {
-        ArduinoX86::Server.change_state(ServerState::Error);
-        set_error("StoreAll not implemented for this CPU type!");
-      }
-      break;
-
-    case ServerState::StoreDoneSmm: // FALLTHROUGH
-    case ServerState::StoreDone:
-      // We are done with the Store program.
-      break;
-    case ServerState::Done:
-      break;
-    case ServerState::Shutdown: // FALLTHROUGH
-    case ServerState::Error:
-      if (CPU.error_cycle_ct < MAX_ERROR_CYCLES) {
-        CPU.error_cycle_ct++;
-      }
-      break;
-  }
+  // Handle state machine. One indirect call through the per-state handler
+  // table replaces the switch over ServerState; see STATE_HANDLERS above.
+  STATE_HANDLERS[static_cast<uint8_t>(ArduinoX86::Server.state())](q);
 
   if (Controller.getBoard().isDebugEnabled()) {
     // Print instruction state if tracing is enabled
     switch (ArduinoX86::Server.state()) {
       case ServerState::Reset:
         #if TRACE_RESET
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
       case ServerState::CpuId:
         #if TRACE_ID
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
       case ServerState::CpuSetup:
         #if TRACE_SETUP
-          print_cpu_state();  
+          trace_cpu_state();  
         #else
           //delayMicroseconds(20);
         #endif
         break;
       case ServerState::JumpVector:
         #if TRACE_VECTOR
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
       case ServerState::Load:  // FALLTHROUGH
       case ServerState::LoadSmm: // FALLTHROUGH
       case ServerState::LoadDone:
         #if TRACE_LOAD
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
       case ServerState::Prefetch:
         #if TRACE_PREFETCH
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
       case ServerState::EmuEnter:
         #if TRACE_EMU_ENTER
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
       case ServerState::EmuExit:
         #if TRACE_EMU_EXIT
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
       case ServerState::Execute:
         #if TRACE_EXECUTE
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
       case ServerState::ExecuteDone:  // FALLTHROUGH
       case ServerState::ExecuteFinalize:
         #if TRACE_FINALIZE
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
       case ServerState::Done: // FALLTHROUGH
@@ -1229,13 +1491,13 @@ void cycle() {
       case ServerState::Store: // FALLTHROUGH
       case ServerState::StoreAll:
         #if TRACE_STORE
-          print_cpu_state();
+          trace_cpu_state();
         #endif
         break;
 
       case ServerState::Shutdown: // FALLTHROUGH
       case ServerState::Error:
-        print_cpu_state();
+        trace_cpu_state();
         break;
     }
   }
@@ -1256,7 +1518,12 @@ void cycle() {
     }
     if (Controller.readReadyPin()) {
       cycle_state.pins |= CycleState::READY;
-    }    
+    }
+    // Tag cycles stolen by the refresh generator so host tooling can line
+    // them up against instruction boundaries.
+    if (refresh_gen_state & REFRESH_GEN_HOLDING) {
+      cycle_state.pins |= CycleState::HOLD;
+    }
     ArduinoX86::CycleLogger->log(cycle_state);
   }
   
@@ -1269,6 +1536,25 @@ void cycle() {
     CPU.wait_state_ct = 0;
   }
 
+  if (Controller.readALEPin()) {
+    // Per-region wait profile (CmdSetWaitStates): one page-table load keyed
+    // by the latched address; I/O and interrupt-acknowledge transfers use
+    // the single I/O profile. The map is all zero unless the host programs
+    // it, so READY is normally never driven from here.
+    uint8_t region_ws;
+    if ((CPU.bus_state_latched == IOR) || (CPU.bus_state_latched == IOW) ||
+        (CPU.bus_state_latched == INTA)) {
+      region_ws = ArduinoX86::Bus->io_wait_states();
+    }
+    else {
+      region_ws = ArduinoX86::Bus->mem_wait_states(CPU.address_latch());
+    }
+    if (region_ws > 0) {
+      WRITE_READY_PIN(READY_DEASSERT);
+      CPU.wait_states_active = region_ws;
+    }
+  }
+
   // Print deferred debug string if it exists
   Controller.getBoard().debugPrintDeferred();
 
@@ -1285,23 +1571,154 @@ void handle_fetch(uint8_t q) {
 
    Controller.getBoard().debugPrintln(DebugType::QUEUE, "## QUEUE: T4 of code fetch!");
 
-    if (q == QUEUE_FLUSHED) {
+    // The push is the same whether or not the queue flushed this cycle; the
+    // flush case only differs in its debug note.
+    if (QUEUE_ACTIONS[q & 0x03] & QA_FLUSH) {
       Controller.getBoard().debugPrintln(DebugType::QUEUE, "## Queue flush during T4.");
-      if (CPU.queue.have_room(CPU.data_width)) {
-        CPU.queue.push(CPU.data_bus, CPU.data_type, CPU.data_width);
+    } else {
+      Controller.getBoard().debugPrint(DebugType::QUEUE, "## QUEUE: T4, Pushing data bus to queue: ");
+      Controller.getBoard().debugPrintln(DebugType::QUEUE, CPU.data_bus, HEX);
+    }
+    if (CPU.queue.have_room(CPU.data_width)) {
+      CPU.queue.push(CPU.data_bus, CPU.data_type, CPU.data_width);
+    } else {
+      // No room for fetch - this shouldn't happen!
+      Controller.getBoard().debugPrintln(DebugType::ERROR, "## Error: Invalid Queue Length++ ##");
+    }
+  }
+}
+
+void handle_emu_exit_state() {
+  if (!Controller.readMRDCPin()) {
+    // CPU is reading (MRDC active-low)
+    if ((CPU.bus_state_latched == CODE) && (CPU.bus_state == PASV)) {
+      // CPU is doing code fetch
+      if (CPU.s_pc < sizeof EMU_EXIT_PROGRAM) {
+        // Read code byte from EmuExit program
+        CPU.data_bus = EMU_EXIT_PROGRAM.read(CPU.address_latch(), CPU.data_width);
+        Controller.getBoard().debugPrint(DebugType::EMU, "## EMUEXIT: fetching byte: ");
+        Controller.getBoard().debugPrint(DebugType::EMU, CPU.data_bus, 16);
+        Controller.getBoard().debugPrint(DebugType::EMU, " new s_pc: ");
+        Controller.getBoard().debugPrintln(DebugType::EMU, CPU.s_pc);
+        CPU.data_type = QueueDataType::Program;
       } else {
-        // No room for fetch - this shouldn't happen!
-        Controller.getBoard().debugPrintln(DebugType::ERROR, "## Error: Invalid Queue Length++ ##");
+        CPU.data_bus = OPCODE_DOUBLENOP;
+        CPU.data_type = QueueDataType::ProgramEnd;
       }
-    } else {
-      if (CPU.queue.have_room(CPU.data_width)) {
-        Controller.getBoard().debugPrint(DebugType::QUEUE, "## QUEUE: T4, Pushing data bus to queue: ");
-        Controller.getBoard().debugPrintln(DebugType::QUEUE, CPU.data_bus, HEX);
-        CPU.queue.push(CPU.data_bus, CPU.data_type, CPU.data_width);
+      Controller.writeDataBus(CPU.data_bus, CPU.data_width);
+    }
+
+    if ((CPU.bus_state_latched == MEMR) && (CPU.bus_state == PASV)) {
+      // CPU is doing memory read
+      // This will occur when RETEM pops IP, CS and Flags from the stack.
+
+      if (CPU.width == CpuBusWidth::Eight) {
+        // Stack values will be read in two operations
+        if (CPU.stack_r_op_ct == 0) {
+          // Skip
+        } 
+        else if (CPU.stack_r_op_ct == 1) {
+          // Skip
+        } 
+        else if (CPU.stack_r_op_ct == 2) {
+          Controller.getBoard().debugPrint(DebugType::EMU, "## Reading RETEM CS pop (1/2): ");
+          Controller.getBoard().debugPrintln(DebugType::EMU, CPU.load_regs.cs, 16);
+          // Write the low byte of CS to the data bus
+          data_bus_set_byte((uint8_t)(CPU.load_regs.cs));
+        } 
+        else if (CPU.stack_r_op_ct == 3) {
+          Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM CS pop (2/2)! ##");
+          Controller.getBoard().debugPrintln(DebugType::EMU, CPU.load_regs.cs, 16);
+          // Write the high byte of CS to the data bus
+          data_bus_set_byte((uint8_t)(CPU.load_regs.cs >> 8));
+        } 
+        else if (CPU.stack_r_op_ct == 4) {
+          Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM flag pop (1/2)! ##");
+          // Write the low byte of flags to the data bus
+          data_bus_set_byte((uint8_t)(CPU.pre_emu_flags));
+        } 
+        else if (CPU.stack_r_op_ct == 5) {
+          Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM flag pop (2/2)! ##");
+          // Write the high byte of flags to the data bus
+          data_bus_set_byte((uint8_t)(CPU.pre_emu_flags >> 8));
+          // Exit emulation mode
+          CPU.in_emulation = false;
+          ArduinoX86::Server.change_state(ServerState::ExecuteFinalize);
+        } else {
+          // Not flags, just write 0's so we jump back to CS:IP 0000:0000
+          CPU.data_bus = 0;
+        }
+        CPU.stack_r_op_ct++;
       } else {
-        // Shouldn't be here
-        Controller.getBoard().debugPrintln(DebugType::ERROR, "## Error: Invalid Queue Length++ ##");
+        // Sixteen-bit data bus
+        if (CPU.stack_r_op_ct == 0) {
+          // IP is read in one operation
+          Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM IP pop! ##");
+          CPU.data_bus = 0;
+        } else if (CPU.stack_r_op_ct == 1) {
+          // CS is read in one operation
+          Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM CS pop! ##");
+          Controller.getBoard().debugPrintln(DebugType::EMU, CPU.load_regs.cs);
+          // We can restore CS from the loaded registers since CS cannot be modified in 8080 emulation mode
+          CPU.data_bus = CPU.load_regs.cs;
+        } else if (CPU.stack_r_op_ct == 2) {
+          // Flags will be read in one operation
+          Controller.getBoard().debugPrintln(DebugType::EMU, "## Reading RETEM Flag pop! ##");
+          // CPU is writing to the data bus, latch value
+          CPU.data_bus = CPU.pre_emu_flags;
+          // Exit emulation mode
+          CPU.in_emulation = false;
+          ArduinoX86::Server.change_state(ServerState::ExecuteFinalize);
+        }
+        CPU.stack_r_op_ct++;
       }
+      Controller.writeDataBus(CPU.data_bus, CPU.data_width);
+    }
+  }
+
+  if (!Controller.readMWTCPin() && (CPU.bus_state_latched == MEMW) && (CPU.bus_state == PASV)) {
+    // CPU is writing. This should only happen during EmuExit when we PUSH PSW
+    // to save the 8080 flags.
+    if (CPU.width == CpuBusWidth::Eight) {
+      // 8-bit data bus
+      if (CPU.stack_w_op_ct == 0) {
+        // Flags will be in first byte written (second byte will be AL)
+        Controller.getBoard().debugPrint(DebugType::EMU, "## Capturing PUSH PSW stack write! ##");
+        CPU.emu_flags = (uint8_t)CPU.data_bus;
+      }
+      CPU.stack_w_op_ct++;
+    } else {
+      // 16-bit data bus
+      if (CPU.stack_w_op_ct == 0) {
+        // Flags were pushed in one operation.
+        Controller.getBoard().debugPrintln(DebugType::EMU, "## Capturing PUSH PSW stack write! ##");
+        CPU.emu_flags = (uint8_t)CPU.data_bus;
+      }
+      CPU.stack_w_op_ct++;
+    }
+  }
+
+}
+
+void handle_execute_done_state() {
+  // We sit in ExecuteDone state until the client requests a Store operation.
+  // The client should not cycle the CPU in this state.
+  if (!Controller.readMRDCPin() && CPU.bus_state == PASV) {
+    // CPU is reading (MRDC active-low)
+    Controller.writeDataBus(CPU.data_bus, CPU.data_width);
+
+    if ((CPU.bus_state_latched == CODE) && (CPU.prefetching_store)) {
+      // Since client does not cycle the CPU in this state, we have to fetch from
+      // STORE program ourselves
+      CPU.data_bus = CPU.program->read(CPU.address_latch(), CPU.data_width);
+      //CPU.data_bus = STORE_PROGRAM[CPU.s_pc++];
+      CPU.data_type = QueueDataType::ProgramEnd;
+      Controller.writeDataBus(CPU.data_bus, CPU.data_width);
+      CPU.program->debug_print(Controller.getBoard(), DebugType::STORE, "## STORE", CPU.data_bus);
+    } 
+    else {
+      Controller.getBoard().debugPrintln(DebugType::ERROR, "## Invalid condition: ExecuteDone without loading STORE");
+      Controller.writeDataBus(CPU.data_bus, CPU.data_width);
     }
   }
 }
@@ -1467,9 +1884,10 @@ void handle_loadall_286() {
       // We are reading a memory word
       if ((CPU.address_latch() >= LOADALL286_ADDRESS) && (CPU.address_latch() < (LOADALL286_ADDRESS + sizeof CPU.loadall_regs_286))) {
         CPU.loadall_checkpoint++;
-        size_t idx = (CPU.address_latch() - LOADALL286_ADDRESS) / 2;
-        uint16_t *word_ptr = ((uint16_t *)&CPU.loadall_regs_286);
-        CPU.data_bus = word_ptr[idx];
+        // The flat Loadall image was pre-staged in the bus emulator when the
+        // register set was installed; serve it through the normal backend
+        // read path.
+        CPU.data_bus = ArduinoX86::Bus->mem_read_bus(CPU.address_latch(), !Controller.readBHEPin(), false);
         Controller.getBoard().debugPrint(DebugType::LOAD, "## LOADALL_286: Writing LOADALL word to bus: ", true);
         Controller.getBoard().debugPrintln(DebugType::LOAD, CPU.data_bus, 16, true);
         Controller.writeDataBus(CPU.data_bus, CPU.data_width);
@@ -2073,7 +2491,7 @@ void handle_execute_automatic() {
 
   if (cpu_iorc) {
     if (READ_ABUS_23) {
-      // NPX read. Read if READYO is high. 
+      // NPX read. Read if READYO is high.
       CPU.data_bus = Controller.readDataBus(CPU.data_width);
     }
     else if (CPU.bus_cycle == WRITE_CYCLE) {
@@ -2082,6 +2500,33 @@ void handle_execute_automatic() {
     }
   }
 
+  if ((CPU.bus_state_latched == INTA) && (CPU.bus_cycle == WRITE_CYCLE) && ArduinoX86::Bus->intr_vector_armed()) {
+    // Interrupt acknowledge with the emulated interrupt controller armed
+    // (CmdSetIntVector). Answer the cycle ourselves instead of requiring the
+    // host to single-step in and supply the vector; the CPU only samples the
+    // bus on the second INTA cycle, but driving both is harmless. The IVT
+    // fetch that follows is an ordinary memory read served above.
+    static bool second_inta_cycle = false;
+    CPU.data_bus = ArduinoX86::Bus->intr_vector();
+    Controller.writeDataBus(CPU.data_bus, CPU.data_width);
+
+    if (print) {
+      Controller.getBoard().debugPrintf(
+        DebugType::EXECUTE,
+        true,
+        "## EXECUTE: Serving INTA cycle with vector %02X\n\r",
+        (uint8_t)CPU.data_bus
+      );
+    }
+
+    if (second_inta_cycle) {
+      // Vector accepted. Drop INTR like an 8259 in automatic-EOI mode so the
+      // handler is not immediately re-entered.
+      Controller.writePin(OutputPin::Intr, false);
+    }
+    second_inta_cycle = !second_inta_cycle;
+  }
+
   if ((READ_NMI_PIN) && (CPU.nmi_checkpoint == 0)) {
     // Use checkpoint "1" to specify that NMI has been detected. This just prevents the debug message from
     // printing every cycle after NMI.
@@ -2617,6 +3062,10 @@ void do_frame_update() {
     fps_counter = 0;
   }
 
+  // updateCell() only stages values; this repaints whichever cells actually
+  // changed, within the display's per-pass time budget.
+  screen->service();
+
   last_millis = current_ms;
 }
 
@@ -2624,30 +3073,27 @@ void do_frame_update() {
 bool readParameterBytes(uint8_t *buf, size_t buf_len, size_t len)  {
 
   Controller.getBoard().debugPrintln(DebugType::PROTO, "## readParameterBytes(): Reading " + String(len) + " parameter bytes...");
-  size_t bytes_read = 0;
-  unsigned long start_time = millis();
-  uint8_t byte = 0;
-
-  while (bytes_read < len) {
-    if (INBAND_SERIAL.available() > 0) {
-      byte = (uint8_t)INBAND_SERIAL.read();
-      buf[bytes_read++] = byte;
-      Controller.getBoard().debugPrintln(DebugType::PROTO, "## readParameterBytes(): Read byte " + String(bytes_read) + ": 0x" + String(byte, HEX));
-    } else {
-      // Check for timeout
-      if (millis() - start_time > CMD_TIMEOUT) {
-        Controller.getBoard().debugPrintln(DebugType::ERROR, "## readParameterBytes(): Timeout!");
-        return false; // Timeout
-      }
-    }
+  (void)buf_len;
+
+  // The server stages incoming protocol bytes (in a local ring, or in the
+  // shared-memory rings when the M4 front end is running), so parameter
+  // payloads are read through it rather than polling INBAND_SERIAL directly.
+  if (!ArduinoX86::Server.read_parameter_bytes(buf, len)) {
+    Controller.getBoard().debugPrintln(DebugType::ERROR, "## readParameterBytes(): Timeout!");
+    return false; // Timeout
   }
-  Controller.getBoard().debugPrintln(DebugType::PROTO, "## readParameterBytes(): Successfully read " + String(bytes_read) + " bytes.");
+
+  Controller.getBoard().debugPrintln(DebugType::PROTO, "## readParameterBytes(): Successfully read " + String(len) + " bytes.");
   return true; // Successfully read all bytes
 }
 
 // Main sketch loop
 void loop() {
 
+#if defined(ARDUINO_GIGA) && USE_WATCHDOG
+  mbed::Watchdog::get_instance().kick();
+#endif
+
   if (screen_init_requested && !screen_initialized) {
     Board.debugPrintln(DebugType::SETUP, "Initializing screen...");
     screen->init();
@@ -2664,22 +3110,43 @@ void loop() {
   do_frame_update();
   ArduinoX86::Server.run();
 
+  // Drain any pending cycle log bank in the background while executing.
+  ArduinoX86::CycleLogger->service();
+
+  // Drain staged debug output to the hardware port without blocking.
+  DebugRing.service();
+
+  // Advance any beep pattern in progress without blocking.
+  buzzer_service();
+
   bool executing = (ArduinoX86::Server.get_state() == ServerState::Execute) ||
                   (ArduinoX86::Server.get_state() == ServerState::ExecuteFinalize) ||
                   (ArduinoX86::Server.get_state() == ServerState::ExecuteDone) ||
                   (ArduinoX86::Server.get_state() == ServerState::Store) ||
                   (ArduinoX86::Server.get_state() == ServerState::StoreAll);
 
-  if (executing && (ArduinoX86::Server.is_execute_automatic())) {
+  if (executing && (ArduinoX86::Server.is_execute_automatic())
+      && !ArduinoX86::Bus->watch_hit()) {
+    // A latched watchpoint hit pauses automatic execution until the host
+    // reads and clears it via CmdGetWatchHit.
     CPU.execute_cycle_ct++;
     cycle();
-    // if (CPU.execute_cycle_ct < EXECUTE_TIMEOUT) {
-    //   cycle();
-    // }
-    // else if (CPU.execute_cycle_ct == EXECUTE_TIMEOUT) {
-    //   Controller.getBoard().debugPrintln(DebugType::ERROR, "## Execute cycle timeout reached! Ending execution.");
-    //   ArduinoX86::Server.change_state(ServerState::Error);
-    // }
+
+    if (CPU.execute_cycle_ct >= EXECUTE_WATCHDOG_CYCLES) {
+      // The target CPU has wedged - marginal parts can stop presenting bus
+      // statuses entirely, so the program will never terminate on its own.
+      // Reset the target and return to Reset state rather than spinning
+      // forever: the USB session stays up and the host learns what happened
+      // via CmdLastError.
+      Board.debugPrintf(
+        DebugType::ERROR, false,
+        "## Execute watchdog: no completion after %d cycles! Resetting CPU.\n\r",
+        EXECUTE_WATCHDOG_CYCLES);
+      set_error("Execute watchdog expired; target CPU was reset");
+      CpuResetResult reset_result = Controller.resetCpu();
+      CPU.reset(reset_result, true);
+      ArduinoX86::Server.change_state(ServerState::Reset);
+    }
   }
   else if ((ArduinoX86::Server.get_state() == ServerState::Error) && (CPU.error_cycle_ct < MAX_ERROR_CYCLES)) {
     // If we are in error state, we still want to cycle the CPU to allow it to
@@ -22,6 +22,8 @@
 */
 #pragma once
 
+#include <cstdint>
+
 #define OPCODE_HALT 0xF4
 #define OPCODE_DOUBLE_HALT 0xF4F4 // For 386, which only fetches at even addresses
 #define OPCODE_NOP 0x90
@@ -37,7 +39,133 @@
 #define GRP3 107
 #define GRP4 108
 #define GRP5 109
-#define IS_GRP_OP(O) ((OPCODE_REFS[O] >= GRP1) && (OPCODE_REFS[O] <= GRP2B))
+
+// Packed per-opcode attribute bits, indexed by the primary opcode byte.
+// Classification on the cycle path is one table load and a mask; the
+// mnemonic string tables are only consulted when debug output or a dump
+// actually needs the name.
+#define OPCODE_ATTR_GROUP      0x01 // Mnemonic selected by the modrm reg field
+#define OPCODE_ATTR_PREFIX     0x02 // Prefix byte (segment override, LOCK, REP)
+#define OPCODE_ATTR_TERMINATES 0x04 // Terminates a test program (HLT)
+
+struct OpcodeAttrTable {
+  uint8_t v[256];
+  constexpr OpcodeAttrTable() : v{} {
+    // Group opcodes (OPCODE_REFS maps these to GRP1..GRP5).
+    v[0x80] = v[0x81] = v[0x82] = v[0x83] = OPCODE_ATTR_GROUP; // GRP1
+    v[0xD0] = v[0xD1] = OPCODE_ATTR_GROUP;                     // GRP2A
+    v[0xD2] = v[0xD3] = OPCODE_ATTR_GROUP;                     // GRP2B
+    v[0xF6] = v[0xF7] = OPCODE_ATTR_GROUP;                     // GRP3
+    v[0xFE] = OPCODE_ATTR_GROUP;                               // GRP4
+    v[0xFF] = OPCODE_ATTR_GROUP;                               // GRP5
+    // Prefix bytes.
+    v[0x26] |= OPCODE_ATTR_PREFIX; // ES:
+    v[0x2E] |= OPCODE_ATTR_PREFIX; // CS:
+    v[0x36] |= OPCODE_ATTR_PREFIX; // SS:
+    v[0x3E] |= OPCODE_ATTR_PREFIX; // DS:
+    v[0xF0] |= OPCODE_ATTR_PREFIX; // LOCK
+    v[0xF2] |= OPCODE_ATTR_PREFIX; // REPNE
+    v[0xF3] |= OPCODE_ATTR_PREFIX; // REP
+    // Test programs end at HLT.
+    v[OPCODE_HALT] |= OPCODE_ATTR_TERMINATES;
+  }
+};
+
+constexpr OpcodeAttrTable OPCODE_ATTRS{};
+
+#define OPCODE_ATTR(O) (OPCODE_ATTRS.v[(uint8_t)(O)])
+#define IS_GRP_OP(O) ((OPCODE_ATTR(O) & OPCODE_ATTR_GROUP) != 0)
+#define IS_PREFIX_OP(O) ((OPCODE_ATTR(O) & OPCODE_ATTR_PREFIX) != 0)
+#define IS_ESC_OP(O) (((uint8_t)(O) & 0xF8) == 0xD8)
+#define IS_TERMINATING_OP(O) ((OPCODE_ATTR(O) & OPCODE_ATTR_TERMINATES) != 0)
+
+// Per-opcode metadata for the on-device program generator (CmdGenProgram).
+// The low byte is GEN_CLASS_* membership, tested against the host's class
+// mask. The high byte carries the structural bits the generator needs to
+// emit a well-formed instruction (modrm, immediate sizes) plus GEN_UNSAFE
+// for opcodes that can leave a generated program unterminatable or vary
+// by CPU generation: far and indirect flow, IVT trips (INT, POPF with a
+// random TF), WAIT, ESC, HLT, and the 8086 aliases of later opcodes
+// (0x0F, 0x60-0x6F, 0xC0/C1, 0xC8/C9, 0xF1). Unsafe opcodes are never
+// generated regardless of the class mask.
+#define GEN_CLASS_ALU    0x01 // Arithmetic, logic, shifts, flag transfers
+#define GEN_CLASS_DATA   0x02 // MOV, XCHG, LEA, LES/LDS, XLAT
+#define GEN_CLASS_STACK  0x04 // PUSH/POP forms
+#define GEN_CLASS_STRING 0x08 // MOVS/CMPS/STOS/LODS/SCAS
+#define GEN_CLASS_FLOW   0x10 // Bounded flow: Jcc, LOOPcc, JCXZ, JMP rel8
+#define GEN_CLASS_IO     0x20 // IN/OUT
+#define GEN_CLASS_MISC   0x40 // CLC/STC/CLI/STI/CLD/STD, GRP5
+#define GEN_CLASS_PREFIX 0x80 // Segment overrides, LOCK, REP
+
+#define GEN_MODRM  0x0100 // Opcode takes a modrm byte (plus displacement)
+#define GEN_IMM8   0x0200 // One immediate byte follows
+#define GEN_IMM16  0x0400 // Two immediate bytes follow
+#define GEN_REL8   0x0800 // rel8 displacement; generator forces it forward
+#define GEN_UNSAFE 0x8000 // Never generate
+
+struct OpcodeGenTable {
+  uint16_t v[256];
+  constexpr OpcodeGenTable() : v{} {
+    // Everything not explicitly opened up below is unsafe.
+    for (int i = 0; i < 256; i++) { v[i] = GEN_UNSAFE; }
+    // ALU blocks: ADD/OR/ADC/SBB/AND/SUB/XOR/CMP.
+    for (int b = 0; b < 8; b++) {
+      int base = b * 8;
+      v[base + 0] = v[base + 1] = v[base + 2] = v[base + 3] = GEN_CLASS_ALU | GEN_MODRM;
+      v[base + 4] = GEN_CLASS_ALU | GEN_IMM8;
+      v[base + 5] = GEN_CLASS_ALU | GEN_IMM16;
+    }
+    v[0x06] = v[0x0E] = v[0x16] = v[0x1E] = GEN_CLASS_STACK; // PUSH seg
+    v[0x07] = v[0x17] = v[0x1F] = GEN_CLASS_STACK;           // POP seg (POP CS excluded)
+    v[0x26] = v[0x2E] = v[0x36] = v[0x3E] = GEN_CLASS_PREFIX;
+    v[0x27] = v[0x2F] = v[0x37] = v[0x3F] = GEN_CLASS_ALU;   // DAA/DAS/AAA/AAS
+    for (int i = 0x40; i <= 0x4F; i++) { v[i] = GEN_CLASS_ALU; }   // INC/DEC r16
+    for (int i = 0x50; i <= 0x5F; i++) { v[i] = GEN_CLASS_STACK; } // PUSH/POP r16
+    for (int i = 0x70; i <= 0x7F; i++) { v[i] = GEN_CLASS_FLOW | GEN_REL8; } // Jcc
+    v[0x80] = v[0x82] = v[0x83] = GEN_CLASS_ALU | GEN_MODRM | GEN_IMM8; // GRP1
+    v[0x81] = GEN_CLASS_ALU | GEN_MODRM | GEN_IMM16;
+    v[0x84] = v[0x85] = GEN_CLASS_ALU | GEN_MODRM;  // TEST
+    v[0x86] = v[0x87] = GEN_CLASS_DATA | GEN_MODRM; // XCHG
+    for (int i = 0x88; i <= 0x8D; i++) { v[i] = GEN_CLASS_DATA | GEN_MODRM; } // MOV/LEA
+    // 0x8E (MOV sreg, r/m) stays unsafe: a random reg field can load CS.
+    v[0x8F] = GEN_CLASS_STACK | GEN_MODRM; // POP r/m
+    for (int i = 0x90; i <= 0x97; i++) { v[i] = GEN_CLASS_DATA; } // NOP/XCHG AX,r
+    v[0x98] = v[0x99] = GEN_CLASS_ALU; // CBW/CWD
+    v[0x9C] = GEN_CLASS_STACK;         // PUSHF
+    // 0x9D (POPF) stays unsafe: a random TF turns every following
+    // instruction into a type-1 IVT trip.
+    v[0x9E] = v[0x9F] = GEN_CLASS_ALU; // SAHF/LAHF
+    for (int i = 0xA0; i <= 0xA3; i++) { v[i] = GEN_CLASS_DATA | GEN_IMM16; } // MOV moffs
+    for (int i = 0xA4; i <= 0xA7; i++) { v[i] = GEN_CLASS_STRING; }
+    v[0xA8] = GEN_CLASS_ALU | GEN_IMM8;  // TEST AL,imm8
+    v[0xA9] = GEN_CLASS_ALU | GEN_IMM16; // TEST AX,imm16
+    for (int i = 0xAA; i <= 0xAF; i++) { v[i] = GEN_CLASS_STRING; }
+    for (int i = 0xB0; i <= 0xB7; i++) { v[i] = GEN_CLASS_DATA | GEN_IMM8; }  // MOV r8,imm
+    for (int i = 0xB8; i <= 0xBF; i++) { v[i] = GEN_CLASS_DATA | GEN_IMM16; } // MOV r16,imm
+    v[0xC4] = v[0xC5] = GEN_CLASS_DATA | GEN_MODRM; // LES/LDS
+    v[0xC6] = GEN_CLASS_DATA | GEN_MODRM | GEN_IMM8;
+    v[0xC7] = GEN_CLASS_DATA | GEN_MODRM | GEN_IMM16;
+    v[0xD0] = v[0xD1] = v[0xD2] = v[0xD3] = GEN_CLASS_ALU | GEN_MODRM; // Shifts
+    // 0xD4 (AAM) stays unsafe: a zero immediate raises a divide exception.
+    v[0xD5] = GEN_CLASS_ALU | GEN_IMM8; // AAD
+    v[0xD6] = GEN_CLASS_ALU;            // SALC
+    v[0xD7] = GEN_CLASS_DATA;           // XLAT
+    for (int i = 0xE0; i <= 0xE3; i++) { v[i] = GEN_CLASS_FLOW | GEN_REL8; } // LOOPcc/JCXZ
+    v[0xE4] = v[0xE5] = v[0xE6] = v[0xE7] = GEN_CLASS_IO | GEN_IMM8;
+    v[0xEB] = GEN_CLASS_FLOW | GEN_REL8; // JMP rel8
+    for (int i = 0xEC; i <= 0xEF; i++) { v[i] = GEN_CLASS_IO; } // IN/OUT DX
+    v[0xF0] = v[0xF2] = v[0xF3] = GEN_CLASS_PREFIX; // LOCK/REPNE/REP
+    v[0xF5] = GEN_CLASS_ALU; // CMC
+    // GRP3-GRP5: the generator forces the reg field to well-defined,
+    // terminatable selections (NOT/NEG, INC/DEC, INC/DEC/PUSH).
+    v[0xF6] = v[0xF7] = GEN_CLASS_ALU | GEN_MODRM;
+    for (int i = 0xF8; i <= 0xFD; i++) { v[i] = GEN_CLASS_MISC; } // CLC..STD
+    v[0xFE] = GEN_CLASS_ALU | GEN_MODRM;
+    v[0xFF] = GEN_CLASS_MISC | GEN_MODRM;
+  }
+};
+
+constexpr OpcodeGenTable OPCODE_GEN{};
 
 extern const char * const OPCODE_STRS[];
 extern const char * const OPCODE_STRS_GRP1[];
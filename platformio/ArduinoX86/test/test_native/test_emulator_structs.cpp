@@ -0,0 +1,517 @@
+/*
+    ArduinoX86 Copyright 2022-2025 Daniel Balsom
+    https://github.com/dbalsom/arduinoX86
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the “Software”),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Native-host tests and microbenchmarks for the emulator data structures
+// (env:native, `pio test -e native`). StaticHashTable, InstructionQueue and
+// HashBackend are header-only and Arduino-free on this path, so hash-table
+// and queue changes can be iterated on a desktop with perf counters instead
+// of flash-and-measure cycles. The benchmark cases always pass; they print
+// "BENCH ..." lines for the host to collect.
+
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <StaticHashTable.h>
+#include <InstructionQueue.h>
+#include <bus_emulator/HashBackend.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Deterministic key scrambler for load patterns (murmur3 finalizer, as used
+// by HashBackend's default-value generator).
+static uint32_t scramble(uint32_t h) {
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+static double now_seconds() {
+  return (double)clock() / (double)CLOCKS_PER_SEC;
+}
+
+// ---------------------------------------------------------------------------
+// StaticHashTable
+// ---------------------------------------------------------------------------
+
+static void test_hash_insert_find(void) {
+  StaticHashTable<uint32_t, uint16_t> table(1024);
+  for (uint32_t i = 0; i < 256; i++) {
+    TEST_ASSERT_TRUE(table.insert(scramble(i), (uint16_t)i));
+  }
+  TEST_ASSERT_EQUAL(256, table.size());
+  uint16_t value = 0;
+  for (uint32_t i = 0; i < 256; i++) {
+    TEST_ASSERT_TRUE(table.find(scramble(i), value));
+    TEST_ASSERT_EQUAL_UINT16((uint16_t)i, value);
+  }
+  TEST_ASSERT_FALSE(table.find(scramble(1000), value));
+}
+
+static void test_hash_for_each(void) {
+  StaticHashTable<uint32_t, uint16_t> table(256);
+  for (uint32_t i = 0; i < 64; i++) {
+    TEST_ASSERT_TRUE(table.insert(scramble(i), (uint16_t)(i + 100)));
+  }
+  // Every inserted entry must be visited exactly once, values intact.
+  size_t visited = 0;
+  uint32_t key_xor = 0;
+  uint32_t value_sum = 0;
+  table.for_each([&](uint32_t key, uint16_t value) {
+    visited++;
+    key_xor ^= key;
+    value_sum += value;
+  });
+  TEST_ASSERT_EQUAL(64, visited);
+  uint32_t expected_xor = 0;
+  uint32_t expected_sum = 0;
+  for (uint32_t i = 0; i < 64; i++) {
+    expected_xor ^= scramble(i);
+    expected_sum += i + 100;
+  }
+  TEST_ASSERT_EQUAL(expected_xor, key_xor);
+  TEST_ASSERT_EQUAL(expected_sum, value_sum);
+}
+
+static void test_hash_overwrite(void) {
+  StaticHashTable<uint32_t, uint16_t> table(64);
+  TEST_ASSERT_TRUE(table.insert(42, 0x1111));
+  TEST_ASSERT_TRUE(table.insert(42, 0x2222));
+  TEST_ASSERT_EQUAL(1, table.size());
+  uint16_t value = 0;
+  TEST_ASSERT_TRUE(table.find(42, value));
+  TEST_ASSERT_EQUAL_HEX16(0x2222, value);
+}
+
+static void test_hash_clear(void) {
+  StaticHashTable<uint32_t, uint16_t> table(64);
+  for (uint32_t i = 0; i < 32; i++) {
+    table.insert(i, (uint16_t)i);
+  }
+  table.clear();
+  TEST_ASSERT_EQUAL(0, table.size());
+  TEST_ASSERT_EQUAL(0, table.max_probe());
+  uint16_t value = 0;
+  TEST_ASSERT_FALSE(table.find(5, value));
+}
+
+static void test_hash_snapshot_restore(void) {
+  StaticHashTable<uint32_t, uint16_t> table(256);
+  for (uint32_t i = 0; i < 100; i++) {
+    table.insert(i, (uint16_t)(i * 3));
+  }
+  TEST_ASSERT_TRUE(table.snapshot());
+  table.insert(200, 0xBEEF);
+  table.insert(5, 0xDEAD);
+  TEST_ASSERT_TRUE(table.restore());
+
+  TEST_ASSERT_EQUAL(100, table.size());
+  uint16_t value = 0;
+  TEST_ASSERT_FALSE(table.find(200, value));
+  TEST_ASSERT_TRUE(table.find(5, value));
+  TEST_ASSERT_EQUAL_HEX16(15, value);
+}
+
+static void test_hash_high_load(void) {
+  const size_t CAPACITY = 4096;
+  StaticHashTable<uint32_t, uint16_t> table(CAPACITY);
+  const uint32_t KEYS = (uint32_t)(CAPACITY * 9 / 10); // 90% load
+  for (uint32_t i = 0; i < KEYS; i++) {
+    TEST_ASSERT_TRUE(table.insert(scramble(i), (uint16_t)i));
+  }
+  TEST_ASSERT_EQUAL(KEYS, table.size());
+  uint16_t value = 0;
+  for (uint32_t i = 0; i < KEYS; i++) {
+    TEST_ASSERT_TRUE(table.find(scramble(i), value));
+    TEST_ASSERT_EQUAL_UINT16((uint16_t)i, value);
+  }
+}
+
+static void test_hash_auto_grow(void) {
+  const size_t CAPACITY = 256;
+  StaticHashTable<uint32_t, uint16_t> table(CAPACITY);
+  // Push four times the initial capacity through the table. Each insert past
+  // the load threshold migrates to a double-size pool, so nothing is dropped.
+  const uint32_t KEYS = (uint32_t)(CAPACITY * 4);
+  for (uint32_t i = 0; i < KEYS; i++) {
+    TEST_ASSERT_TRUE(table.insert(scramble(i), (uint16_t)i));
+  }
+  TEST_ASSERT_EQUAL(KEYS, table.size());
+  TEST_ASSERT_TRUE(table.capacity() > CAPACITY);
+  TEST_ASSERT_EQUAL(0, table.failed_inserts());
+  TEST_ASSERT_TRUE(table.grow_count() >= 3);
+  uint16_t value = 0;
+  for (uint32_t i = 0; i < KEYS; i++) {
+    TEST_ASSERT_TRUE(table.find(scramble(i), value));
+    TEST_ASSERT_EQUAL_UINT16((uint16_t)i, value);
+  }
+  // A snapshot's geometry no longer matches after a migration, so it must be
+  // discarded rather than restored into the grown table.
+  TEST_ASSERT_TRUE(table.snapshot());
+  for (uint32_t i = KEYS; i < KEYS * 2; i++) {
+    TEST_ASSERT_TRUE(table.insert(scramble(i), (uint16_t)i));
+  }
+  TEST_ASSERT_FALSE(table.has_snapshot());
+  TEST_ASSERT_FALSE(table.restore());
+}
+
+// ---------------------------------------------------------------------------
+// InstructionQueue
+// ---------------------------------------------------------------------------
+
+static void test_queue_push_pop_8(void) {
+  InstructionQueue queue(4, BusWidth::Eight);
+  queue.push(0x90, QueueDataType::Program, ActiveBusWidth::EightLow);
+  queue.push(0xF4, QueueDataType::ProgramEnd, ActiveBusWidth::EightLow);
+  TEST_ASSERT_EQUAL(2, queue.len());
+
+  uint8_t byte = 0;
+  QueueDataType d_type = QueueDataType::Program;
+  TEST_ASSERT_TRUE(queue.pop(&byte, &d_type));
+  TEST_ASSERT_EQUAL_HEX8(0x90, byte);
+  TEST_ASSERT_EQUAL((int)QueueDataType::Program, (int)d_type);
+  TEST_ASSERT_TRUE(queue.pop(&byte, &d_type));
+  TEST_ASSERT_EQUAL_HEX8(0xF4, byte);
+  TEST_ASSERT_EQUAL((int)QueueDataType::ProgramEnd, (int)d_type);
+  TEST_ASSERT_FALSE(queue.pop(&byte, &d_type));
+}
+
+static void test_queue_push_pop_16(void) {
+  InstructionQueue queue(6, BusWidth::Sixteen);
+  queue.push(0xBBAA, QueueDataType::Program, ActiveBusWidth::Sixteen);
+  TEST_ASSERT_EQUAL(2, queue.len());
+
+  uint8_t byte = 0;
+  QueueDataType d_type = QueueDataType::Program;
+  TEST_ASSERT_TRUE(queue.pop(&byte, &d_type));
+  TEST_ASSERT_EQUAL_HEX8(0xAA, byte); // Low byte first
+  TEST_ASSERT_TRUE(queue.pop(&byte, &d_type));
+  TEST_ASSERT_EQUAL_HEX8(0xBB, byte);
+
+  // High-lane fetch takes the high byte of the bus value.
+  queue.push(0xCC55, QueueDataType::Program, ActiveBusWidth::EightHigh);
+  TEST_ASSERT_TRUE(queue.pop(&byte, &d_type));
+  TEST_ASSERT_EQUAL_HEX8(0xCC, byte);
+}
+
+static void test_queue_room_and_flush(void) {
+  InstructionQueue queue(4, BusWidth::Eight);
+  for (int i = 0; i < 4; i++) {
+    TEST_ASSERT_TRUE(queue.have_room(ActiveBusWidth::EightLow));
+    queue.push((uint16_t)i, QueueDataType::Program, ActiveBusWidth::EightLow);
+  }
+  TEST_ASSERT_FALSE(queue.have_room(ActiveBusWidth::EightLow));
+  // A full push against a full queue must not corrupt the contents.
+  queue.push(0xFF, QueueDataType::Program, ActiveBusWidth::EightLow);
+  TEST_ASSERT_EQUAL(4, queue.len());
+  TEST_ASSERT_EQUAL_HEX8(0, queue.read_byte(0));
+
+  TEST_ASSERT_EQUAL(4, queue.flush());
+  TEST_ASSERT_EQUAL(0, queue.len());
+}
+
+// ---------------------------------------------------------------------------
+// T-cycle transition tables
+// ---------------------------------------------------------------------------
+
+// Reference implementations of the nested switches the TCYCLE_NEXT_* tables
+// replaced in the shield getNextCycleImpl() functions, with the pin-derived
+// transfer-done and status!=PASV predicates reduced to a condition bit.
+
+static TCycle ref_next_808x(TCycle current_cycle, bool cond) {
+  switch (current_cycle) {
+    case TI: break;
+    case T1: if (cond) { return T2; } break;
+    case T2: return T3;
+    case T3: return cond ? T4 : TW;
+    case TW: if (cond) { return T4; } break;
+    case T4: return T1;
+  }
+  return current_cycle;
+}
+
+static TCycle ref_next_286(TCycle current_cycle, bool cond) {
+  switch (current_cycle) {
+    case TI: return TI;
+    case T1: if (cond) { return T2; } break;
+    case T2: return cond ? TI : TW;
+    case TW: if (cond) { return TI; } break;
+    default: break;
+  }
+  return TI;
+}
+
+static void test_tcycle_table_equivalence(void) {
+  const TCycle cycles[] = {TI, T1, T2, T3, T4, TW};
+  for (TCycle t : cycles) {
+    for (int cond = 0; cond <= 1; cond++) {
+      TEST_ASSERT_EQUAL(ref_next_808x(t, cond != 0), TCYCLE_NEXT_808X[t][cond]);
+      TEST_ASSERT_EQUAL(ref_next_286(t, cond != 0), TCYCLE_NEXT_286[t][cond]);
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// HashBackend
+// ---------------------------------------------------------------------------
+
+static void test_backend_byte_lanes(void) {
+  HashBackend backend(4096);
+  backend.set_strategy(IBusBackend::DefaultStrategy::Zero, 0, 0xFFFFFF);
+
+  backend.write_u8(0x1000, 0x34);
+  backend.write_u8(0x1001, 0x12);
+  TEST_ASSERT_EQUAL_HEX16(0x1234, backend.read_u16(0x1000));
+  TEST_ASSERT_EQUAL_HEX8(0x34, backend.read_u8(0x1000));
+  TEST_ASSERT_EQUAL_HEX8(0x12, backend.read_u8(0x1001));
+}
+
+static void test_backend_write_bus_bhe(void) {
+  HashBackend backend(4096);
+  backend.set_strategy(IBusBackend::DefaultStrategy::Zero, 0, 0xFFFFFF);
+
+  backend.write_u16(0x2000, 0x0000);
+  // Even address, BHE: full word.
+  backend.write_bus(0x2000, 0xAABB, true);
+  TEST_ASSERT_EQUAL_HEX16(0xAABB, backend.read_u16(0x2000));
+  // Even address, no BHE: low byte only.
+  backend.write_bus(0x2000, 0x11CC, false);
+  TEST_ASSERT_EQUAL_HEX16(0xAACC, backend.read_u16(0x2000));
+  // Odd address, BHE: high byte only.
+  backend.write_bus(0x2001, 0x00DD, true);
+  TEST_ASSERT_EQUAL_HEX16(0xDDCC, backend.read_u16(0x2000));
+  // Odd address, no BHE: refresh cycle, no write.
+  backend.write_bus(0x2001, 0x9999, false);
+  TEST_ASSERT_EQUAL_HEX16(0xDDCC, backend.read_u16(0x2000));
+}
+
+static void test_backend_set_memory_and_strategy(void) {
+  HashBackend backend(4096);
+  backend.set_strategy(IBusBackend::DefaultStrategy::Ones, 0x1000, 0x2000);
+
+  const uint8_t program[] = { 0x90, 0x90, 0xEB, 0xFE };
+  backend.set_memory(0x1500, program, sizeof(program));
+  for (size_t i = 0; i < sizeof(program); i++) {
+    TEST_ASSERT_EQUAL_HEX8(program[i], backend.read_u8(0x1500 + i));
+  }
+  // Untouched address inside the strategy window reads the Ones default.
+  TEST_ASSERT_EQUAL_HEX16(0xFFFF, backend.read_u16(0x1800));
+
+  backend.erase_memory();
+  TEST_ASSERT_EQUAL_HEX16(0xFFFF, backend.read_u16(0x1500));
+
+  // Odd start address and odd length exercise the unaligned edges of the
+  // word-wise upload path, and must merge with resident bytes.
+  backend.write_u8(0x1600, 0xAA);
+  backend.write_u8(0x1606, 0xBB);
+  const uint8_t patch[] = { 0x11, 0x22, 0x33, 0x44, 0x55 };
+  backend.set_memory(0x1601, patch, sizeof(patch));
+  TEST_ASSERT_EQUAL_HEX8(0xAA, backend.read_u8(0x1600));
+  for (size_t i = 0; i < sizeof(patch); i++) {
+    TEST_ASSERT_EQUAL_HEX8(patch[i], backend.read_u8(0x1601 + i));
+  }
+  TEST_ASSERT_EQUAL_HEX8(0xBB, backend.read_u8(0x1606));
+}
+
+static void test_backend_strategy_regions(void) {
+  HashBackend backend(4096);
+  // Compose a small machine map: zeroed conventional RAM, a 0xFF ROM hole,
+  // random above it (anything outside every region also reads random).
+  backend.set_strategy(IBusBackend::DefaultStrategy::Zero, 0x0000, 0x7FFF);
+  TEST_ASSERT_TRUE(backend.add_strategy(IBusBackend::DefaultStrategy::Ones, 0x8000, 0x9FFF));
+  TEST_ASSERT_TRUE(backend.add_strategy(IBusBackend::DefaultStrategy::Random, 0xA000, 0xFFFF));
+
+  TEST_ASSERT_EQUAL_HEX16(0x0000, backend.read_u16(0x0100));
+  TEST_ASSERT_EQUAL_HEX16(0xFFFF, backend.read_u16(0x8100));
+  // Random defaults are deterministic per address under a fixed seed.
+  TEST_ASSERT_EQUAL_HEX16(backend.read_u16(0xA100), backend.read_u16(0xA100));
+
+  // Writes still shadow any region's default.
+  backend.write_u16(0x8100, 0x1234);
+  TEST_ASSERT_EQUAL_HEX16(0x1234, backend.read_u16(0x8100));
+
+  // Regions sort by start regardless of insertion order.
+  backend.set_strategy(IBusBackend::DefaultStrategy::Ones, 0x4000, 0x4FFF);
+  TEST_ASSERT_TRUE(backend.add_strategy(IBusBackend::DefaultStrategy::Zero, 0x1000, 0x1FFF));
+  TEST_ASSERT_EQUAL_HEX16(0x0000, backend.read_u16(0x1100));
+  TEST_ASSERT_EQUAL_HEX16(0xFFFF, backend.read_u16(0x4100));
+
+  // The table refuses a region once full and a backwards range outright.
+  HashBackend full(1024);
+  full.set_strategy(IBusBackend::DefaultStrategy::Zero, 0, 0);
+  for (uint32_t i = 1; i < 8; i++) {
+    TEST_ASSERT_TRUE(full.add_strategy(IBusBackend::DefaultStrategy::Zero, i * 0x100, i * 0x100 + 0xFF));
+  }
+  TEST_ASSERT_FALSE(full.add_strategy(IBusBackend::DefaultStrategy::Zero, 0x9000, 0x90FF));
+  TEST_ASSERT_FALSE(backend.add_strategy(IBusBackend::DefaultStrategy::Zero, 0x2000, 0x1000));
+}
+
+static void test_backend_snapshot_restore(void) {
+  HashBackend backend(4096);
+  backend.set_strategy(IBusBackend::DefaultStrategy::Zero, 0, 0xFFFFFF);
+
+  backend.write_u16(0x100, 0x1111);
+  TEST_ASSERT_TRUE(backend.snapshot_memory());
+  backend.write_u16(0x100, 0x2222);
+  backend.write_u16(0x200, 0x3333);
+  TEST_ASSERT_TRUE(backend.restore_memory());
+
+  TEST_ASSERT_EQUAL_HEX16(0x1111, backend.read_u16(0x100));
+  TEST_ASSERT_EQUAL_HEX16(0x0000, backend.read_u16(0x200));
+}
+
+// ---------------------------------------------------------------------------
+// Microbenchmarks (always pass; results printed as BENCH lines)
+// ---------------------------------------------------------------------------
+
+// Probe-length distribution and lookup throughput at varying load factors:
+// the numbers a hash-table change needs to defend.
+static void bench_hash_probe_distribution(void) {
+  const size_t CAPACITY = 65536;
+  const int LOADS[] = { 25, 50, 75, 90 };
+
+  for (size_t l = 0; l < sizeof(LOADS) / sizeof(LOADS[0]); l++) {
+    StaticHashTable<uint32_t, uint16_t> table(CAPACITY);
+    const uint32_t KEYS = (uint32_t)(CAPACITY * LOADS[l] / 100);
+    for (uint32_t i = 0; i < KEYS; i++) {
+      table.insert(scramble(i), (uint16_t)i);
+    }
+
+    // Histogram probe lengths; bucket 8 collects everything longer.
+    uint32_t hist[9] = { 0 };
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < KEYS; i++) {
+      uint8_t dist = table.probe_length(scramble(i));
+      TEST_ASSERT_NOT_EQUAL(0, dist); // Every inserted key must be present
+      hist[(dist < 9) ? (dist - 1) : 8]++;
+      total += dist;
+    }
+
+    const uint32_t LOOKUPS = 1000000;
+    uint16_t value = 0;
+    volatile uint32_t sink = 0; // Keeps the timed loop from being elided
+    double start = now_seconds();
+    for (uint32_t i = 0; i < LOOKUPS; i++) {
+      table.find(scramble(i % KEYS), value);
+      sink += value;
+    }
+    double elapsed = now_seconds() - start;
+    (void)sink;
+
+    printf("BENCH name=hash_probe load=%d avg_probe_x100=%lu max_probe=%u "
+           "hist=%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu find_ns=%.1f\n",
+      LOADS[l], (unsigned long)(total * 100 / KEYS), table.max_probe(),
+      (unsigned long)hist[0], (unsigned long)hist[1], (unsigned long)hist[2],
+      (unsigned long)hist[3], (unsigned long)hist[4], (unsigned long)hist[5],
+      (unsigned long)hist[6], (unsigned long)hist[7], (unsigned long)hist[8],
+      elapsed * 1e9 / LOOKUPS);
+  }
+  TEST_ASSERT_TRUE(true);
+}
+
+static void bench_queue_throughput(void) {
+  InstructionQueue queue(6, BusWidth::Eight);
+  const uint32_t OPS = 10000000;
+  uint8_t byte = 0;
+  QueueDataType d_type = QueueDataType::Program;
+
+  volatile uint32_t sink = 0; // Keeps the timed loop from being elided
+  double start = now_seconds();
+  for (uint32_t i = 0; i < OPS; i++) {
+    queue.push((uint16_t)i, QueueDataType::Program, ActiveBusWidth::EightLow);
+    queue.pop(&byte, &d_type);
+    sink += byte;
+  }
+  double elapsed = now_seconds() - start;
+  (void)sink;
+  printf("BENCH name=queue_push_pop ops=%lu ns_per_op=%.2f\n",
+    (unsigned long)OPS, elapsed * 1e9 / OPS);
+  TEST_ASSERT_TRUE(true);
+}
+
+static void bench_backend_read(void) {
+  HashBackend backend(65536);
+  for (uint32_t i = 0; i < 8192; i++) {
+    backend.write_u16((i * 16) & 0x1FFFF, (uint16_t)i);
+  }
+
+  const uint32_t READS = 1000000;
+  volatile uint16_t sink = 0;
+
+  double start = now_seconds();
+  for (uint32_t i = 0; i < READS; i++) {
+    sink = backend.read_bus((i & 0xF) << 1, true); // Hot-entry cache hits
+  }
+  double seq = now_seconds() - start;
+
+  uint32_t addr = 0;
+  start = now_seconds();
+  for (uint32_t i = 0; i < READS; i++) {
+    addr = (addr + 4994) & 0x1FFFF; // Stride defeats the hot-entry cache
+    sink = backend.read_bus(addr, true);
+  }
+  double scatter = now_seconds() - start;
+  (void)sink;
+
+  printf("BENCH name=backend_read reads=%lu seq_ns=%.2f scatter_ns=%.2f\n",
+    (unsigned long)READS, seq * 1e9 / READS, scatter * 1e9 / READS);
+  TEST_ASSERT_TRUE(true);
+}
+
+int main(int argc, char **argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+
+  RUN_TEST(test_hash_insert_find);
+  RUN_TEST(test_hash_for_each);
+  RUN_TEST(test_hash_overwrite);
+  RUN_TEST(test_hash_clear);
+  RUN_TEST(test_hash_snapshot_restore);
+  RUN_TEST(test_hash_high_load);
+  RUN_TEST(test_hash_auto_grow);
+
+  RUN_TEST(test_queue_push_pop_8);
+  RUN_TEST(test_queue_push_pop_16);
+  RUN_TEST(test_queue_room_and_flush);
+
+  RUN_TEST(test_tcycle_table_equivalence);
+
+  RUN_TEST(test_backend_byte_lanes);
+  RUN_TEST(test_backend_write_bus_bhe);
+  RUN_TEST(test_backend_set_memory_and_strategy);
+  RUN_TEST(test_backend_strategy_regions);
+  RUN_TEST(test_backend_snapshot_restore);
+
+  RUN_TEST(bench_hash_probe_distribution);
+  RUN_TEST(bench_queue_throughput);
+  RUN_TEST(bench_backend_read);
+
+  return UNITY_END();
+}
@@ -54,6 +54,48 @@ size_t PREFETCH_LEN = 4;
 
 // -----------------------End User-provided state -----------------------------
 
+// ------------------------------ Machine mode --------------------------------
+// Batched binary execution for automated screening. If the host sends the
+// two magic bytes within MACHINE_MODE_WAIT_MS of startup, the sketch stops
+// using the compiled-in CODE_SEGMENT and human-readable prints and instead
+// accepts batches of programs over serial, executing them back-to-back and
+// streaming one fixed-layout binary result record per program.
+//
+// Batch wire format (little-endian), after the magic pair 0xB8 0x86:
+//   count: u16
+//   count * {
+//     registers: 28 bytes (same packed struct as LOAD_REGISTERS)
+//     code_len:  u16
+//     code:      code_len bytes
+//   }
+// Result record, streamed after each program completes:
+//   status:    u8 (MACHINE_STATUS_*)
+//   registers: 28 bytes (post-execution state; zeroed on error)
+// Each subsequent batch begins with another magic pair.
+
+#define MACHINE_MODE_MAGIC_0 0xB8
+#define MACHINE_MODE_MAGIC_1 0x86
+#define MACHINE_MODE_WAIT_MS 2000
+
+// Largest per-program code upload accepted in a batch.
+#define MACHINE_CODE_MAX 256
+// Cycle budget per program; a program that hasn't stored results by then
+// (wedged in HLT, runaway jump) is reported as a timeout.
+#define MACHINE_MAX_CYCLES 100000UL
+
+#define MACHINE_STATUS_OK           0x00
+#define MACHINE_STATUS_RESET_FAIL   0x01
+#define MACHINE_STATUS_TIMEOUT      0x02
+#define MACHINE_STATUS_CODE_TOO_BIG 0x03
+
+bool MACHINE_MODE = false;
+static u8 MACHINE_CODE[MACHINE_CODE_MAX];
+
+// Program source for the Execute state: the compiled-in CODE_SEGMENT by
+// default, or the current batch upload in machine mode.
+const u8 *PROGRAM = CODE_SEGMENT;
+size_t PROGRAM_LEN = sizeof CODE_SEGMENT;
+
 static Cpu CPU;
 registers INITIAL_REGISTERS;
 
@@ -499,7 +541,7 @@ void change_state(machine_state new_state) {
 
   #if TRACE_STATE
   // Report time we spent in the previous state.
-  if(CPU.state_begin_time != 0) {
+  if((CPU.state_begin_time != 0) && !MACHINE_MODE) {
     u32 elapsed = state_end_time - CPU.state_begin_time;
     Serial.print("## Changing to state: ");
     Serial.print(MACHINE_STATE_STRINGS[(size_t)new_state]);
@@ -566,7 +608,7 @@ void bus_begin() {
 
   if(CPU.bus_state == CODE && !CPU.fetch_scheduled) {
     // Our prefetch predictor didn't expect a code fetch
-    Serial.println("## Error: Unscheduled prefetch ##");
+    if(!MACHINE_MODE) Serial.println("## Error: Unscheduled prefetch ##");
   }
 
   if(is_bus_busy()) {
@@ -618,7 +660,7 @@ void cycle() {
         if(CPU.mcycle_state == CODE) {
           if(CPU.queue.len < QUEUE_MAX) {
             if(!CPU.fetch_scheduled) {
-              Serial.println("## Error: Unscheduled prefetch ##");
+              if(!MACHINE_MODE) Serial.println("## Error: Unscheduled prefetch ##");
             }
             else {
               u32 pf_completed_id = pop_pf_stack();
@@ -641,7 +683,7 @@ void cycle() {
             push_queue(CPU.data_bus, CPU.data_type);
           }
           else {
-            Serial.println("## Error: Invalid Queue Length++ ##");
+            if(!MACHINE_MODE) Serial.println("## Error: Invalid Queue Length++ ##");
             CPU.v_state = Done;
           }
 
@@ -708,7 +750,7 @@ void cycle() {
       }
     }
     else {
-      Serial.println("## Error: Invalid Queue Length-- ##");
+      if(!MACHINE_MODE) Serial.println("## Error: Invalid Queue Length-- ##");
     }
   }
   else if(q == QUEUE_FLUSHED) {
@@ -865,7 +907,7 @@ void cycle() {
           }
           else {
             // Unexpected read above address 0x00001
-            Serial.println("## INVALID MEM READ DURING LOAD ##");
+            if(!MACHINE_MODE) Serial.println("## INVALID MEM READ DURING LOAD ##");
           }
         }
       } 
@@ -908,7 +950,7 @@ void cycle() {
           else if(CPU.p_pc < PREFETCH_LEN) {
             // We are out of the prefetch program, feed bytes from code segment
 
-            CPU.data_bus = CODE_SEGMENT[CPU.p_pc];
+            CPU.data_bus = PROGRAM[CPU.p_pc];
             CPU.data_type = DATA_PROGRAM;
             CPU.p_pc++;
           }
@@ -962,8 +1004,8 @@ void cycle() {
         if(CPU.bus_state == CODE) {
 
           // Reading code byte
-          if(CPU.v_pc < sizeof CODE_SEGMENT) {
-            CPU.data_bus = CODE_SEGMENT[CPU.v_pc];
+          if(CPU.v_pc < PROGRAM_LEN) {
+            CPU.data_bus = PROGRAM[CPU.v_pc];
             CPU.data_type = DATA_PROGRAM;
             CPU.v_pc++;
           }
@@ -1052,10 +1094,12 @@ void cycle() {
         }
         else {
           // We shouldn't be writing to any other addresses, something wrong happened
-          Serial.print("## INVALID STORE WRITE @");
-          Serial.print(CPU.v_pc, HEX);
-          Serial.println(" ##");
-          //print_cpu_state();
+          if(!MACHINE_MODE) {
+            Serial.print("## INVALID STORE WRITE @");
+            Serial.print(CPU.v_pc, HEX);
+            Serial.println(" ##");
+            //print_cpu_state();
+          }
         }
         #if DEBUG_STORE
           Serial.print("## Store memory write: ");
@@ -1094,6 +1138,7 @@ void cycle() {
   }
 
   // Print instruction state if tracing is enabled
+  if(MACHINE_MODE) return; // Keep the binary result stream clean
   switch(CPU.v_state) {
     case Reset:
       #if TRACE_RESET
@@ -1161,7 +1206,7 @@ void mem_write(u32 address, u8 byte) {
     }
   }
   // Out of RAM!
-  Serial.println("## RAM OVERFLOW ##");
+  if(!MACHINE_MODE) Serial.println("## RAM OVERFLOW ##");
 }
 
 // Resets the CPU by asserting RESET line for at least 4 cycles and waits for ALE signal.
@@ -1228,12 +1273,152 @@ bool cpu_reset() {
   return false;
 }
 
+// --------------------------- Machine mode I/O -------------------------------
+
+// Blocking serial read helpers. Machine mode has no timeouts: the host owns
+// the pacing and the stream is fully framed.
+u8 mm_read_u8() {
+  while(!Serial.available())
+    ;
+  return (u8)Serial.read();
+}
+
+u16 mm_read_u16() {
+  u16 lo = mm_read_u8();
+  u16 hi = mm_read_u8();
+  return lo | (hi << 8);
+}
+
+void mm_read_bytes(u8 *buf, size_t len) {
+  for(size_t i = 0; i < len; i++) {
+    buf[i] = mm_read_u8();
+  }
+}
+
+// Run the currently-loaded program through the full state machine and
+// return a MACHINE_STATUS_* code. Results land in CPU.post_regs.
+u8 mm_run_program() {
+
+  // Fresh virtual RAM per program so one program's stores can't leak into
+  // the next program's reads.
+  memset(RAM_ADDRESSES, 0, sizeof RAM_ADDRESSES);
+  memset(RAM, 0, sizeof RAM);
+
+  if(!cpu_reset()) {
+    return MACHINE_STATUS_RESET_FAIL;
+  }
+
+  #if USE_LOAD_SEG
+    change_state(JumpVector);
+  #else
+    change_state(Load);
+  #endif
+
+  unsigned long cycles = 0;
+  while(CPU.v_state != Done) {
+    cycle();
+    if(++cycles > MACHINE_MAX_CYCLES) {
+      return MACHINE_STATUS_TIMEOUT;
+    }
+  }
+  return MACHINE_STATUS_OK;
+}
+
+// Accept one batch of programs and stream a result record per program.
+void mm_run_batch() {
+
+  u16 count = mm_read_u16();
+
+  for(u16 p = 0; p < count; p++) {
+    mm_read_bytes((u8 *)&LOAD_REGISTERS, sizeof LOAD_REGISTERS);
+    u16 code_len = mm_read_u16();
+
+    u8 status = MACHINE_STATUS_OK;
+    if(code_len > MACHINE_CODE_MAX) {
+      // Drain the oversized program so the stream stays framed.
+      for(u16 i = 0; i < code_len; i++) {
+        (void)mm_read_u8();
+      }
+      status = MACHINE_STATUS_CODE_TOO_BIG;
+    }
+    else {
+      mm_read_bytes(MACHINE_CODE, code_len);
+      PROGRAM = MACHINE_CODE;
+      PROGRAM_LEN = code_len;
+
+      adjust_flags(LOAD_REGISTERS.ax & 0xFF);
+      memcpy(&INITIAL_REGISTERS, &LOAD_REGISTERS, sizeof LOAD_REGISTERS);
+      patch_load(&LOAD_REGISTERS, LOAD_PROGRAM);
+
+      status = mm_run_program();
+    }
+
+    if(status != MACHINE_STATUS_OK) {
+      memset(&CPU.post_regs, 0, sizeof CPU.post_regs);
+    }
+    Serial.write(status);
+    Serial.write((u8 *)&CPU.post_regs, sizeof CPU.post_regs);
+  }
+  Serial.flush();
+}
+
+// Give an automated host a short window after startup to claim the sketch
+// with the magic pair; otherwise fall through to the classic single-program
+// human-readable run.
+bool mm_detect() {
+
+  unsigned long start = millis();
+  while((millis() - start) < MACHINE_MODE_WAIT_MS) {
+    if(!Serial.available()) {
+      continue;
+    }
+    if(mm_read_u8() != MACHINE_MODE_MAGIC_0) {
+      continue;
+    }
+    if(mm_read_u8() == MACHINE_MODE_MAGIC_1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Block until the next batch's magic pair arrives.
+void mm_wait_for_batch() {
+  for(;;) {
+    if(mm_read_u8() != MACHINE_MODE_MAGIC_0) {
+      continue;
+    }
+    if(mm_read_u8() == MACHINE_MODE_MAGIC_1) {
+      return;
+    }
+  }
+}
+
 void loop() {
-  
+
   bool is_reset = false;
   bool tried_reset = false;
 
   static unsigned long cycle_ct = 0;
+  static bool mode_checked = false;
+
+  if(!mode_checked) {
+    mode_checked = true;
+    if(mm_detect()) {
+      // Machine mode suppresses prints and ignores the compiled-in
+      // prefetch request; batch programs start cold-queue.
+      MACHINE_MODE = true;
+      PREFETCH_LEN = 0;
+      PREFETCH_PROGRAM_LEN = 0;
+      PREFETCH_STACK_ADJUST = 0;
+    }
+  }
+
+  if(MACHINE_MODE) {
+    mm_run_batch();
+    mm_wait_for_batch();
+    return;
+  }
 
   while (CPU.v_state != Done) {
    